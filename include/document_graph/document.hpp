@@ -37,17 +37,24 @@ namespace hypha
         Document(eosio::name contract, eosio::name creator, Content content);
         Document(eosio::name contract, eosio::name creator, const std::string &label, const Content::FlexValue &value);
 
-        // this constructor reads the hash from the table and populates the object from storage
+        // this constructor reads the hash from the table and populates the object from storage,
+        // the content is trusted to match the indexed hash and is not hashed again
         Document(eosio::name contract, const eosio::checksum256 &hash);
+
+        // same as above, but re-hashes the content and checks it against the indexed hash
+        Document(eosio::name contract, const eosio::checksum256 &hash, bool verify);
         ~Document();
 
         void emplace();
 
         // returns a document, saves to RAM if it doesn't already exist
-        static Document getOrNew(eosio::name contract, eosio::name creator, ContentGroups contentGroups);
-        static Document getOrNew(eosio::name contract, eosio::name creator, ContentGroup contentGroup);
-        static Document getOrNew(eosio::name contract, eosio::name creator, Content content);
-        static Document getOrNew(eosio::name contract, eosio::name creator, const std::string &label, const Content::FlexValue &value);
+        // matchLegacy also looks up the content under its legacy hash, so documents saved before
+        // binary hashing are found instead of duplicated. It only hashes the content a second
+        // time when the binary hash is not found, keep it on until the stored documents are re-hashed
+        static Document getOrNew(eosio::name contract, eosio::name creator, ContentGroups contentGroups, bool matchLegacy = true);
+        static Document getOrNew(eosio::name contract, eosio::name creator, ContentGroup contentGroup, bool matchLegacy = true);
+        static Document getOrNew(eosio::name contract, eosio::name creator, Content content, bool matchLegacy = true);
+        static Document getOrNew(eosio::name contract, eosio::name creator, const std::string &label, const Content::FlexValue &value, bool matchLegacy = true);
 
         static bool exists(eosio::name contract, const eosio::checksum256 &hash);
 
@@ -57,7 +64,11 @@ namespace hypha
         const void hashContents();
 
         // static helpers
+        // the hash is the sha256 of the packed content groups
         static const eosio::checksum256 hashContents(const ContentGroups &contentGroups);
+
+        // documents created before binary hashing carry the hash of the toString representation
+        static const eosio::checksum256 hashContentsLegacy(const ContentGroups &contentGroups);
         static ContentGroups rollup(ContentGroup contentGroup);
         static ContentGroups rollup(Content content);
         static void insertOrReplace(ContentGroup &contentGroup, Content &newContent);
@@ -90,7 +101,7 @@ namespace hypha
         eosio::name contract;
 
         // toString iterates through all content, all levels, concatenating all values
-        // the resulting string is used for fingerprinting and hashing
+        // the resulting string was used for fingerprinting and hashing, see hashContentsLegacy
         const std::string toString();
         static const std::string toString(const ContentGroups &contentGroups);
         static const std::string toString(const ContentGroup &contentGroup);
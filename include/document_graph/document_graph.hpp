@@ -12,6 +12,7 @@
 #include <document_graph/content.hpp>
 #include <document_graph/document.hpp>
 #include <document_graph/edge.hpp>
+#include <document_graph/util.hpp>
 
 namespace hypha
 {
@@ -32,6 +33,67 @@ namespace hypha
         std::vector<Edge> getEdgesTo(const eosio::checksum256 &toNode, const eosio::name &edgeName);
         std::vector<Edge> getEdgesToOrFail(const eosio::checksum256 &toNode, const eosio::name &edgeName);
 
+        // visitors call visit(const Edge &) on each matching edge straight from the table,
+        // without copying the rows, and stop as soon as visit returns false.
+        // Until reindexEdges has finished the 64 bit indexes are walked instead of the 128 bit ones
+        template <typename F>
+        void forEachEdge(const eosio::checksum256 &fromNode, const eosio::checksum256 &toNode, F &&visit)
+        {
+            auto matching = [&](const Edge &edge) {
+                return edge.from_node != fromNode || edge.to_node != toNode || visit(edge);
+            };
+
+            if (keysReady())
+            {
+                forEachEdgeByKey<eosio::name("fromtokey")>(Edge::nodeKey(fromNode, Edge::nodePrefix(toNode)), &Edge::by_from_to_key, matching);
+            }
+            else
+            {
+                forEachEdgeByKey<eosio::name("byfromto")>(concatHash(fromNode, toNode), &Edge::by_from_node_to_node_index, matching);
+            }
+        }
+
+        template <typename F>
+        void forEachEdgeFrom(const eosio::checksum256 &fromNode, const eosio::name &edgeName, F &&visit)
+        {
+            auto matching = [&](const Edge &edge) {
+                return edge.from_node != fromNode || edge.edge_name != edgeName || visit(edge);
+            };
+
+            if (keysReady())
+            {
+                forEachEdgeByKey<eosio::name("fromnamekey")>(Edge::nodeKey(fromNode, edgeName.value), &Edge::by_from_name_key, matching);
+            }
+            else
+            {
+                forEachEdgeByKey<eosio::name("byfromname")>(concatHash(fromNode, edgeName), &Edge::by_from_node_edge_name_index, matching);
+            }
+        }
+
+        template <typename F>
+        void forEachEdgeTo(const eosio::checksum256 &toNode, const eosio::name &edgeName, F &&visit)
+        {
+            auto matching = [&](const Edge &edge) {
+                return edge.to_node != toNode || edge.edge_name != edgeName || visit(edge);
+            };
+
+            if (keysReady())
+            {
+                forEachEdgeByKey<eosio::name("tonamekey")>(Edge::nodeKey(toNode, edgeName.value), &Edge::by_to_name_key, matching);
+            }
+            else
+            {
+                forEachEdgeByKey<eosio::name("bytoname")>(concatHash(toNode, edgeName), &Edge::by_to_node_edge_name_index, matching);
+            }
+        }
+
+        bool hasEdgeFrom(const eosio::checksum256 &fromNode, const eosio::name &edgeName);
+
+        // rewrites a chunk of edges so rows saved before the 128 bit indexes existed get entries in them,
+        // returns the primary key to continue from, or 0 when all edges have been rewritten and
+        // queries switch over to the 128 bit indexes
+        uint64_t reindexEdges(uint64_t start, uint64_t chunksize);
+
         Edge createEdge(eosio::name &creator, const eosio::checksum256 &fromNode, const eosio::checksum256 &toNode, const eosio::name &edgeName);
 
         Document updateDocument(const eosio::name &updater,
@@ -44,6 +106,33 @@ namespace hypha
 
     private:
         eosio::name m_contract;
+
+        // the edgekeys flag is read once per DocumentGraph
+        int8_t m_keysReady = -1;
+
+        bool keysReady()
+        {
+            if (m_keysReady < 0)
+            {
+                m_keysReady = Edge::keysReady(m_contract) ? 1 : 0;
+            }
+            return m_keysReady == 1;
+        }
+
+        template <eosio::name::raw IndexName, typename K, typename F>
+        void forEachEdgeByKey(K key, K (Edge::*keyOf)() const, F &&visit)
+        {
+            Edge::edge_table e_t(m_contract, m_contract.value);
+            auto index = e_t.get_index<IndexName>();
+
+            for (auto itr = index.lower_bound(key); itr != index.end() && ((*itr).*keyOf)() == key; ++itr)
+            {
+                if (!visit(*itr))
+                {
+                    return;
+                }
+            }
+        }
     };
 }; // namespace hypha
 
@@ -67,4 +156,9 @@ using edge_table = eosio::multi_index<eosio::name("edges"), contract_edge,\
             eosio::indexed_by<eosio::name("byfromto"), eosio::const_mem_fun<root_edge, uint64_t, &root_edge::by_from_node_to_node_index>>,\
             eosio::indexed_by<eosio::name("bytoname"), eosio::const_mem_fun<root_edge, uint64_t, &root_edge::by_to_node_edge_name_index>>,\
             eosio::indexed_by<eosio::name("bycreated"), eosio::const_mem_fun<root_edge, uint64_t, &root_edge::by_created>>,\
-            eosio::indexed_by<eosio::name("bycreator"), eosio::const_mem_fun<root_edge, uint64_t, &root_edge::by_creator>>>;
\ No newline at end of file
+            eosio::indexed_by<eosio::name("bycreator"), eosio::const_mem_fun<root_edge, uint64_t, &root_edge::by_creator>>,\
+            eosio::indexed_by<eosio::name("fromnamekey"), eosio::const_mem_fun<root_edge, uint128_t, &root_edge::by_from_name_key>>,\
+            eosio::indexed_by<eosio::name("fromtokey"), eosio::const_mem_fun<root_edge, uint128_t, &root_edge::by_from_to_key>>,\
+            eosio::indexed_by<eosio::name("tonamekey"), eosio::const_mem_fun<root_edge, uint128_t, &root_edge::by_to_name_key>>>;\
+TABLE contract##_edge_keys : public hypha::EdgeKeys {};\
+using edge_keys_table = eosio::singleton<eosio::name("edgekeys"), contract##_edge_keys>;
\ No newline at end of file
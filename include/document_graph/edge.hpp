@@ -3,6 +3,7 @@
 #include <eosio/name.hpp>
 #include <eosio/time.hpp>
 #include <eosio/multi_index.hpp>
+#include <eosio/singleton.hpp>
 #include <eosio/crypto.hpp>
 
 namespace hypha
@@ -58,9 +59,20 @@ namespace hypha
                            const eosio::checksum256 &_to_node,
                            const eosio::name &_edge_name);
 
+        // edge rows saved before the 128 bit indexes existed have no entries in them, queries use
+        // the 64 bit indexes until DocumentGraph::reindexEdges has rewritten every edge
+        static bool keysReady(const eosio::name &contract);
+        static void setKeysReady(const eosio::name &contract, bool ready);
+
+        // 128 bit index keys, the high half is the first 8 bytes of the node hash so lookups
+        // land next to the matching edges and only need to compare the full hashes to rule out collisions
+        static uint64_t nodePrefix(const eosio::checksum256 &node);
+        static uint128_t nodeKey(const eosio::checksum256 &node, uint64_t low);
+
         uint64_t id; // hash of from_node, to_node, and edge_name
 
         // these three additional indexes allow isolating/querying edges more precisely (less iteration)
+        // they are 32 bit hashes and can collide, queries use the 128 bit keys below
         uint64_t from_node_edge_name_index;
         uint64_t from_node_to_node_index;
         uint64_t to_node_edge_name_index;
@@ -82,6 +94,9 @@ namespace hypha
         uint64_t by_creator() const;
         eosio::checksum256 by_from() const;
         eosio::checksum256 by_to() const;
+        uint128_t by_from_name_key() const;
+        uint128_t by_from_to_key() const;
+        uint128_t by_to_name_key() const;
 
         EOSLIB_SERIALIZE(Edge, (id)(from_node_edge_name_index)(from_node_to_node_index)(to_node_edge_name_index)(from_node)(to_node)(edge_name)(created_date)(creator)(contract))
 
@@ -93,8 +108,21 @@ namespace hypha
                                    eosio::indexed_by<eosio::name("byfromto"), eosio::const_mem_fun<Edge, uint64_t, &Edge::by_from_node_to_node_index>>,
                                    eosio::indexed_by<eosio::name("bytoname"), eosio::const_mem_fun<Edge, uint64_t, &Edge::by_to_node_edge_name_index>>,
                                    eosio::indexed_by<eosio::name("bycreated"), eosio::const_mem_fun<Edge, uint64_t, &Edge::by_created>>,
-                                   eosio::indexed_by<eosio::name("bycreator"), eosio::const_mem_fun<Edge, uint64_t, &Edge::by_creator>>>
+                                   eosio::indexed_by<eosio::name("bycreator"), eosio::const_mem_fun<Edge, uint64_t, &Edge::by_creator>>,
+                                   eosio::indexed_by<eosio::name("fromnamekey"), eosio::const_mem_fun<Edge, uint128_t, &Edge::by_from_name_key>>,
+                                   eosio::indexed_by<eosio::name("fromtokey"), eosio::const_mem_fun<Edge, uint128_t, &Edge::by_from_to_key>>,
+                                   eosio::indexed_by<eosio::name("tonamekey"), eosio::const_mem_fun<Edge, uint128_t, &Edge::by_to_name_key>>>
             edge_table;
     };
 
+    // whether all edges of the contract have entries in the 128 bit indexes
+    struct EdgeKeys
+    {
+        bool ready = false;
+
+        EOSLIB_SERIALIZE(EdgeKeys, (ready))
+
+        typedef eosio::singleton<eosio::name("edgekeys"), EdgeKeys> edge_keys_table;
+    };
+
 } // namespace hypha
\ No newline at end of file
@@ -3,23 +3,23 @@
 #include "proposals_base.hpp"
 
 
-class ProposalAlliance : public Proposal {
+class ProposalAlliance final : public Proposal {
 
   public:
 
     using Proposal::Proposal;
 
-    void callback(std::map<std::string, VariantValue> & args) override;
+    void callback(ProposalArgs & args) override;
 
 
     name get_scope() override;
     name get_fund_type() override;
 
 
-    void create_impl(std::map<std::string, VariantValue> & args) override;
-    void status_open_impl(std::map<std::string, VariantValue> & args) override;
-    void status_eval_impl(std::map<std::string, VariantValue> & args) override;
-    void status_rejected_impl(std::map<std::string, VariantValue> & args) override;
+    void create_impl(ProposalArgs & args) override;
+    void status_open_impl(ProposalArgs & args) override;
+    void status_eval_impl(ProposalArgs & args) override;
+    void status_rejected_impl(ProposalArgs & args) override;
 
 };
 
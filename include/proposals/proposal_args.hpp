@@ -0,0 +1,128 @@
+#pragma once
+
+#include <eosio/eosio.hpp>
+#include <eosio/asset.hpp>
+#include <tables/proposals_table.hpp>
+#include <optional>
+#include <string_view>
+
+using eosio::name;
+using eosio::asset;
+using std::string;
+
+
+// Typed arguments of the proposal lifecycle. The createprop, updateprop,
+// cancelprop and callbackprop actions take this struct packed; create, update,
+// cancel and callback keep taking the string keyed map for ABI compatibility
+// and read it into this struct before calling them. Packed callers set a bit
+// in present for every field they fill, as from_map does for the keys it reads.
+struct ProposalArgs {
+
+  enum field : uint8_t {
+    f_proposal_id,
+    f_propcycle,
+    f_creator,
+    f_type,
+    f_fund,
+    f_recipient,
+    f_setting_name,
+    f_reward_owner,
+    f_action,
+    f_title,
+    f_summary,
+    f_description,
+    f_image,
+    f_url,
+    f_pay_percentages,
+    f_quantity,
+    f_planted,
+    f_reward,
+    f_max_amount_per_invite,
+    f_test_cycles,
+    f_eval_cycles,
+    f_campaign_id,
+    f_lock_id,
+    f_new_value
+  };
+
+  uint64_t proposal_id = 0;
+  uint64_t propcycle = 0;
+
+  name creator;
+  name type;
+  name fund;
+  name recipient;
+  name setting_name;
+  name reward_owner;
+  name action;
+
+  string title;
+  string summary;
+  string description;
+  string image;
+  string url;
+  std::optional<string> pay_percentages;
+
+  asset quantity;
+  asset planted;
+  asset reward;
+  asset max_amount_per_invite;
+
+  uint64_t test_cycles = 0;
+  uint64_t eval_cycles = 0;
+  uint64_t campaign_id = 0;
+  uint64_t lock_id = 0;
+
+  VariantValue new_value; // uint64_t or double, depending on the setting
+
+  uint32_t present = 0; // one bit per field read from the map
+
+  bool has (field f) const { return present & (uint32_t(1) << f); }
+
+  void require (field f, const string & key) const {
+    eosio::check(has(f), "missing proposal argument: " + key);
+  }
+
+  static ProposalArgs from_map (const std::map<std::string, VariantValue> & args);
+
+  EOSLIB_SERIALIZE(ProposalArgs, (proposal_id)(propcycle)(creator)(type)(fund)(recipient)(setting_name)(reward_owner)(action)
+    (title)(summary)(description)(image)(url)(pay_percentages)(quantity)(planted)(reward)(max_amount_per_invite)
+    (test_cycles)(eval_cycles)(campaign_id)(lock_id)(new_value)(present))
+
+  private:
+
+    void set (field f, const string & key, const VariantValue & value);
+
+};
+
+struct ProposalArgDescriptor {
+  std::string_view key;
+  ProposalArgs::field id;
+};
+
+constexpr ProposalArgDescriptor proposal_arg_descriptors[] = {
+  { "proposal_id", ProposalArgs::f_proposal_id },
+  { "propcycle", ProposalArgs::f_propcycle },
+  { "creator", ProposalArgs::f_creator },
+  { "type", ProposalArgs::f_type },
+  { "fund", ProposalArgs::f_fund },
+  { "recipient", ProposalArgs::f_recipient },
+  { "setting_name", ProposalArgs::f_setting_name },
+  { "reward_owner", ProposalArgs::f_reward_owner },
+  { "action", ProposalArgs::f_action },
+  { "title", ProposalArgs::f_title },
+  { "summary", ProposalArgs::f_summary },
+  { "description", ProposalArgs::f_description },
+  { "image", ProposalArgs::f_image },
+  { "url", ProposalArgs::f_url },
+  { "pay_percentages", ProposalArgs::f_pay_percentages },
+  { "quantity", ProposalArgs::f_quantity },
+  { "planted", ProposalArgs::f_planted },
+  { "reward", ProposalArgs::f_reward },
+  { "max_amount_per_invite", ProposalArgs::f_max_amount_per_invite },
+  { "test_cycles", ProposalArgs::f_test_cycles },
+  { "eval_cycles", ProposalArgs::f_eval_cycles },
+  { "campaign_id", ProposalArgs::f_campaign_id },
+  { "lock_id", ProposalArgs::f_lock_id },
+  { "new_value", ProposalArgs::f_new_value }
+};
@@ -3,16 +3,16 @@
 #include "proposals_base.hpp"
 
 
-class ProposalCampaignFunding : public Proposal {
+class ProposalCampaignFunding final : public Proposal {
 
   public:
 
     using Proposal::Proposal;
 
-    void create_impl(std::map<std::string, VariantValue> & args) override;
-    void update_impl(std::map<std::string, VariantValue> & args) override;
-    void status_open_impl (std::map<std::string, VariantValue> & args) override;
-    void status_eval_impl(std::map<std::string, VariantValue> & args) override;
+    void create_impl(ProposalArgs & args) override;
+    void update_impl(ProposalArgs & args) override;
+    void status_open_impl (ProposalArgs & args) override;
+    void status_eval_impl(ProposalArgs & args) override;
 
     name get_scope() override;
     name get_fund_type() override;
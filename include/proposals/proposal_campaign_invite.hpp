@@ -3,7 +3,7 @@
 #include "proposals_base.hpp"
 
 
-class ProposalCampaignInvite : public Proposal {
+class ProposalCampaignInvite final : public Proposal {
 
   public:
   
@@ -12,12 +12,12 @@ class ProposalCampaignInvite : public Proposal {
     name get_scope() override;
     name get_fund_type() override;
 
-    void callback(std::map<std::string, VariantValue> & args) override;
+    void callback(ProposalArgs & args) override;
 
-    void create_impl(std::map<std::string, VariantValue> & args) override;
+    void create_impl(ProposalArgs & args) override;
 
-    void status_open_impl(std::map<std::string, VariantValue> & args) override;
-    void status_eval_impl(std::map<std::string, VariantValue> & args) override;
-    void status_rejected_impl(std::map<std::string, VariantValue> & args) override;
+    void status_open_impl(ProposalArgs & args) override;
+    void status_eval_impl(ProposalArgs & args) override;
+    void status_rejected_impl(ProposalArgs & args) override;
 
 };
\ No newline at end of file
@@ -3,7 +3,7 @@
 #include "proposals_base.hpp"
 
 
-class ProposalMilestone: public Proposal {
+class ProposalMilestone final : public Proposal {
 
   public:
 
@@ -12,7 +12,7 @@ class ProposalMilestone: public Proposal {
     name get_scope() override;
     name get_fund_type() override;
 
-    void create_impl(std::map<std::string, VariantValue> & args) override;
-    void status_open_impl(std::map<std::string, VariantValue> & args) override;
+    void create_impl(ProposalArgs & args) override;
+    void status_open_impl(ProposalArgs & args) override;
 
 };
\ No newline at end of file
@@ -37,12 +37,12 @@ class Proposal {
     Proposal(dao & _contract) : m_contract(_contract), contract_name(_contract.get_self()) {};
     virtual ~Proposal(){};
 
-    virtual void create(std::map<std::string, VariantValue> & args);
-    virtual void update(std::map<std::string, VariantValue> & args);
-    virtual void cancel(std::map<std::string, VariantValue> & args);
-    virtual void evaluate(std::map<std::string, VariantValue> & args);
-    virtual void callback(std::map<std::string, VariantValue> & args);
-    virtual void stake(std::map<std::string, VariantValue> & args);
+    virtual void create(ProposalArgs & args);
+    virtual void update(ProposalArgs & args);
+    virtual void cancel(ProposalArgs & args);
+    virtual void evaluate(ProposalArgs & args);
+    virtual void callback(ProposalArgs & args);
+    virtual void stake(ProposalArgs & args);
 
 
     virtual name get_scope() = 0;
@@ -50,20 +50,23 @@ class Proposal {
 
 
     virtual void check_can_vote(const name & status, const name & stage);
-    virtual bool check_prop_majority(std::map<std::string, VariantValue> & args);
+    virtual bool check_prop_majority(const uint64_t & favour, const uint64_t & against);
     virtual uint64_t min_stake(const asset & quantity, const name & fund);
 
 
-    virtual void create_impl(std::map<std::string, VariantValue> & args);
-    virtual void update_impl(std::map<std::string, VariantValue> & args);
-    virtual void cancel_impl(std::map<std::string, VariantValue> & args);
-    virtual void status_open_impl(std::map<std::string, VariantValue> & args);
-    virtual void status_eval_impl(std::map<std::string, VariantValue> & args);
-    virtual void status_rejected_impl(std::map<std::string, VariantValue> & args);
+    virtual void create_impl(ProposalArgs & args);
+    virtual void update_impl(ProposalArgs & args);
+    virtual void cancel_impl(ProposalArgs & args);
+    virtual void status_open_impl(ProposalArgs & args);
+    virtual void status_eval_impl(ProposalArgs & args);
+    virtual void status_rejected_impl(ProposalArgs & args);
 
 
     uint64_t cap_stake(const name & fund);
 
+    template <typename Derived>
+    void evaluate_as(Derived & self, ProposalArgs & args);
+
 
     dao & m_contract;
     name contract_name;
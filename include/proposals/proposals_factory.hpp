@@ -5,37 +5,83 @@
 #include "proposal_campaign_invite.hpp"
 #include "proposal_milestone.hpp"
 #include "proposal_campaign_funding.hpp"
+#include <type_traits>
+#include <variant>
 
 
+// Holds the strategy for a proposal type in place (no heap allocation).
+// operator-> gives the Proposal interface; visit() hands the concrete,
+// final type to the callback. evaluate() also runs the base evaluation
+// on that type, so its status hooks are not called through the vtable.
 class ProposalsFactory {
 
   public:
 
-    static Proposal * Factory(dao & _contract, const name & type) {
+    ProposalsFactory(dao & _contract, const name & type) {
       switch (type.value)
       {
       case ProposalsCommon::type_ref_setting.value:
-        return new ReferendumSettings(_contract);
+        m_proposal = &m_strategy.emplace<ReferendumSettings>(_contract);
+        break;
 
       case ProposalsCommon::type_prop_alliance.value:
-        return new ProposalAlliance(_contract);
+        m_proposal = &m_strategy.emplace<ProposalAlliance>(_contract);
+        break;
 
       case ProposalsCommon::type_prop_campaign_invite.value:
-        return new ProposalCampaignInvite(_contract);
+        m_proposal = &m_strategy.emplace<ProposalCampaignInvite>(_contract);
+        break;
 
       case ProposalsCommon::type_prop_milestone.value:
-        return new ProposalMilestone(_contract);
+        m_proposal = &m_strategy.emplace<ProposalMilestone>(_contract);
+        break;
 
       case ProposalsCommon::type_prop_campaign_funding.value:
-        return new ProposalCampaignFunding(_contract);
+        m_proposal = &m_strategy.emplace<ProposalCampaignFunding>(_contract);
+        break;
       
       default:
+        check(false, "Unknown proposal type " + type.to_string());
         break;
       }
+    }
+
+    ProposalsFactory(const ProposalsFactory &) = delete;
+    ProposalsFactory & operator=(const ProposalsFactory &) = delete;
 
-      check(false, "Unknown proposal type " + type.to_string());
-      return nullptr;
+    Proposal * operator->() { return m_proposal; }
+
+    template <typename F>
+    void visit(F && f) {
+      std::visit([&](auto & prop) {
+        if constexpr (!std::is_same_v<std::decay_t<decltype(prop)>, std::monostate>) {
+          f(prop);
+        }
+      }, m_strategy);
     }
 
-};
+    void evaluate(ProposalArgs & args) {
+      visit([&](auto & prop) {
+        using T = std::decay_t<decltype(prop)>;
+        if constexpr (std::is_same_v<decltype(&T::evaluate), void (Proposal::*)(ProposalArgs &)>) {
+          prop.evaluate_as(prop, args);
+        } else {
+          prop.evaluate(args);
+        }
+      });
+    }
+
+  private:
 
+    std::variant<
+      std::monostate,
+      ReferendumSettings,
+      ProposalAlliance,
+      ProposalCampaignInvite,
+      ProposalMilestone,
+      ProposalCampaignFunding
+    > m_strategy;
+
+    Proposal * m_proposal = nullptr;
+
+};
@@ -4,8 +4,12 @@
 #include <tables.hpp>
 #include <tables/rep_table.hpp>
 #include <tables/size_table.hpp>
+#include <tables/score_bucket_table.hpp>
+#include <tables/rank_change_table.hpp>
+#include <tables/change_cursor_table.hpp>
 #include <tables/cbs_table.hpp>
 #include <tables/user_table.hpp>
+#include <tables/user_core_table.hpp>
 #include <tables/config_table.hpp>
 #include <tables/ban_table.hpp>
 #include <tables/config_float_table.hpp>
@@ -21,6 +25,7 @@ CONTRACT accounts : public contract {
       accounts(name receiver, name code, datastream<const char*> ds)
         : contract(receiver, code, ds),
           users(receiver, receiver.value),
+          usercore(receiver, receiver.value),
           refs(receiver, receiver.value),
           cbs(receiver, receiver.value),
           vouches(receiver, receiver.value),
@@ -67,13 +72,13 @@ CONTRACT accounts : public contract {
       ACTION vouch(name sponsor, name account);
       ACTION pnishvouched(name sponsor, uint64_t start_account);
 
-      ACTION rankreps();
-      ACTION rankorgreps();
-      ACTION rankrep(uint64_t start_val, uint64_t chunk, uint64_t chunksize, name scope);
+      ACTION rankreps(eosio::binary_extension<name> op_id);
+      ACTION rankorgreps(eosio::binary_extension<name> op_id);
+      ACTION rankrep(uint64_t start_val, uint64_t chunk, uint64_t chunksize, name scope, eosio::binary_extension<name> op_id);
 
-      ACTION rankcbss();
-      ACTION rankorgcbss();
-      ACTION rankcbs(uint64_t start_val, uint64_t chunk, uint64_t chunksize, name scope);
+      ACTION rankcbss(eosio::binary_extension<name> op_id);
+      ACTION rankorgcbss(eosio::binary_extension<name> op_id);
+      ACTION rankcbs(uint64_t start_val, uint64_t chunk, uint64_t chunksize, name scope, eosio::binary_extension<name> op_id);
 
       ACTION changesize(name id, int64_t delta);
 
@@ -102,6 +107,9 @@ CONTRACT accounts : public contract {
       ACTION migflags(name to);
       ACTION migflags1();
 
+      ACTION migbuckets(name scope, name index, uint64_t start, uint64_t chunksize);
+      ACTION migusercore(uint64_t start, uint64_t chunksize);
+
   private:
       symbol seeds_symbol = symbol("SEEDS", 4);
       symbol network_symbol = symbol("TLOS", 4);
@@ -149,6 +157,12 @@ CONTRACT accounts : public contract {
       const name flag_total_scope = "flag.total"_n;
       const name flag_remove_scope = "flag.remove"_n;
 
+      // score histogram scopes, see tables/score_bucket_table.hpp
+      const name rep_buckets = "rep"_n;
+      const name rep_org_buckets = "rep.org"_n;
+      const name cbs_buckets = "cbs"_n;
+      const name cbs_org_buckets = "cbs.org"_n;
+
       void buyaccount(name account, string owner_key, string active_key);
       void check_user(name account);
       void rewards(name account, name new_status);
@@ -185,11 +199,20 @@ CONTRACT accounts : public contract {
       void check_is_banned(name account);
       uint64_t number_of_citizens_vouched(name account, uint64_t maxsearch);
       bool is_citizen(name account);
+      name rep_buckets_for(name scope);
+      name cbs_buckets_for(name scope);
+      void mark_rank_changed(name account);
+      void remove_rank_rows(name user, name scope);
+      void set_user_core(name account, name status, name type, uint64_t timestamp);
       
       DEFINE_USER_TABLE
 
       DEFINE_USER_TABLE_MULTI_INDEX
 
+      DEFINE_USER_CORE_TABLE
+
+      DEFINE_USER_CORE_TABLE_MULTI_INDEX
+
       DEFINE_REP_TABLE
 
       DEFINE_REP_TABLE_MULTI_INDEX
@@ -205,6 +228,20 @@ CONTRACT accounts : public contract {
       DEFINE_BAN_TABLE
       DEFINE_BAN_TABLE_MULTI_INDEX
 
+      DEFINE_SCORE_BUCKET_TABLE
+      DEFINE_SCORE_BUCKET_TABLE_MULTI_INDEX
+
+      DEFINE_SCORE_COUNT_TABLE
+      DEFINE_SCORE_COUNT_TABLE_MULTI_INDEX
+
+      DEFINE_RANK_CHANGE_TABLE
+      DEFINE_RANK_CHANGE_TABLE_MULTI_INDEX
+
+      // From harvest contract
+      DEFINE_CHANGE_CURSOR_TABLE
+
+      DEFINE_RANK_CURSOR_SINGLETON
+
       TABLE ref_table {
         name referrer;
         name invited;
@@ -373,6 +410,7 @@ CONTRACT accounts : public contract {
     vouches_totals_tables vouchtotals;
     req_vouch_tables reqvouch;
     user_tables users;
+    user_core_tables usercore;
     rep_tables rep;
     size_tables sizes;
 
@@ -382,6 +420,8 @@ CONTRACT accounts : public contract {
 
     config_tables config;
     config_float_tables configfloat;
+    config_snapshot<uint64_t> config_cache;
+    config_snapshot<double> config_float_cache;
 
     // From history contract
     TABLE totals_table {
@@ -431,6 +471,6 @@ EOSIO_DISPATCH(accounts, (reset)(adduser)(canresident)(makeresident)(cancitizen)
 (flag)(removeflag)(punish)(pnshvouchers)(evaldemote)(bantree)(delegateflag)(undlgateflag)(mimicflag)
 (refinfo)(unban)
 (testmvouch)
-(migflags)(migflags1)
+(migflags)(migflags1)(migbuckets)(migusercore)
 (addcbs)
 );
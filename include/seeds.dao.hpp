@@ -6,6 +6,7 @@
 #include <eosio/time.hpp>
 #include <eosio/transaction.hpp>
 #include <eosio/singleton.hpp>
+#include <eosio/binary_extension.hpp>
 #include <contracts.hpp>
 #include <utils.hpp>
 #include <tables/config_table.hpp>
@@ -16,7 +17,10 @@
 #include <tables/organization_table.hpp>
 #include <tables/dho_share_table.hpp>
 #include <tables/moon_phases_table.hpp>
+#include <tables/decay_rate_table.hpp>
+#include <proposals/proposal_args.hpp>
 #include <cmath>
+#include <set>
 
 using namespace eosio;
 using std::string;
@@ -85,10 +89,22 @@ CONTRACT dao : public contract {
 
       ACTION callback(std::map<std::string, VariantValue> & args);
 
+      ACTION createprop(ProposalArgs & args);
+
+      ACTION updateprop(ProposalArgs & args);
+
+      ACTION cancelprop(ProposalArgs & args);
+
+      ACTION callbackprop(ProposalArgs & args);
+
       ACTION onperiod();
 
       ACTION evaluate(const uint64_t & proposal_id, const uint64_t & propcycle);
 
+      ACTION evalprops();
+
+      ACTION skipeval(const uint64_t & proposal_id);
+
       ACTION favour(const name & voter, const uint64_t & proposal_id, const uint64_t & amount);
 
       ACTION against(const name & voter, const uint64_t & proposal_id, const uint64_t & amount);
@@ -115,6 +131,10 @@ CONTRACT dao : public contract {
 
       ACTION mimicrevert(const name & delegatee, const uint64_t & delegator, const name & scope, const uint64_t & proposal_id, const uint64_t & chunksize);
 
+      ACTION settlevoice(const name & account, const name & scope);
+
+      ACTION migdelegs(const name & scope, const uint64_t & start, const uint64_t & chunksize);
+
       ACTION updatevoices();
 
       ACTION updatevoice(const uint64_t & start, const name & scope);
@@ -200,15 +220,40 @@ CONTRACT dao : public contract {
         uint64_t propcycle; 
         uint64_t t_onperiod; // last time onperiod ran
         uint64_t t_voicedecay; // last time voice was decayed
+        eosio::binary_extension<uint64_t> decay_epoch; // number of voice decays so far, applied lazily to voice rows
       };
       typedef singleton<"cycle"_n, cycle_table> cycle_tables;
       typedef eosio::multi_index<"cycle"_n, cycle_table> dump_for_cycle;
 
+      TABLE eval_cursor_table {
+        uint64_t propcycle; // cycle whose proposals are being evaluated
+        name stage; // stage being walked, active first then staged, empty when done
+        uint64_t next_id;
+        uint64_t max_id; // proposals created after onperiod wait for the next cycle
+      };
+      typedef singleton<"evalcursor"_n, eval_cursor_table> eval_cursor_tables;
+      typedef eosio::multi_index<"evalcursor"_n, eval_cursor_table> dump_for_eval_cursor;
+
+      // evaluations onperiod abandoned, the proposals from next_id on in stage (and the
+      // staged ones when stage is active) below max_id were left for the following cycle
+      TABLE eval_skip_table {
+        uint64_t propcycle;
+        name stage;
+        uint64_t next_id;
+        uint64_t max_id;
+        uint64_t skipped_at;
+
+        uint64_t primary_key() const { return propcycle; }
+      };
+      typedef eosio::multi_index<"evalskips"_n, eval_skip_table> eval_skip_tables;
+
       TABLE vote_table {
         uint64_t proposal_id;
         name account;
         uint64_t amount;
         bool favour;
+        eosio::binary_extension<uint64_t> delegated; // voice of the voter's delegators cast with this vote, see delegvoice
+        eosio::binary_extension<double> delegated_shares; // delegvoice shares when the vote was cast, to attribute it per delegator
 
         uint64_t primary_key()const { return account.value; }
       };
@@ -217,6 +262,7 @@ CONTRACT dao : public contract {
       TABLE voice_table {
         name account;
         uint64_t balance;
+        eosio::binary_extension<uint64_t> decay_epoch; // cycle decay_epoch the balance was last materialized at
 
         uint64_t primary_key()const { return account.value; }
       };
@@ -244,6 +290,9 @@ CONTRACT dao : public contract {
         name delegatee;
         double weight;
         uint64_t timestamp;
+        eosio::binary_extension<double> shares; // share of the delegatee's delegvoice balance, unset until joined
+        eosio::binary_extension<uint64_t> share_epoch; // delegvoice share_epoch the shares belong to
+        eosio::binary_extension<uint64_t> votes; // delegvoice votes already applied to the delegator's voice
 
         uint64_t primary_key()const { return delegator.value; }
         uint64_t by_delegatee()const { return delegatee.value; }
@@ -256,6 +305,36 @@ CONTRACT dao : public contract {
         const_mem_fun<delegate_trust_table, uint128_t, &delegate_trust_table::by_delegatee_delegator>>
       > delegate_trust_tables;
 
+      // Voice delegated to an account, directly or through other delegators, kept as one
+      // balance so a delegatee's vote uses it in a single write. Each delegator owns
+      // shares of it; a vote multiplies the balance, and so the value of every share,
+      // by the part left. Delegators' voice rows catch up lazily, see settle_delegation.
+      TABLE delegated_voice_table { // scoped by proposal's scope (alliance, campaign, etc)
+        name delegatee;
+        uint64_t balance;
+        uint64_t decay_epoch; // cycle decay_epoch the balance was last materialized at
+        double shares;
+        uint64_t share_epoch; // moves on when a used up balance is joined again, older shares are worth nothing
+        uint64_t votes; // votes cast with the balance
+        uint64_t delegators; // accounts whose voice is in the balance, directly or through their own delegators
+
+        uint64_t primary_key()const { return delegatee.value; }
+      };
+      typedef eosio::multi_index<"delegvoice"_n, delegated_voice_table> delegated_voice_tables;
+
+      TABLE delegation_exclusion_table { // scoped by proposal_id
+        name account; // delegated after voting on the proposal, its voice is kept out of its delegatees' votes on it
+
+        uint64_t primary_key()const { return account.value; }
+      };
+      typedef eosio::multi_index<"delegexcls"_n, delegation_exclusion_table> delegation_exclusion_tables;
+
+      TABLE delegation_state_table {
+        bool ready = false; // every delegation has joined delegvoice, see migdelegs
+      };
+      typedef singleton<"delegstate"_n, delegation_state_table> delegation_state_tables;
+      typedef eosio::multi_index<"delegstate"_n, delegation_state_table> dump_for_delegation_state;
+
       TABLE voted_proposals_table { // scoped by cycle
         uint64_t proposal_id;
 
@@ -349,13 +428,23 @@ CONTRACT dao : public contract {
 
       DEFINE_DHO_SHARE_TABLE
       DEFINE_DHO_SHARE_TABLE_MULTI_INDEX
+
+      DEFINE_DECAY_RATE_TABLE
+      DEFINE_DECAY_RATE_TABLE_MULTI_INDEX
       
 
       config_tables config;
       size_tables sizes;
+
+      // support rows of the cycle being evaluated, keyed by fund type, read once per action
+      std::map<uint64_t, support_level_table> support_cache;
+      bool get_support_level(const name & type, const uint64_t & propcycle, support_level_table & support);
+
+      bool next_eval_proposal(eval_cursor_table & ec, uint64_t & proposal_id, name & type);
+      void record_eval_skip(const eval_cursor_table & ec);
     
     void check_citizen(const name & account);
-    void check_attributes(const std::map<std::string, VariantValue> & args);
+    void check_attributes(const ProposalArgs & args);
 
   private:
 
@@ -364,6 +453,8 @@ CONTRACT dao : public contract {
     void erase_voice(const name & user);
     void recover_voice(const name & account);
     uint64_t calculate_decay(const uint64_t & voice_amount);
+    uint64_t get_decay_epoch();
+    uint64_t get_voice_balance(const voice_table & voice, const uint64_t & epoch);
     bool is_trust_delegated(const name & account, const name & scope);
     void send_mimic_delegatee_vote(const name & delegatee, const name & scope, const uint64_t & proposal_id, const double & percentage_used, const name & option);
     void add_voted_proposal(const uint64_t & proposal_id);
@@ -373,9 +464,27 @@ CONTRACT dao : public contract {
     // void check_citizen(const name & account);
     void vote_aux(const name & voter, const uint64_t & referendum_id, const uint64_t & amount, const name & option, const bool & is_delegated);
     bool revert_vote(const name & voter, const uint64_t & referendum_id);
+    void revert_trust_vote(const name & voter, const uint64_t & proposal_id, const name & scope);
+    void change_dho_points(dho_tables & dho_t, const name & dho, const int64_t & delta);
     // void check_attributes(const std::map<std::string, VariantValue> & args);
     uint64_t active_cutoff_date();
     bool has_delegates(const name & voter, const name & scope);
+
+    bool delegated_voice_ready();
+    uint64_t get_delegated_balance(const delegated_voice_table & delegated, const uint64_t & epoch);
+    uint64_t delegation_value(const name & account, const name & scope, const uint64_t & epoch);
+    void join_delegatee(const name & delegator, const name & delegatee, const name & scope);
+    void leave_delegatee(const name & delegator, const name & scope);
+    void settle_delegation(const name & account, const name & scope);
+    void change_delegation_value(const name & account, const name & scope, const int64_t & delta);
+    uint64_t use_delegated_voice(const name & voter, const name & scope, const uint64_t & proposal_id, const double & percentage_used, double & shares, uint64_t & represented);
+    void change_delegators(const name & delegatee, const name & scope, const int64_t & delta);
+    uint64_t pool_delegators(const name & account, const name & scope);
+    bool delegates_to(const name & account, const name & delegatee, const name & scope);
+    void credit_delegated_votes(const name & account, const uint64_t & votes);
+    void detach_delegated_votes(const name & delegator, const name & scope);
+    std::vector<uint64_t> active_proposals_in_scope(const name & scope);
+    void take_delegation_voice(const name & account, const name & scope);
     bool is_active(const name & account, const uint64_t & cutoff_date);
     
     void init_cycle_new_stats();
@@ -393,10 +502,10 @@ extern "C" void apply(uint64_t receiver, uint64_t code, uint64_t action) {
       switch (action) {
         EOSIO_DISPATCH_HELPER(dao, 
           (reset)(initcycle)
-          (create)(update)(cancel)(onperiod)(evaluate)(callback)
+          (create)(update)(cancel)(createprop)(updateprop)(cancelprop)(callbackprop)(onperiod)(evaluate)(evalprops)(skipeval)(callback)
           (changetrust)(addactive)
           (favour)(against)(neutral)(revertvote)(voteonbehalf)
-          (delegate)(undelegate)(mimicvote)(mimicrevert)
+          (delegate)(undelegate)(mimicvote)(mimicrevert)(settlevoice)(migdelegs)
           (decayvoices)(decayvoice)
           (updatevoices)(updatevoice)
           (erasepartpts)
@@ -2,6 +2,7 @@
 #include <eosio/asset.hpp>
 #include <eosio/transaction.hpp>
 #include <eosio/singleton.hpp>
+#include <eosio/crypto.hpp>
 #include <contracts.hpp>
 #include <tables.hpp>
 #include <tables/price_history_table.hpp>
@@ -21,10 +22,15 @@ CONTRACT exchange : public contract {
         rounds(receiver, receiver.value),
         dailystats(receiver, receiver.value),
         payhistory(receiver, receiver.value),
+        paydigests(receiver, receiver.value),
         flags(receiver, receiver.value)
         {}
       
     ACTION onperiod();
+
+    ACTION clearstats();
+
+    ACTION prunepays(uint64_t before_id, uint64_t chunksize);
     
     ACTION ontransfer(name buyer, name contract, asset tlos_quantity, string memo);
 
@@ -66,12 +72,15 @@ CONTRACT exchange : public contract {
     void on_husd(name from, name to, asset quantity, string memo);
 
     asset seeds_for_usd(asset usd_quantity);
-    void update_price(); 
     void price_update_aux();
     bool is_paused();
     bool is_set(name flag);
 
-    void price_history_update(); 
+    void price_history_update();
+
+    void clear_daily_stats();
+    checksum256 payment_digest(const string & paymentId);
+    bool is_duplicate_payment(const string & paymentId, const checksum256 & digest); 
 
     symbol tlos_symbol = symbol("TLOS", 4);
     symbol husd_symbol = symbol("HUSD", 2);
@@ -80,6 +89,7 @@ CONTRACT exchange : public contract {
     name paused_flag = "paused"_n;
     name tlos_paused_flag = "tlos.paused"_n;
     name husd_contract = "husd.hypha"_n;
+    uint64_t daily_stats_batch_size = 200;
 
     TABLE configtable {
       asset seeds_per_usd;
@@ -101,6 +111,15 @@ CONTRACT exchange : public contract {
       uint64_t by_payment_id()const { return std::hash<std::string>{}(paymentId); }
     };
 
+    // written by prunepays for each newpayment id it removes from payhistory, never pruned
+    TABLE payment_digest_table {
+      uint64_t id;
+      checksum256 digest; // sha256 of the payment id
+
+      uint64_t primary_key()const { return id; }
+      checksum256 by_digest()const { return digest; }
+    };
+
     TABLE round_table {
       uint64_t id;
       uint64_t max_sold;
@@ -151,6 +170,8 @@ CONTRACT exchange : public contract {
 
     typedef singleton<"price"_n, price_table> price_tables;
     typedef eosio::multi_index<"price"_n, price_table> dump_for_price;
+
+    price_table update_price();
     
     typedef multi_index<"dailystats"_n, stattable> stattables;
     
@@ -160,6 +181,10 @@ CONTRACT exchange : public contract {
       indexed_by<"bypaymentid"_n,const_mem_fun<payhistory_table, uint64_t, &payhistory_table::by_payment_id>>
     > payhistory_tables;
 
+    typedef eosio::multi_index<"paydigests"_n, payment_digest_table,
+      indexed_by<"bydigest"_n,const_mem_fun<payment_digest_table, checksum256, &payment_digest_table::by_digest>>
+    > payment_digest_tables;
+
     configtables config;
 
     soldtables sold;
@@ -174,6 +199,8 @@ CONTRACT exchange : public contract {
 
     payhistory_tables payhistory;
 
+    payment_digest_tables paydigests;
+
     flags_tables flags;
 
 };
@@ -186,7 +213,7 @@ extern "C" void apply(uint64_t receiver, uint64_t code, uint64_t action) {
   } else if (code == receiver) {
       switch (action) {
           EOSIO_DISPATCH_HELPER(exchange, 
-          (reset)(onperiod)(updatetlos)(updatelimit)(newpayment)
+          (reset)(onperiod)(clearstats)(prunepays)(updatetlos)(updatelimit)(newpayment)
           (addround)(initsale)(initrounds)(priceupdate)
           (migrate)(pause)(unpause)(setflag)
           (incprice)
@@ -144,6 +144,7 @@ CONTRACT gratitude : public contract {
     // External tables
     user_tables users;
     config_tables config;
+    config_snapshot<uint64_t> config_cache;
     size_tables sizes;
 
     const name gratzgen_res = "gratz1.gen"_n; // Gratitude generated per cycle for residents
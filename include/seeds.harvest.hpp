@@ -10,7 +10,13 @@
 #include <utils.hpp>
 #include <tables/rep_table.hpp>
 #include <tables/size_table.hpp>
+#include <tables/score_bucket_table.hpp>
+#include <tables/trx_points_sum_table.hpp>
+#include <tables/qev_sum_table.hpp>
+#include <tables/rank_change_table.hpp>
+#include <tables/change_cursor_table.hpp>
 #include <tables/user_table.hpp>
+#include <tables/user_core_table.hpp>
 #include <tables/config_table.hpp>
 #include <tables/config_float_table.hpp>
 #include <tables/cbs_table.hpp>
@@ -42,9 +48,15 @@ CONTRACT harvest : public contract {
         monthlyqevs(receiver, receiver.value),
         mintrate(receiver, receiver.value),
         regioncstemp(receiver, receiver.value),
+        scorecursor(receiver, receiver.value),
+        txptcursor(receiver, receiver.value),
+        rankcursor(receiver, receiver.value),
+        csdirty(receiver, receiver.value),
+        rewardindex(receiver, receiver.value),
         config(contracts::settings, contracts::settings.value),
         configfloat(contracts::settings, contracts::settings.value),
         users(contracts::accounts, contracts::accounts.value),
+        usercore(contracts::accounts, contracts::accounts.value),
         rep(contracts::accounts, contracts::accounts.value),
         cbs(contracts::accounts, contracts::accounts.value),
         circulating(contracts::token, contracts::token.value),
@@ -70,8 +82,8 @@ CONTRACT harvest : public contract {
     ACTION rankplanteds();
     ACTION rankplanted(uint128_t start_val, uint64_t chunk, uint64_t chunksize);
 
-    ACTION calctrxpts(); // calculate transaction points // 24h interval
-    ACTION calctrxpt(uint64_t start_val, uint64_t chunk, uint64_t chunksize);
+    ACTION calctrxpts(eosio::binary_extension<name> op_id); // calculate transaction points // 24h interval
+    ACTION calctrxpt(uint64_t chunksize, eosio::binary_extension<name> op_id);
 
     ACTION ranktxs(); // rank transaction score // 1h interval
     ACTION rankorgtxs(); // rank org transaction score
@@ -87,6 +99,13 @@ CONTRACT harvest : public contract {
 
     ACTION rankrgncss();
     ACTION rankrgncs(uint64_t start, uint64_t chunk, uint64_t chunksize);
+    ACTION rgnmember(name region, name account, bool joined);
+    ACTION removergncs(name region);
+
+    ACTION rankscores(eosio::binary_extension<name> op_id); // rank planted, tx, calculate and rank contribution points in one pass // 1h interval
+    ACTION rankscore(uint64_t budget, eosio::binary_extension<name> op_id);
+
+    ACTION migbuckets(uint64_t start, uint64_t chunksize);
 
     ACTION updatetxpt(name account);
     ACTION calctotal(uint64_t startval);
@@ -104,8 +123,8 @@ CONTRACT harvest : public contract {
     ACTION testcalcmqev(uint64_t day, uint64_t total_volume, uint64_t circulating);
     ACTION calcmintrate();
 
-    ACTION disthvstusrs(uint64_t start, uint64_t chunksize, asset total_amount);
-    ACTION disthvstorgs(uint64_t start, uint64_t chunksize, asset total_amount);
+    ACTION claimreward(name account);
+    ACTION sweeprewards(name cs_scope, uint64_t start, uint64_t chunksize);
     ACTION disthvstrgns(uint64_t start, uint64_t chunksize, asset total_amount);
     ACTION disthvstdhos(uint64_t start, uint64_t chunksize, asset total_amount);
 
@@ -138,8 +157,27 @@ CONTRACT harvest : public contract {
     const name individual_scope_harvest = get_self();
     const name organization_scope = "org"_n;
 
+    const name planted_buckets = "planted"_n;
+
     const name rgn_status_active = "active"_n;
 
+    // steps of the fused contribution score pipeline, in execution order
+    const name score_step_planted = "planted"_n;
+    const name score_step_txpoints = "txpoints"_n;
+    const name score_step_orgtxpoints = "orgtxpoints"_n;
+    const name score_step_calccs = "calccs"_n;
+    const name score_step_rankcs = "rankcs"_n;
+    const name score_step_rankorgcs = "rankorgcs"_n;
+    const name score_step_done = "done"_n;
+    // not a pipeline step, marks the full calccss rebuild of all contribution scores
+    const name score_step_fullcs = "fullcs"_n;
+
+    // calculating the contribution points of an account reads 4 rank tables and writes cspoints
+    const uint64_t calc_cs_cost = 4;
+
+    // fixed point scale of the reward indexes, keeps precision for sums of ranks up to 10^8
+    const uint128_t reward_index_scale = 1000000000000;
+
     void init_balance(name account);
     void init_harvest_stat(name account);
     void check_user(name account);
@@ -147,12 +185,20 @@ CONTRACT harvest : public contract {
     void _deposit(asset quantity);
     void _withdraw(name account, asset quantity);
     uint32_t calc_transaction_points(name account, name type);
+    void set_transaction_points(name account, name type, uint64_t total_points);
     double get_rep_multiplier(name account);
     void add_planted(name account, asset quantity);
     void sub_planted(name account, asset quantity);
     void change_total(bool add, asset quantity);
-    void calc_contribution_score(name account, name type);
-    void add_cs_to_region(name account, uint32_t points);
+    void calc_contribution_score(name account, name type, bool full_region = false);
+    void add_cs_to_region(name account, int64_t delta);
+    void add_cs_to_rgn(name region, int64_t delta);
+    void remove_rgn_rank(name region);
+    bool region_rebuild_pending(name account);
+    void mark_cs_dirty(name account);
+    void add_reward_index(name cs_scope, asset amount);
+    void settle_reward(name account, name cs_scope, uint64_t rank);
+    void pay_reward(name account, name cs_scope);
 
     void size_change(name id, int delta);
     void size_set(name id, uint64_t newsize);
@@ -160,6 +206,8 @@ CONTRACT harvest : public contract {
 
     uint64_t config_get(name key);
     double config_float_get(name key);
+    uint64_t qev_volume_before(uint64_t timestamp);
+    uint64_t qev_window_volume(uint64_t from, uint64_t to);
     void send_distribute_harvest (name key, asset amount);
     void withdraw_aux(name sender, name beneficiary, asset quantity, string memo);
     void send_pool_payout(asset quantity);
@@ -266,6 +314,10 @@ CONTRACT harvest : public contract {
 
     DEFINE_SIZE_TABLE_MULTI_INDEX
 
+    DEFINE_SCORE_BUCKET_TABLE
+
+    DEFINE_SCORE_BUCKET_TABLE_MULTI_INDEX
+
     // DEPRECATED - REMOVE ONCE APPS ARE UPDATED // 
     DEFINE_HARVEST_TABLE
     
@@ -279,6 +331,10 @@ CONTRACT harvest : public contract {
 
     DEFINE_USER_TABLE_MULTI_INDEX
 
+    DEFINE_USER_CORE_TABLE
+
+    DEFINE_USER_CORE_TABLE_MULTI_INDEX
+
     DEFINE_CONFIG_TABLE
 
     DEFINE_CONFIG_TABLE_MULTI_INDEX
@@ -409,6 +465,89 @@ CONTRACT harvest : public contract {
 
     typedef eosio::multi_index<"mintrate"_n, mint_rate_table> mint_rate_tables;
 
+    TABLE score_cursor_table {
+      uint64_t id;
+      name step;
+      uint128_t start_val;
+      uint64_t current;
+      uint64_t total;
+      uint64_t sum_rank;
+      uint64_t chunk;
+      uint64_t started_at;
+
+      uint64_t primary_key() const { return id; }
+    };
+
+    typedef singleton<"scorecursor"_n, score_cursor_table> score_cursor_tables;
+    typedef eosio::multi_index<"scorecursor"_n, score_cursor_table> dump_for_score_cursor;
+
+    void score_next_step(score_cursor_table & sc);
+    bool score_planted(score_cursor_table & sc, uint64_t & budget);
+    bool score_txpoints(score_cursor_table & sc, uint64_t & budget, name table);
+    bool score_calccs(score_cursor_table & sc, uint64_t & budget);
+    bool score_rankcs(score_cursor_table & sc, uint64_t & budget, name cs_scope, uint64_t min_eligible);
+
+    // From history contract
+    DEFINE_TRX_POINTS_SUM_TABLE
+
+    DEFINE_TRX_POINTS_SUM_TABLE_MULTI_INDEX
+
+    DEFINE_QEV_SUM_TABLE
+
+    DEFINE_QEV_SUM_TABLE_MULTI_INDEX
+
+    DEFINE_QEV_SUM_STATE_TABLE
+
+    DEFINE_QEV_SUM_STATE_SINGLETON
+
+    // From accounts contract
+    DEFINE_RANK_CHANGE_TABLE
+
+    DEFINE_RANK_CHANGE_TABLE_MULTI_INDEX
+
+    // start_key is the byupdated key the next run resumes from, rows updated at or
+    // after until are left for the next run
+    DEFINE_CHANGE_CURSOR_TABLE
+
+    typedef singleton<"txptcursor"_n, change_cursor_table> tx_points_cursor_tables;
+    typedef eosio::multi_index<"txptcursor"_n, change_cursor_table> dump_for_tx_points_cursor;
+
+    DEFINE_RANK_CURSOR_SINGLETON
+    typedef eosio::multi_index<"rankcursor"_n, change_cursor_table> dump_for_rank_cursor;
+
+    // accounts whose planted, tx, rep or cbs rank changed since their contribution score was calculated
+    TABLE cs_dirty_table {
+      name account;
+
+      uint64_t primary_key() const { return account.value; }
+    };
+
+    typedef eosio::multi_index<"csdirty"_n, cs_dirty_table> cs_dirty_tables;
+
+    // harvest seeds minted per unit of contribution score rank since the index was introduced,
+    // scaled by reward_index_scale. runharvest only bumps these, accounts claim the difference
+    TABLE reward_index_table {
+      uint128_t users_index;
+      uint128_t orgs_index;
+      uint64_t timestamp;
+      eosio::binary_extension<int64_t> users_pending; // minted while nothing was ranked, added with the next bump
+      eosio::binary_extension<int64_t> orgs_pending;
+    };
+
+    typedef singleton<"rewardindex"_n, reward_index_table> reward_index_tables;
+    typedef eosio::multi_index<"rewardindex"_n, reward_index_table> dump_for_reward_index;
+
+    // harvest owed to an account, scoped like cspoints
+    TABLE reward_table {
+      name account;
+      uint128_t last_index; // reward index the account was last settled at
+      asset unclaimed;
+
+      uint64_t primary_key() const { return account.value; }
+    };
+
+    typedef eosio::multi_index<"rewards"_n, reward_table> reward_tables;
+
     TABLE members_table {
       name region;
       name account;
@@ -439,6 +578,11 @@ CONTRACT harvest : public contract {
     monthly_qev_tables monthlyqevs;
     mint_rate_tables mintrate;
     region_cs_temporal_tables regioncstemp;
+    score_cursor_tables scorecursor;
+    tx_points_cursor_tables txptcursor;
+    rank_cursor_tables rankcursor;
+    cs_dirty_tables csdirty;
+    reward_index_tables rewardindex;
 
     // DEPRECATED - remove
     typedef eosio::multi_index<"harvest"_n, harvest_table> harvest_tables;
@@ -448,7 +592,10 @@ CONTRACT harvest : public contract {
     // External Tables
     config_tables config;
     config_float_tables configfloat;
+    config_snapshot<uint64_t> config_cache;
+    config_snapshot<double> config_float_cache;
     user_tables users;
+    user_core_tables usercore;
     cbs_tables cbs;
     rep_tables rep;
     total_tables total;
@@ -467,12 +614,13 @@ extern "C" void apply(uint64_t receiver, uint64_t code, uint64_t action) {
           EOSIO_DISPATCH_HELPER(harvest, 
           (payforcpu)(reset)
           (unplant)(claimrefund)(cancelrefund)(sow)
-          (ranktx)(calctrxpt)(calctrxpts)(rankplanted)(rankplanteds)(calccss)(calccs)(rankcss)(rankorgcss)(rankcs)(ranktxs)(rankorgtxs)(updatecs)(rankrgncss)(rankrgncs)
+          (ranktx)(calctrxpt)(calctrxpts)(rankplanted)(rankplanteds)(calccss)(calccs)(rankcss)(rankorgcss)(rankcs)(ranktxs)(rankorgtxs)(updatecs)(rankrgncss)(rankrgncs)(rgnmember)(removergncs)
+          (rankscores)(rankscore)(migbuckets)
           (updatetxpt)(calctotal)
           (setorgtxpt)
           (testclaim)(testupdatecs)(testcalcmqev)(testcspoints)
           (calcmqevs)(calcmintrate)
-          (runharvest)(disthvstusrs)(disthvstorgs)(disthvstrgns)(disthvstdhos)
+          (runharvest)(claimreward)(sweeprewards)(disthvstrgns)(disthvstdhos)
           (logaction)(lgcalcmqevs)(lgrunhrvst)(lgcalmntrte)(resetlogs)(resetlgroups)
           (ldsthvstusrs)(ldsthvstorgs)(ldsthvstrgns)
         )
@@ -7,11 +7,14 @@
 #include <tables/config_float_table.hpp>
 #include <tables/size_table.hpp>
 #include <tables/organization_table.hpp>
+#include <tables/trx_points_sum_table.hpp>
+#include <tables/qev_sum_table.hpp>
 
 #include <contracts.hpp>
 #include <tables/user_table.hpp>
 
 #include <cmath>
+#include <map>
 
 using namespace eosio;
 using std::string;
@@ -32,6 +35,11 @@ CONTRACT history : public contract {
           members(contracts::region, contracts::region.value)
         {}
 
+        typedef struct cbsreward {
+          name account;
+          int32_t points;
+        } CbsReward;
+
         ACTION reset(name account);
 
         ACTION historyentry(name account, string action, uint64_t amount, string meta);
@@ -54,6 +62,18 @@ CONTRACT history : public contract {
 
         ACTION updatetxpt(uint64_t deferred_id, name from);
 
+        ACTION drainqueue();
+
+        ACTION sendcbsrwds(std::vector<CbsReward> rewards);
+
+        ACTION requeuetrxs(uint64_t chunksize);
+
+        ACTION expiretrx();
+
+        ACTION migtrxsums(uint64_t start, uint64_t chunksize);
+
+        ACTION migqevsums(uint64_t start, uint64_t chunksize);
+
         ACTION cleanptrxs();
 
         ACTION testtotalqev(uint64_t numdays, uint64_t volume);
@@ -87,18 +107,32 @@ CONTRACT history : public contract {
       void fire_orgtx_calc(name organization, uint128_t start_val, uint64_t chunksize, uint64_t running_total);
       bool clean_old_tx(name org, uint64_t chunksize);
       void save_from_metrics (name from, int64_t & from_points, int64_t & qualifying_volume, uint64_t & day);
-      void send_update_txpoints (name from);
+      void save_to_points (name to, int64_t to_points, uint64_t day);
+      void change_trx_points_sum (name account, int64_t delta);
+      void change_qev_sum (uint64_t day, int64_t delta);
+      void set_qev_sums_ready (bool ready);
+      void add_trx_expiry (name account, uint64_t day);
+      uint64_t trx_points_cutoff ();
+      bool save_points (uint64_t id, uint64_t day);
+      void trx_cbp_rewards (name from, name to, std::map<name, int32_t> & rewards);
+      void send_drain_queue ();
       double config_float_get(name key);
       double get_transaction_multiplier(name account, name other);
-      void send_trx_cbp_reward_action(name from, name to);
       void send_add_cbs(name account, int points);
-      void trx_cbp_reward(name account, name key);
+      int32_t trx_cbp_reward(name account, name key);
+      void send_cbs_rewards(const std::map<name, int32_t> & rewards);
+
+      config_snapshot<uint64_t> config_cache;
+      config_snapshot<double> config_float_cache;
       
       // migration functions
       void save_migration_user_transaction(name from, name to, asset quantity, uint64_t timestamp);
       void adjust_transactions(uint64_t id, uint64_t timestamp);
       uint64_t get_deferred_id();
 
+      const uint64_t queue_stale_sec = 60;
+      const uint64_t queue_max_stalls = 3; // stale one entry drains in a row on the same head before it is moved aside
+
       TABLE citizen_table {
         uint64_t id;
         name account;
@@ -262,6 +296,66 @@ CONTRACT history : public contract {
       typedef singleton<"deferredids"_n, deferred_id_table> deferred_id_tables;
       typedef eosio::multi_index<"deferredids"_n, deferred_id_table> dump_for_deferred_id;
 
+      TABLE trx_queue_table { // transfers waiting for savepoints and cbp rewards
+        uint64_t id;
+        uint64_t transaction_id;
+        uint64_t day;
+        name from;
+        name to;
+        uint64_t timestamp;
+
+        uint64_t primary_key() const { return id; }
+      };
+
+      typedef eosio::multi_index<"trxqueue"_n, trx_queue_table> trx_queue_tables;
+      typedef eosio::multi_index<"trxqfailed"_n, trx_queue_table> trx_queue_failed_tables; // entries that kept failing a drain on their own, see requeuetrxs
+
+      TABLE drain_stats_table {
+        uint64_t batches;
+        uint64_t processed;
+        uint64_t skipped;
+        uint64_t last_batch_size;
+        uint64_t last_max_lag; // seconds the oldest entry of the last batch waited in the queue
+        bool last_left_pending;
+        uint64_t last_drained_at;
+        uint64_t scheduled_at; // when the pending drain was sent, 0 if none is pending
+        uint64_t isolate_until; // after a stale drain, queue ids below this are drained one per transaction
+        uint64_t head_id; // queue head seen by the last stale one entry drain
+        uint64_t head_stalls; // stale one entry drains in a row with the same head
+        uint64_t moved_aside;
+        uint64_t requeued;
+      };
+
+      typedef singleton<"drainstats"_n, drain_stats_table> drain_stats_tables;
+      typedef eosio::multi_index<"drainstats"_n, drain_stats_table> dump_for_drain_stats;
+
+      TABLE trx_expiry_table { // scoped by day, accounts with a trxpoints row for that day
+        name account;
+
+        uint64_t primary_key() const { return account.value; }
+      };
+
+      typedef eosio::multi_index<"trxexpiry"_n, trx_expiry_table> trx_expiry_tables;
+
+      TABLE expiry_cursor_table {
+        uint64_t next_day; // oldest day whose points are still in the trxptsums
+      };
+
+      typedef singleton<"expirycursor"_n, expiry_cursor_table> expiry_cursor_tables;
+      typedef eosio::multi_index<"expirycursor"_n, expiry_cursor_table> dump_for_expiry_cursor;
+
+      DEFINE_TRX_POINTS_SUM_TABLE
+
+      DEFINE_TRX_POINTS_SUM_TABLE_MULTI_INDEX
+
+      DEFINE_QEV_SUM_TABLE
+
+      DEFINE_QEV_SUM_TABLE_MULTI_INDEX
+
+      DEFINE_QEV_SUM_STATE_TABLE
+
+      DEFINE_QEV_SUM_STATE_SINGLETON
+
       typedef eosio::multi_index<"citizens"_n, citizen_table,
         indexed_by<"byaccount"_n,
         const_mem_fun<citizen_table, uint64_t, &citizen_table::by_account>>
@@ -344,7 +438,8 @@ EOSIO_DISPATCH(history,
   (numtrx)
   (deldailytrx)(savepoints)
   (testtotalqev)
-  (sendtrxcbp)(updatetxpt)
+  (sendtrxcbp)(updatetxpt)(drainqueue)(sendcbsrwds)(requeuetrxs)
+  (expiretrx)(migtrxsums)(migqevsums)
   (cleanptrxs)
   (migrateusers)(migrateuser)
   (migrate)(testptrx)
@@ -193,6 +193,7 @@ private:
   referrer_tables referrers;
   campaign_tables campaigns;
   config_tables config;
+  config_snapshot<uint64_t> config_cache;
   campaign_invite_tables campinvites;
 };
 
@@ -22,6 +22,7 @@ CONTRACT organization : public contract {
               sponsors(receiver, receiver.value),
               apps(receiver, receiver.value),
               dausscores(receiver, receiver.value),
+              apptrails(receiver, receiver.value),
               regenscores(receiver, receiver.value),
               cbsorgs(receiver, receiver.value),
               sizes(receiver, receiver.value),
@@ -67,6 +68,10 @@ CONTRACT organization : public contract {
 
         ACTION calcmappuse(uint64_t start, uint64_t chunksize, uint64_t threshold, uint64_t cutoff);
 
+        ACTION cleandaus();
+
+        ACTION cleandau(uint64_t start, uint64_t chunksize);
+
         ACTION rankappuses();
 
         ACTION rankappuse(uint128_t start, uint64_t chunk, uint64_t chunksize);
@@ -271,6 +276,16 @@ CONTRACT organization : public contract {
             uint64_t primary_key() const { return day; }
         };
 
+        // rolling sum of the daustotals rows from window_start on, kept current by appuse
+        TABLE app_trail_table {
+            name app_name;
+            int64_t trailing_points;
+            uint64_t trailing_uses;
+            uint64_t window_start;
+
+            uint64_t primary_key() const { return app_name.value; }
+        };
+
         TABLE daus_score {
             name app_name;
             int64_t total_points;
@@ -353,6 +368,8 @@ CONTRACT organization : public contract {
 
         typedef eosio::multi_index<"daustotals"_n, daus_totals_table> daus_totals_tables;
 
+        typedef eosio::multi_index<"apptrails"_n, app_trail_table> app_trail_tables;
+
         typedef eosio::multi_index<"dausscores"_n, daus_score,
             indexed_by<"bytpoints"_n,
             const_mem_fun<daus_score, uint64_t, &daus_score::by_total_points>>,
@@ -394,8 +411,10 @@ CONTRACT organization : public contract {
         sponsors_tables sponsors;
         user_tables users;
         config_tables config;
+        config_snapshot<uint64_t> config_cache;
         app_tables apps;
         daus_scores dausscores;
+        app_trail_tables apptrails;
         regen_score_tables regenscores;
         cbs_organization_tables cbsorgs;
         size_tables sizes;
@@ -423,7 +442,7 @@ CONTRACT organization : public contract {
         void check_referrals(name organization, uint64_t min_visitors_invited, uint64_t min_residents_invited);
         void check_status_requirements(name organization, uint64_t status);
         void history_update_org_status(name organization, uint64_t status);
-        void calculate_trailing_app_use(const name & appname, const uint64_t & cutoff, const int64_t & threshold);
+        uint64_t calculate_trailing_app_use(const name & appname, const uint64_t & cutoff, const int64_t & threshold);
 };
 
 
@@ -434,7 +453,7 @@ extern "C" void apply(uint64_t receiver, uint64_t code, uint64_t action) {
       switch (action) {
           EOSIO_DISPATCH_HELPER(organization, (reset)(addmember)(removemember)(changerole)(changeowner)(addregen)
             (subregen)(create)(destroy)(refund)
-            (appuse)(registerapp)(banapp)(calcmappuses)(calcmappuse)(rankappuses)(rankappuse)
+            (appuse)(registerapp)(banapp)(calcmappuses)(calcmappuse)(cleandaus)(cleandau)(rankappuses)(rankappuse)
             (rankregens)(rankregen)(scoreorgs)(scoretrxs)
             (makethrivble)(makeregen)(makesustnble)(makereptable)(testregensc)(teststatus))
       }
@@ -1,6 +1,8 @@
 #include <eosio/eosio.hpp>
 #include <eosio/asset.hpp>
 #include <eosio/transaction.hpp>
+#include <eosio/singleton.hpp>
+#include <eosio/binary_extension.hpp>
 #include <contracts.hpp>
 #include <utils.hpp>
 #include <tables/config_table.hpp>
@@ -18,6 +20,9 @@ CONTRACT pool : public contract {
       : contract(receiver, code, ds),
         balances(receiver, receiver.value),
         sizes(receiver, receiver.value),
+        poolindex(receiver, receiver.value),
+        epochs(receiver, receiver.value),
+        sweepstate(receiver, receiver.value),
         config(contracts::settings, contracts::settings.value)
         {}
 
@@ -27,7 +32,9 @@ CONTRACT pool : public contract {
 
     ACTION payouts(asset quantity);
 
-    ACTION payout(asset quantity, uint64_t start, uint64_t chunksize, int64_t old_total_balance);
+    ACTION claim(name account);
+
+    ACTION sweep(uint64_t start, uint64_t chunksize);
 
     ACTION transfer(name from, name to, asset quantity, const string& memo);
 
@@ -36,10 +43,17 @@ CONTRACT pool : public contract {
 
     const name total_balance_size = "total.sz"_n;
 
+    // fixed point scale of balance_index, the value it starts from at every epoch
+    const uint128_t balance_index_scale = 1000000000000000000;
+
+    // below this balance_index has lost too much precision and a new epoch is started
+    const uint128_t balance_index_floor = balance_index_scale / 1000000;
+
     void send_transfer(const name & to, const asset & quantity, const string & memo);
     void update_pool_token( const name& owner, const asset& quantity, const symbol sym = utils::pool_symbol);
     void add_balance( const name& owner, const asset& value, const name& ram_payer );
     bool sub_balance( const name& owner, const asset& value );
+    void settle_balance( const name& owner );
 
     DEFINE_CONFIG_TABLE
     DEFINE_CONFIG_TABLE_MULTI_INDEX
@@ -53,11 +67,38 @@ CONTRACT pool : public contract {
 
     TABLE balances_table {
       name account;
-      asset balance;
+      asset balance; // as of settled_index, payouts since then are deducted on settlement
+      eosio::binary_extension<uint128_t> settled_index;
+      eosio::binary_extension<uint64_t> settled_epoch;
 
       uint64_t primary_key () const { return account.value; }
     };
 
+    // What is left of one unit of balance after all payouts of the current epoch, scaled by
+    // balance_index_scale. A payout of quantity out of total shrinks it by (total - quantity) / total,
+    // a payout of everything or an index below balance_index_floor starts a new epoch
+    TABLE pool_index_table {
+      uint128_t balance_index;
+      uint64_t epoch;
+      uint64_t timestamp;
+    };
+
+    // balance_index an epoch ended at, 0 when it ended with a payout of everything
+    TABLE pool_epoch_table {
+      uint64_t epoch;
+      uint128_t end_index;
+
+      uint64_t primary_key () const { return epoch; }
+    };
+
+    // progress of a sweep started at the first holder, to reconcile total.sz when it ends
+    TABLE sweep_state_table {
+      uint128_t balance_index;
+      uint64_t epoch;
+      int64_t total;
+      int64_t sum;
+    };
+
     TABLE account {
       asset    balance;
 
@@ -67,8 +108,21 @@ CONTRACT pool : public contract {
     typedef eosio::multi_index<"balances"_n, balances_table> balances_tables;
     typedef eosio::multi_index< "accounts"_n, account > accounts;
 
+    typedef singleton<"poolindex"_n, pool_index_table> pool_index_tables;
+    typedef eosio::multi_index<"poolindex"_n, pool_index_table> dump_for_pool_index;
+
+    typedef eosio::multi_index<"poolepochs"_n, pool_epoch_table> pool_epoch_tables;
+
+    typedef singleton<"sweepstate"_n, sweep_state_table> sweep_state_tables;
+    typedef eosio::multi_index<"sweepstate"_n, sweep_state_table> dump_for_sweep_state;
+
+    pool_index_table get_pool_index();
+
     balances_tables balances;
     size_tables sizes;
+    pool_index_tables poolindex;
+    pool_epoch_tables epochs;
+    sweep_state_tables sweepstate;
 
     // external tables
     config_tables config;
@@ -82,7 +136,7 @@ extern "C" void apply(uint64_t receiver, uint64_t code, uint64_t action) {
       switch (action) {
         EOSIO_DISPATCH_HELPER(pool, 
           (reset)
-          (payouts)(payout)(transfer)
+          (payouts)(claim)(sweep)(transfer)
         )
       }
   }
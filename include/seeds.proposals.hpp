@@ -2,6 +2,7 @@
 #include <eosio/eosio.hpp>
 #include <eosio/transaction.hpp>
 #include <eosio/singleton.hpp>
+#include <eosio/binary_extension.hpp>
 #include <seeds.token.hpp>
 #include <contracts.hpp>
 #include <utils.hpp>
@@ -10,6 +11,7 @@
 #include <tables/config_table.hpp>
 #include <tables/ban_table.hpp>
 #include <tables/moon_phases_table.hpp>
+#include <tables/decay_rate_table.hpp>
 #include <vector>
 #include <cmath>
 
@@ -246,17 +248,14 @@ CONTRACT proposals : public contract {
       bool is_banned(name account);
       uint64_t get_new_moon(uint64_t timestamp);
 
+      config_snapshot<uint64_t> config_cache;
+
       uint64_t config_get(name key) {
         DEFINE_CONFIG_TABLE
         DEFINE_CONFIG_TABLE_MULTI_INDEX
         config_tables config(contracts::settings, contracts::settings.value);
-        
-        auto citr = config.find(key.value);
-          if (citr == config.end()) { 
-          // only create the error message string in error case for efficiency
-          eosio::check(false, ("settings: the "+key.to_string()+" parameter has not been initialized").c_str());
-        }
-        return citr->value;
+
+        return config_cache.get(config, key);
       }
 
       TABLE proposal_table {
@@ -340,6 +339,7 @@ CONTRACT proposals : public contract {
       TABLE voice_table {
         name account;
         uint64_t balance;
+        eosio::binary_extension<uint64_t> decay_epoch; // cycle decay_epoch the balance was last materialized at
         uint64_t primary_key()const { return account.value; }
       };
 
@@ -353,6 +353,7 @@ CONTRACT proposals : public contract {
         uint64_t propcycle; 
         uint64_t t_onperiod; // last time onperiod ran
         uint64_t t_voicedecay; // last time voice was decayed
+        eosio::binary_extension<uint64_t> decay_epoch; // number of voice decays so far, applied lazily to voice rows
       };
 
       TABLE active_table {
@@ -376,6 +377,9 @@ CONTRACT proposals : public contract {
       DEFINE_MOON_PHASES_TABLE
       DEFINE_MOON_PHASES_TABLE_MULTI_INDEX
 
+      DEFINE_DECAY_RATE_TABLE
+      DEFINE_DECAY_RATE_TABLE_MULTI_INDEX
+
       TABLE cycle_stats_table {
         uint64_t propcycle; 
         
@@ -451,6 +455,9 @@ CONTRACT proposals : public contract {
 
     typedef eosio::multi_index<"support"_n, support_level_table> support_level_tables;
 
+    uint64_t get_decay_epoch();
+    uint64_t get_voice_balance(const voice_table & voice, name scope, uint64_t epoch);
+
     DEFINE_SIZE_TABLE
     DEFINE_SIZE_TABLE_MULTI_INDEX
 
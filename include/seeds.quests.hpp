@@ -98,6 +98,12 @@ CONTRACT quests : public contract {
 
     ACTION ratequest(checksum256 quest_hash, name opinion);
 
+    ACTION migedges(uint64_t start, uint64_t chunksize);
+
+    ACTION testoldedge(checksum256 from_node, checksum256 to_node, name edge_name);
+
+    ACTION testhasedge(checksum256 from_node, name edge_name);
+
 
   private:
 
@@ -189,17 +195,14 @@ CONTRACT quests : public contract {
     DEFINE_SIZE_TABLE_MULTI_INDEX
 
 
+    config_snapshot<uint64_t> config_cache;
+
     uint64_t config_get(name key) {
       DEFINE_CONFIG_TABLE
       DEFINE_CONFIG_TABLE_MULTI_INDEX
       config_tables config(contracts::settings, contracts::settings.value);
-      
-      auto citr = config.find(key.value);
-        if (citr == config.end()) { 
-        // only create the error message string in error case for efficiency
-        eosio::check(false, ("settings: the "+key.to_string()+" parameter has not been initialized").c_str());
-      }
-      return citr->value;
+
+      return config_cache.get(config, key);
     }
 
     user_tables users;
@@ -219,6 +222,7 @@ extern "C" void apply(uint64_t receiver, uint64_t code, uint64_t action) {
           (expirequest)(expireappl)(cancelappl)(retractappl)(quitapplcnt)
           (evalprop)(favour)(against)
           (rateapplcnt)(ratequest)
+          (migedges)(testoldedge)(testhasedge)
         )
       }
   }
@@ -88,6 +88,7 @@ CONTRACT region : public contract {
         double config_float_get(name key);
         uint64_t config_get(name key);
         void update_members_count(name region, int delta);
+        void send_member_cs(name region, name account, bool joined);
         void add_harvest_balance(name region, asset amount);
 
         TABLE region_table {
@@ -190,6 +191,8 @@ CONTRACT region : public contract {
 
         config_tables config;
         config_float_tables configfloat;
+        config_snapshot<uint64_t> config_cache;
+        config_snapshot<double> config_float_cache;
         size_tables sizes;
 
         region_tables regions;
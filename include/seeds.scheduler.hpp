@@ -1,5 +1,7 @@
 #include <eosio/eosio.hpp>
 #include <eosio/system.hpp>
+#include <eosio/singleton.hpp>
+#include <eosio/binary_extension.hpp>
 #include <contracts.hpp>
 #include <utils.hpp>
 #include <tables/config_table.hpp>
@@ -19,6 +21,8 @@ CONTRACT scheduler : public contract {
         moonphases(receiver, receiver.value),
         test(receiver, receiver.value),
         moonops(receiver, receiver.value),
+        tickstats(receiver, receiver.value),
+        dispatches(receiver, receiver.value),
         config(contracts::settings, contracts::settings.value)
         {}
 
@@ -38,6 +42,21 @@ CONTRACT scheduler : public contract {
         ACTION removeop(name id);
 
         ACTION pauseop(name id, uint8_t pause);
+
+        // priority orders ready ops within a tick, lower first
+        ACTION setopsched(name id, uint8_t priority);
+
+        // an op with dependencies ignores its period and runs once all of them
+        // have reported completion since its last run
+        ACTION setopdeps(name id, std::vector<name> deps);
+
+        // called by contracts when the chunked run of one of their ops has finished,
+        // id is the op id the scheduler passed in with the dispatched action
+        ACTION opdone(name id);
+
+        // last action of the transaction that runs a dispatched op, so it only
+        // takes effect when the op action succeeded
+        ACTION confirmop(name id);
         
         ACTION stop();
         
@@ -55,6 +74,7 @@ CONTRACT scheduler : public contract {
 
     private:
         void exec_op(name id, name contract, name action);
+        bool in_flight(name id, uint64_t period, uint64_t timestamp);
         void cancel_exec();
         void reset_aux(bool destructive);
         uint64_t next_valid_moon_phase(uint64_t moon_cycle_id, uint64_t quarter_moon_cycles);
@@ -71,11 +91,50 @@ CONTRACT scheduler : public contract {
             uint8_t pause;
             uint64_t period;
             uint64_t timestamp;
+            eosio::binary_extension<uint8_t> priority;
+            eosio::binary_extension<uint64_t> cost; // no longer read, kept for the row layout
+            eosio::binary_extension<std::vector<name>> deps;
+            eosio::binary_extension<uint64_t> completed_at;
 
             uint64_t primary_key() const { return id.value; }
             uint64_t by_timestamp() const { return timestamp; }
         };
 
+        // what the last execute tick dispatched
+        TABLE tick_stats_table {
+            uint64_t timestamp;
+            uint64_t executed;
+            uint64_t in_flight; // dispatched before and not confirmed yet
+            uint64_t max_ops;
+            uint64_t left_ready; // ready ops over the dispatch cap
+        };
+
+        typedef singleton<"tickstats"_n, tick_stats_table> tick_stats_tables;
+        typedef eosio::multi_index<"tickstats"_n, tick_stats_table> dump_for_tick_stats;
+
+        // an op that was dispatched and whose run has not been confirmed yet,
+        // its timestamp only moves to used_timestamp once confirmop runs
+        TABLE dispatch_table {
+            name id;
+            uint64_t dispatched_at;
+            uint64_t used_timestamp;
+            bool moon;
+
+            uint64_t primary_key() const { return id.value; }
+        };
+
+        typedef eosio::multi_index<"dispatches"_n, dispatch_table> dispatch_tables;
+
+        struct ready_op {
+            name id;
+            name contract;
+            name operation;
+            uint8_t priority;
+            uint64_t timestamp;
+            uint64_t used_timestamp;
+            bool moon;
+        };
+
         DEFINE_MOON_PHASES_TABLE
         DEFINE_MOON_PHASES_TABLE_MULTI_INDEX
 
@@ -116,13 +175,25 @@ CONTRACT scheduler : public contract {
         typedef eosio::multi_index <"test"_n, test_table> test_tables;
 
         name seconds_to_execute = "secndstoexec"_n;
+        name max_dispatches = "sched.maxops"_n;
+
+        const uint8_t default_priority = 1;
+        // a dispatched op that did not confirm is sent again after its period, at most after this
+        const uint64_t op_retry_max = utils::seconds_per_hour;
+        // periods after which an op with deps runs without waiting for them
+        const uint64_t dep_max_periods = 3;
 
         operations_tables operations;
         config_tables config;
+        config_snapshot<uint64_t> config_cache;
         test_tables test;
         moon_phases_tables moonphases;
         moon_ops_tables moonops;
+        tick_stats_tables tickstats;
+        dispatch_tables dispatches;
 
+        uint64_t config_get(name key);
+        void fill_extensions(operations_table & op);
         uint64_t is_ready_op(const name & operation, const uint64_t & timestamp);
         uint64_t is_ready_moon_op(const name & operation, const uint64_t & timestamp);
 };
@@ -10,7 +10,9 @@
 #include <contracts.hpp>
 #include <tables.hpp>
 #include <tables/config_table.hpp>
+#include <tables/user_core_table.hpp>
 #include <eosio/singleton.hpp>
+#include <eosio/binary_extension.hpp>
 
 #include <string>
 
@@ -37,7 +39,9 @@ namespace eosio {
          using contract::contract;
          token(name receiver, name code, datastream<const char*> ds)
             :  contract(receiver, code, ds),
-               circulating(receiver, receiver.value)
+               circulating(receiver, receiver.value),
+               weekepoch(receiver, receiver.value),
+               sysaccts(receiver, receiver.value)
                {}
          
          /**
@@ -175,11 +179,12 @@ namespace eosio {
          [[eosio::action]]
          void resetweekly();
 
-         [[eosio::action]]
-         void resetwhelper(uint64_t begin);
-
          ACTION updatecirc();
 
+         ACTION addsysacct(const name& account);
+
+         ACTION rmsysacct(const name& account);
+
          ACTION minthrvst(const name& to, const asset& quantity, const string& memo);
 
          using create_action = eosio::action_wrapper<"create"_n, &token::create>;
@@ -217,6 +222,7 @@ namespace eosio {
             uint64_t total_transactions;
             uint64_t incoming_transactions;
             uint64_t outgoing_transactions;
+            eosio::binary_extension<uint64_t> epoch; // week the counters were counted in, older weeks read as 0
 
             uint64_t primary_key()const { return account.value; }
             uint64_t by_transaction_volume()const { return transactions_volume.amount; }
@@ -234,6 +240,10 @@ namespace eosio {
             const_mem_fun<tables::user_table, uint64_t, &tables::user_table::by_reputation>>
           > user_tables;
 
+         DEFINE_USER_CORE_TABLE
+
+         DEFINE_USER_CORE_TABLE_MULTI_INDEX
+
          void sub_balance( const name& owner, const asset& value );
          void add_balance( const name& owner, const asset& value, const name& ram_payer );
          void update_stats( const name& from, const name& to, const asset& quantity );
@@ -241,7 +251,11 @@ namespace eosio {
          void check_limit( const name& from );
          uint64_t balance_for( const name& owner );
          void check_limit_transactions(name from);
-         void reset_weekly_aux(uint64_t begin);
+         name user_status( const name& account );
+         uint64_t current_week_epoch();
+         uint64_t outgoing_this_week( const name& account );
+         bool is_system_account( const name& account );
+         void adjust_circulating( int64_t circulating_delta, int64_t total_delta );
 
          TABLE circulating_supply_table {
             uint64_t id;
@@ -255,6 +269,28 @@ namespace eosio {
 
          circulating_supply_tables circulating;
 
+         // accounts whose balances are not part of the circulating supply
+         TABLE system_account_table {
+            name account;
+
+            uint64_t primary_key()const { return account.value; }
+         };
+
+         typedef eosio::multi_index<"sysaccts"_n, system_account_table> system_account_tables;
+
+         system_account_tables sysaccts;
+
+         // number of weekly resets so far, trxstat rows from an earlier epoch start over on their next update
+         TABLE week_epoch_table {
+            uint64_t epoch;
+            uint64_t timestamp;
+         };
+
+         typedef singleton<"weekepoch"_n, week_epoch_table> week_epoch_tables;
+         typedef eosio::multi_index<"weekepoch"_n, week_epoch_table> dump_for_week_epoch;
+
+         week_epoch_tables weekepoch;
+
          typedef eosio::multi_index<"config"_n, config_table> config_tables;
          typedef eosio::multi_index<"balances"_n, tables::balance_table,
          indexed_by<"byplanted"_n,
@@ -0,0 +1,14 @@
+#include <eosio/eosio.hpp>
+#include <eosio/singleton.hpp>
+
+using eosio::name;
+
+// Position in a byupdated index of another contract's change table
+// SCOPE harvest contract
+#define DEFINE_CHANGE_CURSOR_TABLE TABLE change_cursor_table { \
+      uint128_t start_key; \
+      uint64_t until; \
+    };
+
+// rows of accounts::rankchanges before start_key have been consumed by harvest
+#define DEFINE_RANK_CURSOR_SINGLETON typedef singleton<"rankcursor"_n, change_cursor_table> rank_cursor_tables;
@@ -1,4 +1,5 @@
 #include <eosio/eosio.hpp>
+#include <tables/config_table.hpp>
 
 using eosio::name;
 
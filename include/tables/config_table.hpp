@@ -1,4 +1,6 @@
 #include <eosio/eosio.hpp>
+#include <vector>
+#include <utility>
 
 using eosio::name;
 
@@ -14,10 +16,56 @@ using eosio::name;
 #define DEFINE_CONFIG_TABLE_MULTI_INDEX typedef eosio::multi_index<"config"_n, config_table> config_tables; 
 
 #define DEFINE_CONFIG_GET \
+        config_snapshot<uint64_t> config_cache; \
         uint64_t config_get (name key) { \
-            auto citr = config.find(key.value);\
-            if (citr == config.end()) { \
-                eosio::check(false, ("settings: the "+key.to_string()+" parameter has not been initialized").c_str());\
-            }\
-            return citr->value;\
+            return config_cache.get(config, key); \
         } \
+
+// this header is included several times per contract, the macros above can be
+// redefined but the class below can not
+#ifndef SEEDS_CONFIG_SNAPSHOT
+#define SEEDS_CONFIG_SNAPSHOT
+
+// Settings values read during one action. A contract object lives exactly as long as
+// the action it runs, so holding one of these as a member reads each param from
+// contracts::settings at most once however often a loop asks for it.
+// Works for both the config (uint64_t) and configfloat (double) tables.
+template<typename T>
+class config_snapshot {
+  public:
+    template<typename Table>
+    T get(const Table& table, name key) {
+      T value;
+      if (lookup(key, value)) {
+        return value;
+      }
+
+      auto citr = table.find(key.value);
+      if (citr == table.end()) { 
+        // only create the error message string in error case for efficiency
+        eosio::check(false, ("settings: the "+key.to_string()+" parameter has not been initialized").c_str());
+      }
+      return remember(key, citr->value);
+    }
+
+    bool lookup(name key, T& value) const {
+      for (const auto& entry : values) {
+        if (entry.first == key.value) {
+          value = entry.second;
+          return true;
+        }
+      }
+      return false;
+    }
+
+    T remember(name key, T value) {
+      values.emplace_back(key.value, value);
+      return value;
+    }
+
+  private:
+    // a handful of params per action, a linear scan is cheaper than a map
+    std::vector<std::pair<uint64_t, T>> values;
+};
+
+#endif
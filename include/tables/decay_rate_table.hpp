@@ -0,0 +1,18 @@
+#include <eosio/eosio.hpp>
+
+using eosio::name;
+
+// Voice multiplier applied at each decay epoch, recorded when the epoch starts
+// so later changes of vdecayprntge don't re-decay pending epochs.
+// cumulative is the sum of the log multipliers of every epoch up to this one, so the
+// decay between two epochs is exp of the difference of their rows
+#define DEFINE_DECAY_RATE_TABLE TABLE decay_rate_table { \
+        uint64_t epoch; \
+        double multiplier; \
+        double cumulative; \
+\
+        uint64_t primary_key() const { return epoch; } \
+      };
+
+#define DEFINE_DECAY_RATE_TABLE_MULTI_INDEX \
+        typedef eosio::multi_index<"decayrates"_n, decay_rate_table> decay_rate_tables;
@@ -0,0 +1,24 @@
+#include <eosio/eosio.hpp>
+#include <eosio/singleton.hpp>
+
+using eosio::name;
+
+// Running total of the history contract's qualifying volume, one row per day
+// cumulative_volume includes every qevs day up to and including timestamp
+// SCOPE history contract
+#define DEFINE_QEV_SUM_TABLE TABLE qev_sum_table { \
+      uint64_t timestamp; \
+      uint64_t cumulative_volume; \
+\
+      uint64_t primary_key() const { return timestamp; } \
+    };
+
+#define DEFINE_QEV_SUM_TABLE_MULTI_INDEX typedef eosio::multi_index<"qevsums"_n, qev_sum_table> qev_sum_tables;
+
+// ready is set once migqevsums has built qevsums from every qevs row, until then the running totals are incomplete
+// SCOPE history contract
+#define DEFINE_QEV_SUM_STATE_TABLE TABLE qev_sum_state_table { \
+      bool ready = false; \
+    };
+
+#define DEFINE_QEV_SUM_STATE_SINGLETON typedef singleton<"qevsumstate"_n, qev_sum_state_table> qev_sum_state_tables;
@@ -0,0 +1,17 @@
+#include <eosio/eosio.hpp>
+
+using eosio::name;
+
+// Accounts whose rep or cbs rank changed, with the time of the last change
+// SCOPE accounts contract
+#define DEFINE_RANK_CHANGE_TABLE TABLE rank_change_table { \
+      name account; \
+      uint64_t updated_at; \
+\
+      uint64_t primary_key() const { return account.value; } \
+      uint128_t by_updated() const { return (uint128_t(updated_at) << 64) + account.value; } \
+    };
+
+#define DEFINE_RANK_CHANGE_TABLE_MULTI_INDEX typedef eosio::multi_index<"rankchanges"_n, rank_change_table, \
+      indexed_by<"byupdated"_n,const_mem_fun<rank_change_table, uint128_t, &rank_change_table::by_updated>> \
+    > rank_change_tables;
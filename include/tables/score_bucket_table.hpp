@@ -0,0 +1,28 @@
+#include <eosio/eosio.hpp>
+
+using eosio::name;
+
+// Histogram of a score (rep, cbs, planted...), one row per score bucket
+// SCOPE by index name - e.g. "rep", "rep.org"
+#define DEFINE_SCORE_BUCKET_TABLE TABLE score_bucket_table { \
+        uint64_t bucket; \
+        uint64_t count; \
+\
+        uint64_t primary_key() const { return bucket; } \
+      };
+
+#define DEFINE_SCORE_BUCKET_TABLE_MULTI_INDEX \
+        typedef eosio::multi_index<"scorebuckets"_n, score_bucket_table> score_bucket_tables;
+
+// Rows per exact score, for scores that share a bucket (>= utils::exact_score_buckets).
+// Kept next to the histogram for indexes that need a position within a bucket (rep, cbs)
+// SCOPE by index name, same as the histogram
+#define DEFINE_SCORE_COUNT_TABLE TABLE score_count_table { \
+        uint64_t score; \
+        uint64_t count; \
+\
+        uint64_t primary_key() const { return score; } \
+      };
+
+#define DEFINE_SCORE_COUNT_TABLE_MULTI_INDEX \
+        typedef eosio::multi_index<"scorecounts"_n, score_count_table> score_count_tables;
@@ -0,0 +1,18 @@
+#include <eosio/eosio.hpp>
+
+using eosio::name;
+
+// Rolling sum of an account's trxpoints rows inside the cyctrx.trail window
+// SCOPE history contract
+#define DEFINE_TRX_POINTS_SUM_TABLE TABLE trx_points_sum_table { \
+      name account; \
+      uint64_t points; \
+      uint64_t updated_at; \
+\
+      uint64_t primary_key() const { return account.value; } \
+      uint128_t by_updated() const { return (uint128_t(updated_at) << 64) + account.value; } \
+    };
+
+#define DEFINE_TRX_POINTS_SUM_TABLE_MULTI_INDEX typedef eosio::multi_index<"trxptsums"_n, trx_points_sum_table, \
+      indexed_by<"byupdated"_n,const_mem_fun<trx_points_sum_table, uint128_t, &trx_points_sum_table::by_updated>> \
+    > trx_points_sum_tables;
@@ -0,0 +1,17 @@
+#include <eosio/eosio.hpp>
+
+using eosio::name;
+
+// The fields of the users table read on the transfer path, kept apart from the profile
+// so lookups do not deserialize nickname, story and the other profile strings
+// SCOPE accounts contract
+#define DEFINE_USER_CORE_TABLE TABLE user_core_table { \
+        name account; \
+        name status; \
+        name type; \
+        uint64_t timestamp; \
+\
+        uint64_t primary_key()const { return account.value; } \
+      };
+
+#define DEFINE_USER_CORE_TABLE_MULTI_INDEX typedef eosio::multi_index<"usercore"_n, user_core_table> user_core_tables;
@@ -2,12 +2,18 @@
 #include <eosio/asset.hpp>
 #include <eosio/system.hpp>
 #include <eosio/transaction.hpp>
+#include <eosio/binary_extension.hpp>
 #include <tables/rep_table.hpp>
 #include <tables/size_table.hpp>
 #include <tables/user_table.hpp>
+#include <tables/user_core_table.hpp>
 #include <tables/config_table.hpp>
 #include <tables/config_float_table.hpp>
 #include <tables/deferred_id_table.hpp>
+#include <tables/score_bucket_table.hpp>
+#include <tables/decay_rate_table.hpp>
+#include <algorithm>
+#include <cmath>
 
 using namespace eosio;
 using std::string;
@@ -158,6 +164,227 @@ namespace utils {
     return (uint64_t)rank_coefs[calc];
   }
 
+  // scores below this value get a bucket each, larger scores share 8 buckets per power of 2
+  const uint64_t exact_score_buckets = 64;
+
+  inline uint64_t score_bucket(uint64_t score) {
+    if (score < exact_score_buckets) return score;
+    uint64_t msb = 63 - __builtin_clzll(score);
+    uint64_t mantissa = (score >> (msb - 3)) & 7;
+    return exact_score_buckets + (msb - 6) * 8 + mantissa;
+  }
+
+  // lowest score that falls into a bucket
+  inline uint64_t score_bucket_floor(uint64_t bucket) {
+    if (bucket < exact_score_buckets) return bucket;
+    uint64_t msb = (bucket - exact_score_buckets) / 8 + 6;
+    uint64_t mantissa = (bucket - exact_score_buckets) % 8;
+    return (8 + mantissa) << (msb - 3);
+  }
+
+  // keeps the score histogram of an index up to date, call with the old score and -1 
+  // before changing a row and with the new score and +1 after. With exact_counts the rows
+  // per score are kept too, so a score can be placed exactly within its bucket.
+  void score_bucket_change(const name & code, const name & index, uint64_t score, int64_t delta, bool exact_counts = false) {
+
+    DEFINE_SCORE_BUCKET_TABLE
+    DEFINE_SCORE_BUCKET_TABLE_MULTI_INDEX
+
+    score_bucket_tables buckets(code, index.value);
+    uint64_t bucket = score_bucket(score);
+
+    auto bitr = buckets.find(bucket);
+    if (bitr == buckets.end()) {
+      if (delta > 0) {
+        buckets.emplace(code, [&](auto & item){
+          item.bucket = bucket;
+          item.count = delta;
+        });
+      }
+    } else if (delta < 0 && bitr->count <= uint64_t(-delta)) {
+      buckets.erase(bitr);
+    } else {
+      buckets.modify(bitr, code, [&](auto & item){
+        item.count += delta;
+      });
+    }
+
+    if (!exact_counts || score < exact_score_buckets) { return; }
+
+    DEFINE_SCORE_COUNT_TABLE
+    DEFINE_SCORE_COUNT_TABLE_MULTI_INDEX
+
+    score_count_tables counts(code, index.value);
+
+    auto citr = counts.find(score);
+    if (citr == counts.end()) {
+      if (delta > 0) {
+        counts.emplace(code, [&](auto & item){
+          item.score = score;
+          item.count = delta;
+        });
+      }
+    } else if (delta < 0 && citr->count <= uint64_t(-delta)) {
+      counts.erase(citr);
+    } else {
+      counts.modify(citr, code, [&](auto & item){
+        item.count += delta;
+      });
+    }
+
+  }
+
+  // Position of a score in its index, as the number of entries with a lower score, and the
+  // size of the index. Whole buckets below come from the histogram. Within the bucket the
+  // position comes from the exact counts, or without them is interpolated from the score.
+  // Entries with the same score share the first position.
+  void score_bucket_position(const name & code, const name & index, uint64_t score, bool exact_counts, uint64_t & position, uint64_t & total) {
+
+    DEFINE_SCORE_BUCKET_TABLE
+    DEFINE_SCORE_BUCKET_TABLE_MULTI_INDEX
+
+    score_bucket_tables buckets(code, index.value);
+    uint64_t bucket = score_bucket(score);
+
+    uint64_t within = 0;
+    position = 0;
+    total = 0;
+
+    for (auto bitr = buckets.begin(); bitr != buckets.end(); bitr++) {
+      if (bitr->bucket < bucket) {
+        position += bitr->count;
+      } else if (bitr->bucket == bucket) {
+        within = bitr->count;
+      }
+      total += bitr->count;
+    }
+
+    uint64_t floor = score_bucket_floor(bucket);
+    if (within == 0 || score == floor) { return; }
+
+    if (exact_counts) {
+      DEFINE_SCORE_COUNT_TABLE
+      DEFINE_SCORE_COUNT_TABLE_MULTI_INDEX
+
+      score_count_tables counts(code, index.value);
+      for (auto citr = counts.lower_bound(floor); citr != counts.end() && citr->score < score; citr++) {
+        position += citr->count;
+      }
+    } else {
+      uint64_t width = score_bucket_floor(bucket + 1) - floor;
+      position += uint64_t(double(within) * (score - floor) / width);
+    }
+
+  }
+
+  // rank of a score within its index, on the same spline as ranking the sorted table,
+  // reading only the histogram (and the exact counts if the index keeps them)
+  uint64_t score_bucket_rank(const name & code, const name & index, uint64_t score, bool exact_counts = false) {
+
+    uint64_t position = 0;
+    uint64_t total = 0;
+    score_bucket_position(code, index, score, exact_counts, position, total);
+
+    if (total == 0) return 0;
+
+    return spline_rank(position, total);
+
+  }
+
+  inline double voice_decay_multiplier(uint64_t percentage_decay) {
+    check(percentage_decay <= 100, "Voice decay parameter can not be more than 100%.");
+    return (100.0 - (double)percentage_decay) / 100.0;
+  }
+
+  // log of a decay multiplier, a 100% decay is kept finite so cumulative sums can be subtracted
+  inline double decay_log(double multiplier) {
+    return std::log(std::max(multiplier, 1e-12));
+  }
+
+  // records the rate of a new decay epoch, called when the epoch starts
+  void record_decay_rate(const name & code, uint64_t epoch, uint64_t percentage_decay) {
+
+    DEFINE_DECAY_RATE_TABLE
+    DEFINE_DECAY_RATE_TABLE_MULTI_INDEX
+
+    decay_rate_tables rates(code, code.value);
+    double multiplier = voice_decay_multiplier(percentage_decay);
+
+    // epochs since the last recorded one (or all of them, for the first row) decay at this rate
+    double cumulative = 0;
+    uint64_t last_epoch = 0;
+    auto litr = rates.lower_bound(epoch);
+    if (litr != rates.begin()) {
+      litr--;
+      cumulative = litr->cumulative;
+      last_epoch = litr->epoch;
+    }
+    cumulative += (epoch - last_epoch) * decay_log(multiplier);
+
+    auto ritr = rates.find(epoch);
+    if (ritr == rates.end()) {
+      rates.emplace(code, [&](auto & item){
+        item.epoch = epoch;
+        item.multiplier = multiplier;
+        item.cumulative = cumulative;
+      });
+    } else {
+      rates.modify(ritr, code, [&](auto & item){
+        item.multiplier = multiplier;
+        item.cumulative = cumulative;
+      });
+    }
+
+  }
+
+  // combined multiplier of the decay epochs in (from_epoch, to_epoch], using the rate
+  // recorded for each epoch; epochs after the last recorded one use the fallback.
+  // Reads at most two rows whatever the number of epochs.
+  double decay_multiplier_between(const name & code, uint64_t from_epoch, uint64_t to_epoch, double fallback_multiplier) {
+
+    if (to_epoch <= from_epoch) { return 1.0; }
+
+    DEFINE_DECAY_RATE_TABLE
+    DEFINE_DECAY_RATE_TABLE_MULTI_INDEX
+
+    decay_rate_tables rates(code, code.value);
+
+    auto cumulative_at = [&](uint64_t epoch) -> double {
+      if (epoch == 0) { return 0; }
+      auto ritr = rates.lower_bound(epoch);
+      if (ritr != rates.end() && ritr->epoch == epoch) { return ritr->cumulative; }
+      if (ritr != rates.begin()) {
+        ritr--;
+        return ritr->cumulative + (epoch - ritr->epoch) * decay_log(fallback_multiplier);
+      }
+      // before the first recorded epoch, which carries these epochs at its own rate
+      return epoch * decay_log(ritr != rates.end() ? ritr->multiplier : fallback_multiplier);
+    };
+
+    // exp of a log sum can land a hair below the exact product, which would truncate
+    // whole balances down by one
+    double multiplier = std::exp(cumulative_at(to_epoch) - cumulative_at(from_epoch)) * (1.0 + 1e-12);
+    return std::min(multiplier, 1.0);
+
+  }
+
+  // balance of a voice row brought forward to the given decay epoch
+  template <typename Voice>
+  uint64_t decayed_voice_balance(const name & code, const Voice & voice, uint64_t epoch, double fallback_multiplier) {
+    uint64_t row_epoch = voice.decay_epoch.value_or(0);
+    if (row_epoch >= epoch) { return voice.balance; }
+    return voice.balance * decay_multiplier_between(code, row_epoch, epoch, fallback_multiplier);
+  }
+
+  template <typename Voice>
+  void stamp_voice(Voice & voice, uint64_t balance, uint64_t epoch) {
+    voice.balance = balance;
+    // rows written before the first decay keep their original layout
+    if (epoch > 0) {
+      voice.decay_epoch = epoch;
+    }
+  }
+
   inline bool is_valid_majority(uint64_t favour, uint64_t against, uint64_t majority) {
     return favour >= (favour + against) * majority / 100;
   }
@@ -180,23 +407,56 @@ namespace utils {
     return rep_score * 2.0 / 99.0; 
   }
 
-  double get_rep_multiplier(name account) {
-
-    DEFINE_REP_TABLE
-    DEFINE_REP_TABLE_MULTI_INDEX
+  struct user_core {
+    bool exists = false;
+    name status;
+    name type;
+  };
+
+  // reads status and type from the compact usercore row, falling back to the
+  // full users row for accounts that have not been migrated yet
+  user_core get_user_core(name account) {
+    DEFINE_USER_CORE_TABLE
+    DEFINE_USER_CORE_TABLE_MULTI_INDEX
+
+    user_core result;
+
+    user_core_tables usercore(contracts::accounts, contracts::accounts.value);
+    auto citr = usercore.find(account.value);
+    if (citr != usercore.end()) {
+      result.exists = true;
+      result.status = citr->status;
+      result.type = citr->type;
+      return result;
+    }
 
     DEFINE_USER_TABLE
     DEFINE_USER_TABLE_MULTI_INDEX
 
     user_tables users(contracts::accounts, contracts::accounts.value);
     auto uitr = users.find(account.value);
+    if (uitr != users.end()) {
+      result.exists = true;
+      result.status = uitr->status;
+      result.type = uitr->type;
+    }
+
+    return result;
+  }
+
+  double get_rep_multiplier(name account) {
+
+    DEFINE_REP_TABLE
+    DEFINE_REP_TABLE_MULTI_INDEX
+
+    user_core user = get_user_core(account);
     name scope;
 
-    if (uitr == users.end()) { return 0; }
+    if (!user.exists) { return 0; }
 
-    if (uitr->type == "individual"_n) {
+    if (user.type == "individual"_n) {
       scope = contracts::accounts;
-    } else if (uitr->type == "organisation"_n) {
+    } else if (user.type == "organisation"_n) {
       scope = "org"_n;
     }
     
@@ -273,6 +533,20 @@ namespace utils {
 
   }
 
+  // tells the scheduler that the chunked run of the op it dispatched has finished,
+  // so ops depending on it can start. op_id is the id the scheduler passed in with
+  // the action, it is absent when the action runs by hand and then nothing is sent
+  inline void send_op_done (const name & code, const eosio::binary_extension<name> & op_id) {
+    if (!op_id.has_value() || op_id.value() == name()) return;
+
+    action(
+      permission_level(code, "active"_n),
+      contracts::scheduler,
+      "opdone"_n,
+      std::make_tuple(op_id.value())
+    ).send();
+  }
+
 
 }
 
@@ -567,6 +567,9 @@ var permissions = [{
 }, {
   target: `${accounts.harvest.account}@execute`,
   action: 'rankcss'
+}, {
+  target: `${accounts.harvest.account}@execute`,
+  action: 'rankscores'
 }, {
   target: `${accounts.harvest.account}@execute`,
   action: 'calctrxpts'
@@ -779,6 +782,9 @@ var permissions = [{
 }, {
   target: `${accounts.history.account}@execute`,
   action: 'cleanptrxs'
+}, {
+  target: `${accounts.history.account}@execute`,
+  action: 'expiretrx'
 }, {
   target: `${accounts.dao.account}@active`,
   actor: `${accounts.dao.account}@eosio.code`
@@ -1,4 +1,5 @@
 #include <eosio/crypto.hpp>
+#include <eosio/datastream.hpp>
 
 #include <map>
 
@@ -32,7 +33,12 @@ namespace hypha
     {
     }
 
-    Document::Document(eosio::name contract, const eosio::checksum256 &_hash) : contract{contract}
+    Document::Document(eosio::name contract, const eosio::checksum256 &_hash)
+        : Document(contract, _hash, false)
+    {
+    }
+
+    Document::Document(eosio::name contract, const eosio::checksum256 &_hash, bool verify) : contract{contract}
     {
         document_table d_t(contract, contract.value);
         auto hash_index = d_t.get_index<eosio::name("idhash")>();
@@ -40,14 +46,18 @@ namespace hypha
         eosio::check(h_itr != hash_index.end(), "document not found: " + readableHash(_hash));
 
         id = h_itr->id;
+        hash = h_itr->hash;
         creator = h_itr->creator;
         created_date = h_itr->created_date;
         certificates = h_itr->certificates;
         content_groups = h_itr->content_groups;
-        hashContents();
 
-        // this should never happen, only if hash algorithm somehow changed
-        eosio::check(hash == _hash, "fatal error: provided and indexed hash does not match newly generated hash");
+        if (verify)
+        {
+            // this should never happen, only if hash algorithm somehow changed
+            eosio::check(hashContents(content_groups) == _hash || hashContentsLegacy(content_groups) == _hash,
+                         "fatal error: provided and indexed hash does not match newly generated hash");
+        }
     }
 
     bool Document::exists(eosio::name contract, const eosio::checksum256 &_hash)
@@ -81,7 +91,7 @@ namespace hypha
         });
     }
 
-    Document Document::getOrNew(eosio::name _contract, eosio::name _creator, ContentGroups contentGroups)
+    Document Document::getOrNew(eosio::name _contract, eosio::name _creator, ContentGroups contentGroups, bool matchLegacy)
     {
         Document document{};
         document.content_groups = contentGroups;
@@ -91,9 +101,16 @@ namespace hypha
         auto hash_index = d_t.get_index<eosio::name("idhash")>();
         auto h_itr = hash_index.find(document.hash);
 
+        // the same content may have been saved before binary hashing
+        if (h_itr == hash_index.end() && matchLegacy)
+        {
+            h_itr = hash_index.find(hashContentsLegacy(contentGroups));
+        }
+
         // if this content exists already, return this one
         if (h_itr != hash_index.end())
         {
+            document.hash = h_itr->hash;
             document.contract = _contract;
             document.creator = h_itr->creator;
             document.created_date = h_itr->created_date;
@@ -105,19 +122,19 @@ namespace hypha
         return Document(_contract, _creator, contentGroups);
     }
 
-    Document Document::getOrNew(eosio::name contract, eosio::name creator, ContentGroup contentGroup)
+    Document Document::getOrNew(eosio::name contract, eosio::name creator, ContentGroup contentGroup, bool matchLegacy)
     {
-        return getOrNew(contract, creator, rollup(contentGroup));
+        return getOrNew(contract, creator, rollup(contentGroup), matchLegacy);
     }
 
-    Document Document::getOrNew(eosio::name contract, eosio::name creator, Content content)
+    Document Document::getOrNew(eosio::name contract, eosio::name creator, Content content, bool matchLegacy)
     {
-        return getOrNew(contract, creator, rollup(content));
+        return getOrNew(contract, creator, rollup(content), matchLegacy);
     }
 
-    Document Document::getOrNew(eosio::name contract, eosio::name creator, const std::string &label, const Content::FlexValue &value)
+    Document Document::getOrNew(eosio::name contract, eosio::name creator, const std::string &label, const Content::FlexValue &value, bool matchLegacy)
     {
-        return getOrNew(contract, creator, rollup(Content(label, value)));
+        return getOrNew(contract, creator, rollup(Content(label, value)), matchLegacy);
     }
 
     // void Document::certify(const eosio::name &certifier, const std::string &notes)
@@ -149,6 +166,12 @@ namespace hypha
 
     // static version cannot cache the hash in a member
     const eosio::checksum256 Document::hashContents(const ContentGroups &contentGroups)
+    {
+        std::vector<char> packed = eosio::pack(contentGroups);
+        return eosio::sha256(packed.data(), packed.size());
+    }
+
+    const eosio::checksum256 Document::hashContentsLegacy(const ContentGroups &contentGroups)
     {
         std::string string_data = toString(contentGroups);
         return eosio::sha256(const_cast<char *>(string_data.c_str()), string_data.length());
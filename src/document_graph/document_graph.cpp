@@ -7,19 +7,10 @@ namespace hypha
     std::vector<Edge> DocumentGraph::getEdges(const eosio::checksum256 &fromNode, const eosio::checksum256 &toNode)
     {
         std::vector<Edge> edges;
-
-        // this index uniquely identifies all edges that share this fromNode and toNode
-        uint64_t index = concatHash(fromNode, toNode);
-        Edge::edge_table e_t(m_contract, m_contract.value);
-        auto from_name_index = e_t.get_index<eosio::name("byfromto")>();
-        auto itr = from_name_index.find(index);
-
-        while (itr != from_name_index.end() && itr->by_from_node_to_node_index() == index)
-        {
-            edges.push_back(*itr);
-            itr++;
-        }
-
+        forEachEdge(fromNode, toNode, [&](const Edge &edge) {
+            edges.push_back(edge);
+            return true;
+        });
         return edges;
     }
 
@@ -33,19 +24,10 @@ namespace hypha
     std::vector<Edge> DocumentGraph::getEdgesFrom(const eosio::checksum256 &fromNode, const eosio::name &edgeName)
     {
         std::vector<Edge> edges;
-
-        // this index uniquely identifies all edges that share this fromNode and edgeName
-        uint64_t index = concatHash(fromNode, edgeName);
-        Edge::edge_table e_t(m_contract, m_contract.value);
-        auto from_name_index = e_t.get_index<eosio::name("byfromname")>();
-        auto itr = from_name_index.find(index);
-
-        while (itr != from_name_index.end() && itr->by_from_node_edge_name_index() == index)
-        {
-            edges.push_back(*itr);
-            itr++;
-        }
-
+        forEachEdgeFrom(fromNode, edgeName, [&](const Edge &edge) {
+            edges.push_back(edge);
+            return true;
+        });
         return edges;
     }
 
@@ -59,19 +41,10 @@ namespace hypha
     std::vector<Edge> DocumentGraph::getEdgesTo(const eosio::checksum256 &toNode, const eosio::name &edgeName)
     {
         std::vector<Edge> edges;
-
-        // this index uniquely identifies all edges that share this toNode and edgeName
-        uint64_t index = concatHash(toNode, edgeName);
-        Edge::edge_table e_t(m_contract, m_contract.value);
-        auto from_name_index = e_t.get_index<eosio::name("bytoname")>();
-        auto itr = from_name_index.find(index);
-
-        while (itr != from_name_index.end() && itr->by_to_node_edge_name_index() == index)
-        {
-            edges.push_back(*itr);
-            itr++;
-        }
-
+        forEachEdgeTo(toNode, edgeName, [&](const Edge &edge) {
+            edges.push_back(edge);
+            return true;
+        });
         return edges;
     }
 
@@ -82,6 +55,42 @@ namespace hypha
         return edges;
     }
 
+    bool DocumentGraph::hasEdgeFrom(const eosio::checksum256 &fromNode, const eosio::name &edgeName)
+    {
+        bool found = false;
+        forEachEdgeFrom(fromNode, edgeName, [&](const Edge &edge) {
+            found = true;
+            return false;
+        });
+        return found;
+    }
+
+    uint64_t DocumentGraph::reindexEdges(uint64_t start, uint64_t chunksize)
+    {
+        Edge::edge_table e_t(m_contract, m_contract.value);
+        auto itr = e_t.lower_bound(start);
+        uint64_t count = 0;
+
+        while (itr != e_t.end() && count < chunksize)
+        {
+            Edge edge = *itr;
+            itr = e_t.erase(itr);
+            e_t.emplace(m_contract, [&](auto &e) {
+                e = edge;
+            });
+            count++;
+        }
+
+        if (itr == e_t.end())
+        {
+            Edge::setKeysReady(m_contract, true);
+            m_keysReady = 1;
+            return 0;
+        }
+
+        return itr->id;
+    }
+
     // since we are removing multiple edges here, we do not call erase on each edge, which
     // would instantiate the table on each call.  This is faster execution.
     void DocumentGraph::removeEdges(const eosio::checksum256 &node)
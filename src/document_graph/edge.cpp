@@ -1,4 +1,5 @@
 #include <document_graph/document.hpp>
+#include <document_graph/document_graph.hpp>
 #include <document_graph/edge.hpp>
 #include <document_graph/util.hpp>
 
@@ -76,14 +77,11 @@ namespace hypha
                    const eosio::checksum256 &_from_node,
                    const eosio::name &_edge_name)
     {
-        edge_table e_t(_contract, _contract.value);
-        auto fromEdgeIndex = e_t.get_index<eosio::name("byfromname")>();
-        auto index = concatHash(_from_node, _edge_name);
-        auto itr = fromEdgeIndex.find(index);
+        std::pair<bool, Edge> p = getIfExists(_contract, _from_node, _edge_name);
 
-        eosio::check(itr != fromEdgeIndex.end() && itr->from_node_edge_name_index == index, "edge does not exist: from " + readableHash(_from_node) + " with edge name of " + _edge_name.to_string());
+        eosio::check(p.first, "edge does not exist: from " + readableHash(_from_node) + " with edge name of " + _edge_name.to_string());
 
-        return *itr;
+        return p.second;
     }
 
     // static getter
@@ -91,15 +89,7 @@ namespace hypha
                       const eosio::checksum256 &_from_node,
                       const eosio::name &_edge_name)
     {
-        edge_table e_t(_contract, _contract.value);
-        auto fromEdgeIndex = e_t.get_index<eosio::name("byfromname")>();
-        auto index = concatHash(_from_node, _edge_name);
-        std::vector<Edge> edges;
-        for (auto itr = fromEdgeIndex.find(index); itr != fromEdgeIndex.end(); ++itr) {
-            edges.push_back(*itr);
-        }
-
-        return edges;
+        return DocumentGraph(_contract).getEdgesFrom(_from_node, _edge_name);
     }
 
     // static getter
@@ -107,17 +97,29 @@ namespace hypha
                                             const eosio::checksum256 &_from_node,
                                             const eosio::name &_edge_name)
     {
-        edge_table e_t(_contract, _contract.value);
-        auto fromEdgeIndex = e_t.get_index<eosio::name("byfromname")>();
-        auto index = concatHash(_from_node, _edge_name);
-        auto itr = fromEdgeIndex.find(index);
+        std::pair<bool, Edge> p(false, Edge{});
+        DocumentGraph(_contract).forEachEdgeFrom(_from_node, _edge_name, [&](const Edge &edge) {
+            p = std::pair<bool, Edge>(true, edge);
+            return false;
+        });
 
-        if (itr != fromEdgeIndex.end() && itr->from_node_edge_name_index == index)
-        {
-            return std::pair<bool, Edge> (true, *itr);
-        }
+        return p;
+    }
+
+    // static
+    bool Edge::keysReady(const eosio::name &_contract)
+    {
+        EdgeKeys::edge_keys_table k_t(_contract, _contract.value);
+        return k_t.get_or_default(EdgeKeys{}).ready;
+    }
 
-        return std::pair<bool, Edge>(false, Edge{});
+    // static
+    void Edge::setKeysReady(const eosio::name &_contract, bool ready)
+    {
+        EdgeKeys::edge_keys_table k_t(_contract, _contract.value);
+        EdgeKeys keys;
+        keys.ready = ready;
+        k_t.set(keys, _contract);
     }
 
     // static getter
@@ -167,4 +169,26 @@ namespace hypha
 
     eosio::checksum256 Edge::by_from() const { return from_node; }
     eosio::checksum256 Edge::by_to() const { return to_node; }
+    uint128_t Edge::by_from_name_key() const { return nodeKey(from_node, edge_name.value); }
+    uint128_t Edge::by_from_to_key() const { return nodeKey(from_node, nodePrefix(to_node)); }
+    uint128_t Edge::by_to_name_key() const { return nodeKey(to_node, edge_name.value); }
+
+    // static
+    uint64_t Edge::nodePrefix(const eosio::checksum256 &node)
+    {
+        auto bytes = node.extract_as_byte_array();
+        uint64_t prefix = 0;
+        for (int i = 0; i < 8; i++)
+        {
+            prefix <<= 8;
+            prefix |= bytes[i];
+        }
+        return prefix;
+    }
+
+    // static
+    uint128_t Edge::nodeKey(const eosio::checksum256 &node, uint64_t low)
+    {
+        return (uint128_t(nodePrefix(node)) << 64) + low;
+    }
 } // namespace hypha
\ No newline at end of file
@@ -1,14 +1,14 @@
 #include <proposals/proposal_alliance.hpp>
 
 
-void ProposalAlliance::create_impl (std::map<std::string, VariantValue> & args) {
+void ProposalAlliance::create_impl (ProposalArgs & args) {
 
   dao::proposal_auxiliary_tables propaux_t(contract_name, contract_name.value);
   dao::user_tables users_t(contracts::accounts, contracts::accounts.value);
 
-  name creator = std::get<name>(args["creator"]);
-  name recipient = std::get<name>(args["recipient"]);
-  name fund_type = this->m_contract.get_fund_type(std::get<name>(args["fund"]));
+  name creator = args.creator;
+  name recipient = args.recipient;
+  name fund_type = this->m_contract.get_fund_type(args.fund);
   check(fund_type == this->m_contract.alliance_fund, "fund must be of type: " + this->m_contract.alliance_fund.to_string());
 
   check(is_account(recipient), "recipient is not a valid account: " + recipient.to_string());
@@ -21,7 +21,7 @@ void ProposalAlliance::create_impl (std::map<std::string, VariantValue> & args)
     "user is not a resident or citizen or an organization with alliance proposal");
 
   propaux_t.emplace(contract_name, [&](auto & item){
-    item.proposal_id = std::get<uint64_t>(args["proposal_id"]);
+    item.proposal_id = args.proposal_id;
     item.special_attributes.insert(std::make_pair("current_payout", asset(0, utils::seeds_symbol)));
     item.special_attributes.insert(std::make_pair("passed_cycle", uint64_t(0)));
     item.special_attributes.insert(std::make_pair("recipient", recipient));
@@ -31,13 +31,13 @@ void ProposalAlliance::create_impl (std::map<std::string, VariantValue> & args)
 
 }
 
-void ProposalAlliance::status_open_impl(std::map<std::string, VariantValue> & args) {
+void ProposalAlliance::status_open_impl(ProposalArgs & args) {
 
   dao::proposal_tables proposals_t(contract_name, contract_name.value);
   dao::proposal_auxiliary_tables propaux_t(contract_name, contract_name.value);
 
-  uint64_t proposal_id = std::get<uint64_t>(args["proposal_id"]);
-  uint64_t propcycle = std::get<uint64_t>(args["propcycle"]);  
+  uint64_t proposal_id = args.proposal_id;
+  uint64_t propcycle = args.propcycle;  
 
   auto pitr = proposals_t.require_find(proposal_id, "proposal not found");
   auto paitr = propaux_t.require_find(proposal_id, "proposal aux entry not found");
@@ -91,12 +91,12 @@ void ProposalAlliance::status_open_impl(std::map<std::string, VariantValue> & ar
 }
 
 
-void ProposalAlliance::status_eval_impl(std::map<std::string, VariantValue> & args) {
+void ProposalAlliance::status_eval_impl(ProposalArgs & args) {
 
   dao::proposal_tables proposals_t(contract_name, contract_name.value);
 
-  uint64_t proposal_id = std::get<uint64_t>(args["proposal_id"]);
-  uint64_t propcycle = std::get<uint64_t>(args["propcycle"]);
+  uint64_t proposal_id = args.proposal_id;
+  uint64_t propcycle = args.propcycle;
 
   auto pitr = proposals_t.require_find(proposal_id, "proposal not found");
 
@@ -111,9 +111,9 @@ void ProposalAlliance::status_eval_impl(std::map<std::string, VariantValue> & ar
 
 }
 
-void ProposalAlliance::status_rejected_impl(std::map<std::string, VariantValue> & args) {
+void ProposalAlliance::status_rejected_impl(ProposalArgs & args) {
 
-  uint64_t proposal_id = std::get<uint64_t>(args["proposal_id"]);
+  uint64_t proposal_id = args.proposal_id;
   
   dao::proposal_tables proposals_t(contract_name, contract_name.value);
   dao::proposal_auxiliary_tables propaux_t(contract_name, contract_name.value);
@@ -137,21 +137,19 @@ void ProposalAlliance::status_rejected_impl(std::map<std::string, VariantValue>
 
 }
 
-void ProposalAlliance::callback (std::map<std::string, VariantValue> & args) {
+void ProposalAlliance::callback (ProposalArgs & args) {
   
-  uint64_t proposal_id = std::get<uint64_t>(args["proposal_id"]);
+  uint64_t proposal_id = args.proposal_id;
 
   dao::proposal_auxiliary_tables propaux_t(contract_name, contract_name.value);
   auto paitr = propaux_t.require_find(proposal_id, "proposal not found");
 
-  auto action_itr = args.find("action");
-  if (action_itr != args.end()) {
+  if (args.has(ProposalArgs::f_action)) {
 
     dao::proposal_tables proposals_t(contract_name, contract_name.value);
     auto pitr = proposals_t.require_find(proposal_id, "proposal not found");
 
-    std::map<std::string, VariantValue> propm = { { "favour", pitr->favour }, { "against", pitr->against } };
-    check(check_prop_majority(propm), "proposal is not passing, lock can not be claimed");
+    check(check_prop_majority(pitr->favour, pitr->against), "proposal is not passing, lock can not be claimed");
 
     proposals_t.modify(pitr, contract_name, [&](auto & item){
       item.status = ProposalsCommon::status_passed;
@@ -164,7 +162,7 @@ void ProposalAlliance::callback (std::map<std::string, VariantValue> & args) {
 
   } else {
     propaux_t.modify(paitr, contract_name, [&](auto & propaux){
-      propaux.special_attributes.at("lock_id") = std::get<uint64_t>(args["lock_id"]);
+      propaux.special_attributes.at("lock_id") = args.lock_id;
     });
   }
 
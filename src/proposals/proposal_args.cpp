@@ -0,0 +1,63 @@
+#include <proposals/proposal_args.hpp>
+
+
+template <typename T>
+void read_proposal_arg (const string & key, const VariantValue & value, T & field) {
+  check(std::holds_alternative<T>(value), "proposal argument " + key + " has the wrong type");
+  field = std::get<T>(value);
+}
+
+ProposalArgs ProposalArgs::from_map (const std::map<std::string, VariantValue> & args) {
+
+  ProposalArgs pargs;
+
+  for (const auto & [key, value] : args) {
+    for (const auto & descriptor : proposal_arg_descriptors) {
+      if (descriptor.key == key) {
+        pargs.set(descriptor.id, key, value);
+        break;
+      }
+    }
+  }
+
+  return pargs;
+
+}
+
+void ProposalArgs::set (field f, const string & key, const VariantValue & value) {
+
+  switch (f) {
+    case f_proposal_id: read_proposal_arg(key, value, proposal_id); break;
+    case f_propcycle: read_proposal_arg(key, value, propcycle); break;
+    case f_creator: read_proposal_arg(key, value, creator); break;
+    case f_type: read_proposal_arg(key, value, type); break;
+    case f_fund: read_proposal_arg(key, value, fund); break;
+    case f_recipient: read_proposal_arg(key, value, recipient); break;
+    case f_setting_name: read_proposal_arg(key, value, setting_name); break;
+    case f_reward_owner: read_proposal_arg(key, value, reward_owner); break;
+    case f_action: read_proposal_arg(key, value, action); break;
+    case f_title: read_proposal_arg(key, value, title); break;
+    case f_summary: read_proposal_arg(key, value, summary); break;
+    case f_description: read_proposal_arg(key, value, description); break;
+    case f_image: read_proposal_arg(key, value, image); break;
+    case f_url: read_proposal_arg(key, value, url); break;
+    case f_pay_percentages: {
+      string percentages;
+      read_proposal_arg(key, value, percentages);
+      pay_percentages = percentages;
+      break;
+    }
+    case f_quantity: read_proposal_arg(key, value, quantity); break;
+    case f_planted: read_proposal_arg(key, value, planted); break;
+    case f_reward: read_proposal_arg(key, value, reward); break;
+    case f_max_amount_per_invite: read_proposal_arg(key, value, max_amount_per_invite); break;
+    case f_test_cycles: read_proposal_arg(key, value, test_cycles); break;
+    case f_eval_cycles: read_proposal_arg(key, value, eval_cycles); break;
+    case f_campaign_id: read_proposal_arg(key, value, campaign_id); break;
+    case f_lock_id: read_proposal_arg(key, value, lock_id); break;
+    case f_new_value: new_value = value; break;
+  }
+
+  present |= uint32_t(1) << f;
+
+}
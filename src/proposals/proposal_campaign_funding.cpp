@@ -1,33 +1,32 @@
 #include <proposals/proposal_campaign_funding.hpp>
 
 
-void ProposalCampaignFunding::create_impl (std::map<std::string, VariantValue> & args) {
+void ProposalCampaignFunding::create_impl (ProposalArgs & args) {
 
   dao::proposal_auxiliary_tables propaux_t(contract_name, contract_name.value);
 
-  asset quantity = std::get<asset>(args["quantity"]);
+  asset quantity = args.quantity;
   utils::check_asset(quantity);
   check(quantity.amount > 0, "quantity amount must be greater than zero");
 
-  name creator = std::get<name>(args["creator"]);
+  name creator = args.creator;
   this->m_contract.check_citizen(creator);
 
-  name fund_type = this->m_contract.get_fund_type(std::get<name>(args["fund"]));
+  name fund_type = this->m_contract.get_fund_type(args.fund);
   check(fund_type == this->m_contract.campaign_fund, "fund must be of type: " + this->m_contract.campaign_fund.to_string());
 
-  name recipient = std::get<name>(args["recipient"]);
+  name recipient = args.recipient;
   check(is_account(recipient), "recipient is not a valid account: " + recipient.to_string());
 
   string pay_percentages = "25,25,25,25";
 
-  auto pay_percentages_itr = args.find("pay_percentages");
-  if (pay_percentages_itr != args.end()) {
-    pay_percentages = std::get<string>(pay_percentages_itr->second);
+  if (args.pay_percentages) {
+    pay_percentages = *args.pay_percentages;
     check_percentages(*(values_to_vector(pay_percentages)));
   }
 
   propaux_t.emplace(contract_name, [&](auto & item){
-    item.proposal_id = std::get<uint64_t>(args["proposal_id"]);
+    item.proposal_id = args.proposal_id;
     item.special_attributes.insert(std::make_pair("pay_percentages", pay_percentages));
     item.special_attributes.insert(std::make_pair("recipient", recipient));
     item.special_attributes.insert(std::make_pair("current_payout", asset(0, utils::seeds_symbol)));
@@ -37,18 +36,17 @@ void ProposalCampaignFunding::create_impl (std::map<std::string, VariantValue> &
 
 }
 
-void ProposalCampaignFunding::update_impl (std::map<std::string, VariantValue> & args) {
+void ProposalCampaignFunding::update_impl (ProposalArgs & args) {
 
-  uint64_t proposal_id = std::get<uint64_t>(args["proposal_id"]);
+  uint64_t proposal_id = args.proposal_id;
 
   dao::proposal_auxiliary_tables propaux_t(contract_name, contract_name.value);
   auto paitr = propaux_t.require_find(proposal_id, "proposal aux entry not found");
   
   string pay_percentages = "25,25,25,25";
 
-  auto pay_percentages_itr = args.find("pay_percentages");
-  if (pay_percentages_itr != args.end()) {
-    pay_percentages = std::get<string>(pay_percentages_itr->second);
+  if (args.pay_percentages) {
+    pay_percentages = *args.pay_percentages;
     check_percentages(*(values_to_vector(pay_percentages)));
   }
 
@@ -58,13 +56,13 @@ void ProposalCampaignFunding::update_impl (std::map<std::string, VariantValue> &
 
 }
 
-void ProposalCampaignFunding::status_open_impl (std::map<std::string, VariantValue> & args) {
+void ProposalCampaignFunding::status_open_impl (ProposalArgs & args) {
 
   dao::proposal_tables proposals_t(contract_name, contract_name.value);
   dao::proposal_auxiliary_tables propaux_t(contract_name, contract_name.value);
 
-  uint64_t proposal_id = std::get<uint64_t>(args["proposal_id"]);
-  uint64_t propcycle = std::get<uint64_t>(args["propcycle"]);  
+  uint64_t proposal_id = args.proposal_id;
+  uint64_t propcycle = args.propcycle;  
 
   auto pitr = proposals_t.require_find(proposal_id, "proposal not found");
   auto paitr = propaux_t.require_find(proposal_id, "proposal aux entry not found");
@@ -99,13 +97,13 @@ void ProposalCampaignFunding::status_open_impl (std::map<std::string, VariantVal
 
 }
 
-void ProposalCampaignFunding::status_eval_impl (std::map<std::string, VariantValue> & args) {
+void ProposalCampaignFunding::status_eval_impl (ProposalArgs & args) {
 
   dao::proposal_tables proposals_t(contract_name, contract_name.value);
   dao::proposal_auxiliary_tables propaux_t(contract_name, contract_name.value);
 
-  uint64_t proposal_id = std::get<uint64_t>(args["proposal_id"]);
-  uint64_t propcycle = std::get<uint64_t>(args["propcycle"]);
+  uint64_t proposal_id = args.proposal_id;
+  uint64_t propcycle = args.propcycle;
 
   auto pitr = proposals_t.require_find(proposal_id, "proposal not found");
   auto paitr = propaux_t.require_find(proposal_id, "proposal aux entry not found");
@@ -1,20 +1,20 @@
 #include <proposals/proposal_campaign_invite.hpp>
 #include <eosio/system.hpp>
 
-void ProposalCampaignInvite::create_impl (std::map<std::string, VariantValue> & args) {
+void ProposalCampaignInvite::create_impl (ProposalArgs & args) {
 
-  asset max_amount_per_invite = std::get<asset>(args["max_amount_per_invite"]);
-  asset planted = std::get<asset>(args["planted"]);
-  asset reward = std::get<asset>(args["reward"]);
+  asset max_amount_per_invite = args.max_amount_per_invite;
+  asset planted = args.planted;
+  asset reward = args.reward;
 
   utils::check_asset(max_amount_per_invite);
   utils::check_asset(planted);
   utils::check_asset(reward);
 
-  name reward_owner = std::get<name>(args["reward_owner"]);
+  name reward_owner = args.reward_owner;
   check(is_account(reward_owner), "reward_owner is not a valid account: " + reward_owner.to_string());
 
-  name fund_type = this->m_contract.get_fund_type(std::get<name>(args["fund"]));
+  name fund_type = this->m_contract.get_fund_type(args.fund);
   check(fund_type == this->m_contract.campaign_fund, "fund must be of type: " + this->m_contract.campaign_fund.to_string());
 
   uint64_t min_planted = this->m_contract.config_get("inv.min.plnt"_n);
@@ -26,7 +26,7 @@ void ProposalCampaignInvite::create_impl (std::map<std::string, VariantValue> &
   dao::proposal_auxiliary_tables propaux_t(contract_name, contract_name.value);
 
   propaux_t.emplace(contract_name, [&](auto & item) {
-    item.proposal_id = std::get<uint64_t>(args["proposal_id"]);
+    item.proposal_id = args.proposal_id;
     item.special_attributes.insert(std::make_pair("current_payout", asset(0, utils::seeds_symbol)));
     item.special_attributes.insert(std::make_pair("passed_cycle", uint64_t(0)));
     item.special_attributes.insert(std::make_pair("max_age", uint64_t(6)));
@@ -39,13 +39,13 @@ void ProposalCampaignInvite::create_impl (std::map<std::string, VariantValue> &
 
 }
 
-void ProposalCampaignInvite::status_open_impl(std::map<std::string, VariantValue> & args) {
+void ProposalCampaignInvite::status_open_impl(ProposalArgs & args) {
 
   dao::proposal_tables proposals_t(contract_name, contract_name.value);
   dao::proposal_auxiliary_tables propaux_t(contract_name, contract_name.value);
 
-  uint64_t proposal_id = std::get<uint64_t>(args["proposal_id"]);
-  uint64_t propcycle = std::get<uint64_t>(args["propcycle"]);
+  uint64_t proposal_id = args.proposal_id;
+  uint64_t propcycle = args.propcycle;
 
   auto pitr = proposals_t.require_find(proposal_id, "proposal not found");
   auto paitr = propaux_t.require_find(proposal_id, "proposal aux entry not found");
@@ -106,12 +106,12 @@ void ProposalCampaignInvite::status_open_impl(std::map<std::string, VariantValue
 
 }
 
-void ProposalCampaignInvite::status_eval_impl(std::map<std::string, VariantValue> & args) {
+void ProposalCampaignInvite::status_eval_impl(ProposalArgs & args) {
 
   dao::proposal_tables proposals_t(contract_name, contract_name.value);
   dao::proposal_auxiliary_tables propaux_t(contract_name, contract_name.value);
 
-  uint64_t proposal_id = std::get<uint64_t>(args["proposal_id"]);
+  uint64_t proposal_id = args.proposal_id;
 
   auto pitr = proposals_t.require_find(proposal_id, "proposal not found");
   auto paitr = propaux_t.require_find(proposal_id, "proposal aux entry not found");
@@ -121,7 +121,7 @@ void ProposalCampaignInvite::status_eval_impl(std::map<std::string, VariantValue
   uint64_t max_age = std::get<uint64_t>(paitr->special_attributes.at("max_age"));
   asset current_payout = std::get<asset>(paitr->special_attributes.at("current_payout"));
   asset payout_amount = pitr->quantity;
-  uint64_t propcycle = std::get<uint64_t>(args["propcycle"]);
+  uint64_t propcycle = args.propcycle;
 
   name prop_type = this->m_contract.get_fund_type(pitr->fund);
 
@@ -144,9 +144,9 @@ void ProposalCampaignInvite::status_eval_impl(std::map<std::string, VariantValue
 
 }
 
-void ProposalCampaignInvite::status_rejected_impl(std::map<std::string, VariantValue> & args) {
+void ProposalCampaignInvite::status_rejected_impl(ProposalArgs & args) {
 
-  uint64_t proposal_id = std::get<uint64_t>(args["proposal_id"]);
+  uint64_t proposal_id = args.proposal_id;
   
   dao::proposal_auxiliary_tables propaux_t(contract_name, contract_name.value);
   auto paitr = propaux_t.require_find(proposal_id, "proposal aux entry not found");
@@ -162,14 +162,14 @@ void ProposalCampaignInvite::status_rejected_impl(std::map<std::string, VariantV
 
 }
 
-void ProposalCampaignInvite::callback(std::map<std::string, VariantValue> & args) {
+void ProposalCampaignInvite::callback(ProposalArgs & args) {
 
   dao::proposal_auxiliary_tables propaux_t(contract_name, contract_name.value);
-  uint64_t proposal_id = std::get<uint64_t>(args["proposal_id"]);
+  uint64_t proposal_id = args.proposal_id;
 
   auto paitr = propaux_t.require_find(proposal_id, "proposal aux entry not found");
 
-  uint64_t campaign_id = std::get<uint64_t>(args["campaign_id"]);
+  uint64_t campaign_id = args.campaign_id;
 
   propaux_t.modify(paitr, contract_name, [&](auto & proposal_aux){
     proposal_aux.special_attributes.insert(std::make_pair("campaign_id", campaign_id));
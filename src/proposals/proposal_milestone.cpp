@@ -1,26 +1,26 @@
 #include <proposals/proposal_milestone.hpp>
 
-void ProposalMilestone::create_impl (std::map<std::string, VariantValue> & args) {
+void ProposalMilestone::create_impl (ProposalArgs & args) {
 
   dao::proposal_auxiliary_tables propaux_t(contract_name, contract_name.value);
 
-  asset quantity = std::get<asset>(args["quantity"]);
+  asset quantity = args.quantity;
   utils::check_asset(quantity);
   check(quantity.amount > 0, "quantity amount must be greater than zero");
 
-  name creator = std::get<name>(args["creator"]);
-  name fund_type = this->m_contract.get_fund_type(std::get<name>(args["fund"]));
+  name creator = args.creator;
+  name fund_type = this->m_contract.get_fund_type(args.fund);
   check(fund_type == this->m_contract.milestone_fund, "fund must be of type: " + this->m_contract.milestone_fund.to_string());
 
   this->m_contract.check_citizen(creator);
 
-  name recipient = std::get<name>(args["recipient"]);
+  name recipient = args.recipient;
   check(recipient  == bankaccts::hyphabank, 
     "Hypha milestone proposals must go to " + bankaccts::hyphabank.to_string() + " - wrong recepient" + recipient.to_string());
 
   propaux_t.emplace(contract_name, [&](auto & item){
-    item.proposal_id = std::get<uint64_t>(args["proposal_id"]);
-    item.special_attributes.insert(std::make_pair("recipient", std::get<name>(args["recipient"])));
+    item.proposal_id = args.proposal_id;
+    item.special_attributes.insert(std::make_pair("recipient", args.recipient));
     item.special_attributes.insert(std::make_pair("current_payout", asset(0, utils::seeds_symbol)));
     item.special_attributes.insert(std::make_pair("executed", false));
     item.special_attributes.insert(std::make_pair("passed_cycle", uint64_t(0)));
@@ -28,13 +28,13 @@ void ProposalMilestone::create_impl (std::map<std::string, VariantValue> & args)
 
 }
 
-void ProposalMilestone::status_open_impl(std::map<std::string, VariantValue> & args) {
+void ProposalMilestone::status_open_impl(ProposalArgs & args) {
 
   dao::proposal_tables proposals_t(contract_name, contract_name.value);
   dao::proposal_auxiliary_tables propaux_t(contract_name, contract_name.value);
 
-  uint64_t proposal_id = std::get<uint64_t>(args["proposal_id"]);
-  uint64_t propcycle = std::get<uint64_t>(args["propcycle"]);  
+  uint64_t proposal_id = args.proposal_id;
+  uint64_t propcycle = args.propcycle;  
 
   auto pitr = proposals_t.require_find(proposal_id, "proposal not found");
   auto paitr = propaux_t.require_find(proposal_id, "proposal aux entry not found");
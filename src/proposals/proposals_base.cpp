@@ -1,7 +1,7 @@
 #include <proposals/proposals_base.hpp>
 
 
-void Proposal::create (std::map<std::string, VariantValue> & args) {
+void Proposal::create (ProposalArgs & args) {
 
   dao::proposal_tables proposals_t(contract_name, contract_name.value);
   dao::proposal_auxiliary_tables propaux_t(contract_name, contract_name.value);
@@ -9,9 +9,9 @@ void Proposal::create (std::map<std::string, VariantValue> & args) {
   uint64_t proposal_id = proposals_t.available_primary_key();
   proposal_id = proposal_id > 0 ? proposal_id : 1;
 
-  name creator = std::get<name>(args["creator"]);
-  name fund = std::get<name>(args["fund"]);
-  asset quantity = std::get<asset>(args["quantity"]);
+  name creator = args.creator;
+  name fund = args.fund;
+  asset quantity = args.quantity;
 
   check(is_account(fund), "fund is not a valid account: " + fund.to_string());
 
@@ -21,15 +21,15 @@ void Proposal::create (std::map<std::string, VariantValue> & args) {
     item.against = 0;
     item.staked = asset(0, utils::seeds_symbol);
     item.creator = creator;
-    item.title = std::get<string>(args["title"]);
-    item.summary = std::get<string>(args["summary"]);
-    item.description = std::get<string>(args["description"]);
-    item.image = std::get<string>(args["image"]);
-    item.url = std::get<string>(args["url"]);
+    item.title = args.title;
+    item.summary = args.summary;
+    item.description = args.description;
+    item.image = args.image;
+    item.url = args.url;
     item.created_at = current_time_point();
     item.status = ProposalsCommon::status_open;
     item.stage = ProposalsCommon::stage_staged;
-    item.type = std::get<name>(args["type"]);
+    item.type = args.type;
     item.last_ran_cycle = 0;
     item.age = 0;
     item.fund = fund;
@@ -65,12 +65,12 @@ void Proposal::create (std::map<std::string, VariantValue> & args) {
     });
   }
 
-  args.insert(std::make_tuple("proposal_id", proposal_id));
+  args.proposal_id = proposal_id;
   create_impl(args);
 }
 
-void Proposal::update (std::map<std::string, VariantValue> & args) {
-  uint64_t proposal_id = std::get<uint64_t>(args["proposal_id"]);
+void Proposal::update (ProposalArgs & args) {
+  uint64_t proposal_id = args.proposal_id;
 
   dao::proposal_tables proposals_t(contract_name, contract_name.value);
   auto pitr = proposals_t.require_find(proposal_id, "proposal not found");
@@ -78,19 +78,19 @@ void Proposal::update (std::map<std::string, VariantValue> & args) {
   check(pitr->stage == ProposalsCommon::stage_staged, "can not update proposal, it is not staged");
 
   proposals_t.modify(pitr, contract_name, [&](auto & item) {
-    item.title = std::get<string>(args["title"]);
-    item.summary = std::get<string>(args["summary"]);
-    item.description = std::get<string>(args["description"]);
-    item.image = std::get<string>(args["image"]);
-    item.url = std::get<string>(args["url"]);
+    item.title = args.title;
+    item.summary = args.summary;
+    item.description = args.description;
+    item.image = args.image;
+    item.url = args.url;
   });
 
   update_impl(args);
 }
 
-void Proposal::cancel (std::map<std::string, VariantValue> & args) {
+void Proposal::cancel (ProposalArgs & args) {
 
-  uint64_t proposal_id = std::get<uint64_t>(args["proposal_id"]);
+  uint64_t proposal_id = args.proposal_id;
 
   dao::proposal_tables proposals_t(contract_name, contract_name.value);
   dao::proposal_auxiliary_tables propaux_t(contract_name, contract_name.value);
@@ -119,10 +119,17 @@ void Proposal::cancel (std::map<std::string, VariantValue> & args) {
 
 }
 
-void Proposal::evaluate (std::map<std::string, VariantValue> & args) {
+void Proposal::evaluate (ProposalArgs & args) {
+  evaluate_as(*this, args);
+}
+
+// Derived is the concrete, final proposal type when called from ProposalsFactory::evaluate,
+// so the hooks below resolve at compile time; with Derived = Proposal they go through the vtable.
+template <typename Derived>
+void Proposal::evaluate_as (Derived & self, ProposalArgs & args) {
 
-  uint64_t proposal_id = std::get<uint64_t>(args["proposal_id"]);
-  uint64_t propcycle = std::get<uint64_t>(args["propcycle"]);
+  uint64_t proposal_id = args.proposal_id;
+  uint64_t propcycle = args.propcycle;
 
   dao::proposal_tables proposals_t(contract_name, contract_name.value);
   dao::proposal_auxiliary_tables propaux_t(contract_name, contract_name.value);
@@ -138,20 +145,18 @@ void Proposal::evaluate (std::map<std::string, VariantValue> & args) {
 
   name prop_type = this->m_contract.get_fund_type(pitr->fund);
 
-  dao::support_level_tables support_t(contract_name, prop_type.value);
-  auto citr = support_t.find(propcycle);
+  dao::support_level_table support;
 
-  if (citr !=  support_t.end()) {
-    number_active_proposals = citr->num_proposals;
-    quorum_votes_needed = citr->voice_needed;
+  if (this->m_contract.get_support_level(prop_type, propcycle, support)) {
+    number_active_proposals = support.num_proposals;
+    quorum_votes_needed = support.voice_needed;
   } else {
     number_active_proposals = this->m_contract.get_size(this->m_contract.prop_active_size);
   }
 
   if (current_stage == ProposalsCommon::stage_active) {
 
-    std::map<std::string, VariantValue> propm = { { "favour", pitr->favour }, { "against", pitr->against } };
-    bool passed = check_prop_majority(propm);
+    bool passed = self.check_prop_majority(pitr->favour, pitr->against);
 
     bool valid_quorum = false;
 
@@ -182,10 +187,10 @@ void Proposal::evaluate (std::map<std::string, VariantValue> & args) {
           std::make_tuple(pitr->creator, reward_points)
         );
 
-        status_open_impl(args);
+        self.status_open_impl(args);
 
       } else { // evaluate status
-        status_eval_impl(args);
+        self.status_eval_impl(args);
       }
 
     } else {
@@ -224,7 +229,7 @@ void Proposal::evaluate (std::map<std::string, VariantValue> & args) {
           std::make_tuple(pitr->creator, this->m_contract.config_get("prop.evl.psh"_n))
         );
         
-        status_rejected_impl(args);
+        self.status_rejected_impl(args);
       }
 
       proposals_t.modify(pitr, contract_name, [&](auto& proposal) {
@@ -245,7 +250,7 @@ void Proposal::evaluate (std::map<std::string, VariantValue> & args) {
     this->m_contract.size_change(this->m_contract.prop_active_size, -1);
 
   } else if (current_stage == ProposalsCommon::stage_staged) {
-    uint64_t m_stake = min_stake(pitr->quantity, pitr->fund);
+    uint64_t m_stake = self.min_stake(pitr->quantity, pitr->fund);
 
 
     if (pitr->staked.amount >= m_stake) {
@@ -259,10 +264,10 @@ void Proposal::evaluate (std::map<std::string, VariantValue> & args) {
 
 }
 
-void Proposal::stake (std::map<std::string, VariantValue> & args) {
+void Proposal::stake (ProposalArgs & args) {
 
-  uint64_t proposal_id = std::get<uint64_t>(args["proposal_id"]);
-  asset quantity = std::get<asset>(args["quantity"]);
+  uint64_t proposal_id = args.proposal_id;
+  asset quantity = args.quantity;
 
   dao::proposal_tables proposals_t(contract_name, contract_name.value);
   auto pitr = proposals_t.require_find(proposal_id, "proposal not found");
@@ -329,10 +334,7 @@ uint64_t Proposal::min_stake (const asset & quantity, const name & fund) {
 
 }
 
-bool Proposal::check_prop_majority (std::map<std::string, VariantValue> & args) {
-  uint64_t favour = std::get<uint64_t>(args["favour"]);
-  uint64_t against = std::get<uint64_t>(args["against"]);
-
+bool Proposal::check_prop_majority (const uint64_t & favour, const uint64_t & against) {
   uint64_t prop_majority = this->m_contract.config_get(name("propmajority"));
   double majority = double(prop_majority) / 100.0;
   double fav = double(favour);
@@ -344,16 +346,16 @@ void Proposal::check_can_vote (const name & status, const name & stage) {
   check(stage == ProposalsCommon::stage_active, "can not vote, proposal is not in active stage");
 }
 
-void Proposal::create_impl(std::map<std::string, VariantValue> & args) {}
+void Proposal::create_impl(ProposalArgs & args) {}
 
-void Proposal::update_impl(std::map<std::string, VariantValue> & args) {}
+void Proposal::update_impl(ProposalArgs & args) {}
 
-void Proposal::cancel_impl(std::map<std::string, VariantValue> & args) {}
+void Proposal::cancel_impl(ProposalArgs & args) {}
 
-void Proposal::status_open_impl (std::map<std::string, VariantValue> & args) {}
+void Proposal::status_open_impl (ProposalArgs & args) {}
 
-void Proposal::status_eval_impl (std::map<std::string, VariantValue> & args) {}
+void Proposal::status_eval_impl (ProposalArgs & args) {}
 
-void Proposal::status_rejected_impl (std::map<std::string, VariantValue> & args) {}
+void Proposal::status_rejected_impl (ProposalArgs & args) {}
 
-void Proposal::callback (std::map<std::string, VariantValue> & args) {}
+void Proposal::callback (ProposalArgs & args) {}
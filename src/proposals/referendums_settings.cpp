@@ -1,23 +1,23 @@
 #include <proposals/referendum_settings.hpp>
 
 
-void ReferendumSettings::create_impl (std::map<std::string, VariantValue> & args) {
+void ReferendumSettings::create_impl (ProposalArgs & args) {
 
   // check the fund?
 
-  name setting_name = std::get<name>(args["setting_name"]);
+  name setting_name = args.setting_name;
   std::unique_ptr<SettingInfo> s_info = std::unique_ptr<SettingInfo>(get_setting_info(setting_name));
 
   dao::proposal_auxiliary_tables propaux_t(contract_name, contract_name.value);
 
-  uint64_t proposal_id = std::get<uint64_t>(args["proposal_id"]);
+  uint64_t proposal_id = args.proposal_id;
 
   uint64_t min_test_cycles = this->m_contract.config_get("refmintest"_n);
-  uint64_t test_cycles = std::get<uint64_t>(args["test_cycles"]);
+  uint64_t test_cycles = args.test_cycles;
   check(test_cycles >= min_test_cycles, "the number of test cycles must be at least " + std::to_string(min_test_cycles));
 
   uint64_t min_eval_cycles = this->m_contract.config_get("refmineval"_n);
-  uint64_t eval_cycles = std::get<uint64_t>(args["eval_cycles"]);
+  uint64_t eval_cycles = args.eval_cycles;
   check(eval_cycles >= min_eval_cycles, "the number of eval cycles must be at least " + std::to_string(min_eval_cycles));
 
   propaux_t.emplace(contract_name, [&](auto & item){
@@ -25,10 +25,10 @@ void ReferendumSettings::create_impl (std::map<std::string, VariantValue> & args
     item.special_attributes.insert(std::make_pair("setting_name", setting_name));
     item.special_attributes.insert(std::make_pair("is_float", s_info->is_float));
     if (s_info->is_float) {
-      item.special_attributes.insert(std::make_pair("new_value", std::get<double>(args["new_value"])));
+      item.special_attributes.insert(std::make_pair("new_value", std::get<double>(args.new_value)));
       item.special_attributes.insert(std::make_pair("previous_value", s_info->previous_value_double));
     } else {
-      item.special_attributes.insert(std::make_pair("new_value", std::get<uint64_t>(args["new_value"])));
+      item.special_attributes.insert(std::make_pair("new_value", std::get<uint64_t>(args.new_value)));
       item.special_attributes.insert(std::make_pair("previous_value", s_info->previous_value_uint));
     }
     item.special_attributes.insert(std::make_pair("cycles_per_status", "1," + std::to_string(test_cycles) + "," + std::to_string(eval_cycles)));
@@ -36,10 +36,10 @@ void ReferendumSettings::create_impl (std::map<std::string, VariantValue> & args
 
 }
 
-void ReferendumSettings::update_impl (std::map<std::string, VariantValue> & args) {
+void ReferendumSettings::update_impl (ProposalArgs & args) {
 
-  name setting_name = std::get<name>(args["setting_name"]);
-  uint64_t proposal_id = std::get<uint64_t>(args["proposal_id"]);
+  name setting_name = args.setting_name;
+  uint64_t proposal_id = args.proposal_id;
 
   std::unique_ptr<SettingInfo> s_info = std::unique_ptr<SettingInfo>(get_setting_info(setting_name));
 
@@ -47,21 +47,21 @@ void ReferendumSettings::update_impl (std::map<std::string, VariantValue> & args
   auto raitr = propaux_t.require_find(proposal_id, "refaux entry not found");
 
   uint64_t min_test_cycles = this->m_contract.config_get("refmintest"_n);
-  uint64_t test_cycles = std::get<uint64_t>(args["test_cycles"]);
+  uint64_t test_cycles = args.test_cycles;
   check(test_cycles >= min_test_cycles, "the number of test cycles must be at least " + std::to_string(min_test_cycles));
 
   uint64_t min_eval_cycles = this->m_contract.config_get("refmineval"_n);
-  uint64_t eval_cycles = std::get<uint64_t>(args["eval_cycles"]);
+  uint64_t eval_cycles = args.eval_cycles;
   check(eval_cycles >= min_eval_cycles, "the number of eval cycles must be at least " + std::to_string(min_eval_cycles));
 
   propaux_t.modify(raitr, contract_name, [&](auto & item){
     item.special_attributes.at("setting_name") = setting_name;
     item.special_attributes.at("is_float") = s_info->is_float;
     if (s_info->is_float) {
-      item.special_attributes.at("new_value") = std::get<double>(args["new_value"]);
+      item.special_attributes.at("new_value") = std::get<double>(args.new_value);
       item.special_attributes.at("previous_value") = s_info->previous_value_double;
     } else {
-      item.special_attributes.at("new_value") = std::get<uint64_t>(args["new_value"]);
+      item.special_attributes.at("new_value") = std::get<uint64_t>(args.new_value);
       item.special_attributes.at("previous_value") = s_info->previous_value_uint;
     }
     item.special_attributes.at("cycles_per_status") = "1," + std::to_string(test_cycles) + "," + std::to_string(eval_cycles);
@@ -69,10 +69,10 @@ void ReferendumSettings::update_impl (std::map<std::string, VariantValue> & args
 
 }
 
-void ReferendumSettings::evaluate (std::map<std::string, VariantValue> & args) {
+void ReferendumSettings::evaluate (ProposalArgs & args) {
 
-  uint64_t proposal_id = std::get<uint64_t>(args["proposal_id"]);
-  uint64_t propcycle = std::get<uint64_t>(args["propcycle"]);
+  uint64_t proposal_id = args.proposal_id;
+  uint64_t propcycle = args.propcycle;
 
   dao::proposal_tables proposals_t(contract_name, contract_name.value);
   dao::proposal_auxiliary_tables propaux_t(contract_name, contract_name.value);
@@ -73,10 +73,11 @@ ACTION dao::deletescope (const uint64_t & start, const name & scope) {
   auto vitr = start == 0 ? voice_t.begin() : voice_t.find(start);
   
   while (vitr != voice_t.end() && count < batch_size) {
+    take_delegation_voice(vitr->account, scope);
     vitr = voice_t.erase(vitr);
     count++;
   }
-  
+
   if (vitr != voice_t.end()) {
     send_deferred_transaction(
       permission_level(get_self(), "active"_n),
@@ -149,10 +150,11 @@ ACTION dao::decayvoices () {
       && (now - c.t_onperiod >= decay_time)
       && (now - c.t_voicedecay >= decay_sec)
   ) {
+    // voice rows catch up with the new epoch lazily, see get_voice_balance
     c.t_voicedecay = now;
+    c.decay_epoch = c.decay_epoch.value_or(0) + 1;
     cycle_t.set(c, get_self());
-    uint64_t batch_size = config_get(name("batchsize"));
-    decayvoice(0, batch_size);
+    utils::record_decay_rate(get_self(), c.decay_epoch.value(), config_get(name("vdecayprntge")));
   }
 }
 
@@ -161,27 +163,21 @@ ACTION dao::decayvoice (const uint64_t & start, const uint64_t & chunksize) {
 
   voice_tables voices(get_self(), campaign_scope.value);
 
-  print("decaying voices!\n", "chunksize:", chunksize, "\n");
-
-  uint64_t percentage_decay = config_get(name("vdecayprntge"));
-  check(percentage_decay <= 100, "Voice decay parameter can not be more than 100%.");
+  uint64_t epoch = get_decay_epoch();
   
   auto vitr = voices.lower_bound(start);
   uint64_t count = 0;
 
-  double multiplier = (100.0 - (double)percentage_decay) / 100.0;
-
   while (vitr != voices.end() && count < chunksize) {
 
-    print("account:", vitr->account, "\n");
-
     for (auto & s : scopes) {
       voice_tables voice_t(get_self(), s.value);
       auto voice_itr = voice_t.find(vitr->account.value);
 
-      if (voice_itr != voice_t.end()) {
+      if (voice_itr != voice_t.end() && voice_itr->decay_epoch.value_or(0) < epoch) {
+        uint64_t balance = get_voice_balance(*voice_itr, epoch);
         voice_t.modify(voice_itr, _self, [&](auto & v){
-          v.balance *= multiplier;
+          utils::stamp_voice(v, balance, epoch);
         });
       }
     }
@@ -250,14 +246,25 @@ ACTION dao::delegate (const name & delegator, const name & delegatee, const name
 
   check(no_cycles, "can not add delegatee, cycles are not allowed");
 
-  if (ditr != deltrust_t.end()) {
-    deltrust_t.modify(ditr, _self, [&](auto & item){
+  // dhos votes are copied per delegator by dhomimicvote, they have no delegated voice
+  bool pooled = scope != dhos_scope;
+
+  if (pooled && ditr != deltrust_t.end()) {
+    leave_delegatee(delegator, scope);
+  }
+
+  // leave_delegatee writes the delegation row, read it again
+  delegate_trust_tables deltrusts(get_self(), scope.value);
+  auto eitr = deltrusts.find(delegator.value);
+
+  if (eitr != deltrusts.end()) {
+    deltrusts.modify(eitr, _self, [&](auto & item){
       item.delegatee = delegatee;
       item.weight = 1.0;
       item.timestamp = eosio::current_time_point().sec_since_epoch();
     });
   } else {
-    deltrust_t.emplace(_self, [&](auto & item){
+    deltrusts.emplace(_self, [&](auto & item){
       item.delegator = delegator;
       item.delegatee = delegatee;
       item.weight = 1.0;
@@ -265,6 +272,23 @@ ACTION dao::delegate (const name & delegator, const name & delegatee, const name
     });
   }
 
+  if (pooled) {
+    join_delegatee(delegator, delegatee, scope);
+
+    // the delegator already took part in these, its voice must not be cast on them a second time
+    for (auto & proposal_id : active_proposals_in_scope(scope)) {
+      votes_tables votes_t(get_self(), proposal_id);
+      if (votes_t.find(delegator.value) == votes_t.end()) { continue; }
+
+      delegation_exclusion_tables exclusions_t(get_self(), proposal_id);
+      if (exclusions_t.find(delegator.value) == exclusions_t.end()) {
+        exclusions_t.emplace(_self, [&](auto & item){
+          item.account = delegator;
+        });
+      }
+    }
+  }
+
 }
 
 ACTION dao::undelegate (const name & delegator, const name & scope) {
@@ -279,9 +303,71 @@ ACTION dao::undelegate (const name & delegator, const name & scope) {
     require_auth(ditr->delegatee);
   }
 
+  leave_delegatee(delegator, scope);
+
   deltrust_t.erase(ditr);
 }
 
+ACTION dao::settlevoice (const name & account, const name & scope) {
+  require_auth(has_auth(account) ? account : get_self());
+  settle_delegation(account, scope);
+}
+
+ACTION dao::migdelegs (const name & scope, const uint64_t & start, const uint64_t & chunksize) {
+
+  require_auth(get_self());
+
+  auto sitr = std::find(scopes.begin(), scopes.end(), scope);
+  check(sitr != scopes.end() && scope != dhos_scope, "invalid scope");
+
+  delegation_state_tables delegstate_t(get_self(), get_self().value);
+  delegation_state_table state = delegstate_t.get_or_create(get_self(), delegation_state_table());
+
+  // votes keep mimicking delegatees one delegator at a time until every scope has joined
+  if (sitr == scopes.begin() && start == 0) {
+    state.ready = false;
+    delegstate_t.set(state, get_self());
+  }
+
+  delegate_trust_tables deltrust_t(get_self(), scope.value);
+  auto ditr = deltrust_t.lower_bound(start);
+  uint64_t count = 0;
+
+  while (ditr != deltrust_t.end() && count < chunksize) {
+    if (!ditr->shares.has_value()) {
+      join_delegatee(ditr->delegator, ditr->delegatee, scope);
+    }
+    ditr++;
+    count++;
+  }
+
+  if (ditr != deltrust_t.end()) {
+    send_deferred_transaction(
+      permission_level(get_self(), "active"_n),
+      get_self(),
+      "migdelegs"_n,
+      std::make_tuple(scope, ditr->delegator.value, chunksize)
+    );
+    return;
+  }
+
+  sitr++;
+  if (sitr != scopes.end() && *sitr != dhos_scope) {
+    send_deferred_transaction(
+      permission_level(get_self(), "active"_n),
+      get_self(),
+      "migdelegs"_n,
+      std::make_tuple(*sitr, uint64_t(0), chunksize)
+    );
+    return;
+  }
+
+  state.ready = true;
+  delegstate_t.set(state, get_self());
+
+}
+
+// Only used until migdelegs has joined every delegation to delegvoice, see delegated_voice_ready.
 ACTION dao::mimicvote (
   const name & delegatee, 
   const name & delegator, 
@@ -302,6 +388,7 @@ ACTION dao::mimicvote (
 
   auto ditr = deltrusts_by_delegatee_delegator.lower_bound(id);
   uint64_t count = 0;
+  uint64_t epoch = get_decay_epoch();
 
   while (ditr != deltrusts_by_delegatee_delegator.end() && ditr->delegatee == delegatee && count < chunksize) {
 
@@ -314,7 +401,7 @@ ACTION dao::mimicvote (
         permission_level(get_self(), "active"_n),
         get_self(),
         "voteonbehalf"_n,
-        std::make_tuple(voter, proposal_id, uint64_t(vitr->balance * percentage_used), option)
+        std::make_tuple(voter, proposal_id, uint64_t(get_voice_balance(*vitr, epoch) * percentage_used), option)
       );
     }
 
@@ -382,6 +469,9 @@ ACTION dao::mimicrevert (const name & delegatee, const uint64_t & delegator, con
 
 }
 
+// dho votes do not spend voice: votedhos weighs each account's percentages by its own contribution
+// score rank and keeps rows per account that dhocleanvote expires one by one, so there is no
+// balance a delegatee could cast for its delegators and each of them is voted separately.
 ACTION dao::dhomimicvote (const name & delegatee, const uint64_t & start, std::vector<DhoVote> votes, const uint64_t & chunksize) {
 
   require_auth(get_self());
@@ -423,26 +513,34 @@ ACTION dao::testsetvoice (const name & account, const uint64_t & amount) {
 
 
 void dao::set_voice (const name & user, const uint64_t & amount, const name & scope) {
+  uint64_t epoch = get_decay_epoch();
+
   if (scope == "all"_n) {
 
     bool increase_size = true;
 
     for (auto & s : scopes) {
+      settle_delegation(user, s);
+
       voice_tables voice_t(get_self(), s.value);
       auto vitr = voice_t.find(user.value);
+      uint64_t balance = 0;
 
       if (vitr == voice_t.end()) {
         voice_t.emplace(_self, [&](auto & voice){
           voice.account = user;
-          voice.balance = amount;
+          utils::stamp_voice(voice, amount, epoch);
         });
       }
       else {
         increase_size = false;
+        balance = get_voice_balance(*vitr, epoch);
         voice_t.modify(vitr, _self, [&](auto & voice){
-          voice.balance = amount;
+          utils::stamp_voice(voice, amount, epoch);
         });
       }
+
+      change_delegation_value(user, s, int64_t(amount) - int64_t(balance));
     }
 
     if (increase_size) {
@@ -450,60 +548,75 @@ void dao::set_voice (const name & user, const uint64_t & amount, const name & sc
     }
 
   } else {
+    settle_delegation(user, scope);
+
     voice_tables voice_t(get_self(), scope.value);
     auto vitr = voice_t.find(user.value);
+    uint64_t balance = 0;
 
     if (vitr == voice_t.end()) {
       voice_t.emplace(_self, [&](auto & voice){
         voice.account = user;
-        voice.balance = amount;
+        utils::stamp_voice(voice, amount, epoch);
       });
     } else {
+      balance = get_voice_balance(*vitr, epoch);
       voice_t.modify(vitr, _self, [&](auto & voice){
-        voice.balance = amount;
+        utils::stamp_voice(voice, amount, epoch);
       });
     }
+
+    change_delegation_value(user, scope, int64_t(amount) - int64_t(balance));
   }
 }
 
 double dao::voice_change (const name & user, const uint64_t & amount, const bool & reduce, const name & scope) {
   double percentage_used = 0.0;
+  uint64_t epoch = get_decay_epoch();
 
   if (scope == "all"_n) {
 
     for (auto & s : scopes) {
+      settle_delegation(user, s);
+
       voice_tables voice_t(get_self(), s.value);
       auto vitr = voice_t.find(user.value);
 
       if (vitr != voice_t.end()) {
+        uint64_t balance = get_voice_balance(*vitr, epoch);
         if (reduce) {
-          check(amount <= vitr->balance, s.to_string() + " voice balance exceeded");
+          check(amount <= balance, s.to_string() + " voice balance exceeded");
         }
         voice_t.modify(vitr, _self, [&](auto & voice){
           if (reduce) {
-            voice.balance -= amount;
+            utils::stamp_voice(voice, balance - amount, epoch);
           } else {
-            voice.balance += amount;
+            utils::stamp_voice(voice, balance + amount, epoch);
           }
         });
+        change_delegation_value(user, s, reduce ? -int64_t(amount) : int64_t(amount));
       }
     }
 
-  } else {    
+  } else {
+    settle_delegation(user, scope);
+
     voice_tables voice_t(get_self(), scope.value);
     auto vitr = voice_t.require_find(user.value, "user does not have voice");
+    uint64_t balance = get_voice_balance(*vitr, epoch);
 
     if (reduce) {
-      check(amount <= vitr->balance, "voice balance exceeded");
-      percentage_used = amount / double(vitr -> balance);
+      check(amount <= balance, "voice balance exceeded");
+      percentage_used = amount / double(balance);
     }
     voice_t.modify(vitr, _self, [&](auto & voice){
       if (reduce) {
-        voice.balance -= amount;
+        utils::stamp_voice(voice, balance - amount, epoch);
       } else {
-        voice.balance += amount;
+        utils::stamp_voice(voice, balance + amount, epoch);
       }
     });
+    change_delegation_value(user, scope, reduce ? -int64_t(amount) : int64_t(amount));
   }
 
   return percentage_used;
@@ -513,6 +626,7 @@ void dao::erase_voice (const name & user) {
   require_auth(get_self());
 
   for (auto & s : scopes) {
+    take_delegation_voice(user, s);
     voice_tables voice_t(get_self(), s.value);
     auto vitr = voice_t.find(user.value);
     voice_t.erase(vitr);
@@ -561,12 +675,28 @@ uint64_t dao::calculate_decay (const uint64_t & voice_amount) {
 
   if (temp >= c.t_voicedecay) { return voice_amount; }
   uint64_t n = ((c.t_voicedecay - temp) / decay_sec) + 1;
-  
-  double multiplier = 1.0 - (decay_percentage / 100.0);
-  return voice_amount * pow(multiplier, n);
+
+  // the last n decay epochs, each at the rate it was started with
+  uint64_t epoch = c.decay_epoch.value_or(0);
+  uint64_t from_epoch = epoch > n ? epoch - n : 0;
+  double fallback = 1.0 - (decay_percentage / 100.0);
+  double multiplier = utils::decay_multiplier_between(get_self(), from_epoch, epoch, fallback) * pow(fallback, n - (epoch - from_epoch));
+
+  return voice_amount * multiplier;
 
 }
 
+uint64_t dao::get_decay_epoch () {
+  cycle_tables cycle_t(get_self(), get_self().value);
+  cycle_table c = cycle_t.get_or_create(get_self(), cycle_table());
+  return c.decay_epoch.value_or(0);
+}
+
+uint64_t dao::get_voice_balance (const voice_table & voice, const uint64_t & epoch) {
+  if (voice.decay_epoch.value_or(0) >= epoch) { return voice.balance; }
+  return utils::decayed_voice_balance(get_self(), voice, epoch, utils::voice_decay_multiplier(config_get(name("vdecayprntge"))));
+}
+
 bool dao::has_delegates (const name & voter, const name & scope) {
   delegate_trust_tables deltrust_t(get_self(), scope.value);
   auto deltrusts_by_delegatee = deltrust_t.get_index<"bydelegatee"_n>();
@@ -580,3 +710,472 @@ bool dao::is_active (const name & account, const uint64_t & cutoff_date) {
   return aitr != actives_t.end() && aitr->timestamp > cutoff_date;
 }
 
+
+bool dao::delegated_voice_ready () {
+  delegation_state_tables delegstate_t(get_self(), get_self().value);
+  return delegstate_t.get_or_default().ready;
+}
+
+uint64_t dao::get_delegated_balance (const delegated_voice_table & delegated, const uint64_t & epoch) {
+  if (delegated.decay_epoch >= epoch) { return delegated.balance; }
+  double multiplier = utils::decay_multiplier_between(get_self(), delegated.decay_epoch, epoch, utils::voice_decay_multiplier(config_get(name("vdecayprntge"))));
+  return delegated.balance * multiplier;
+}
+
+// the voice an account passes on to its delegatee: its own and the one delegated to it
+uint64_t dao::delegation_value (const name & account, const name & scope, const uint64_t & epoch) {
+  uint64_t value = 0;
+
+  voice_tables voice_t(get_self(), scope.value);
+  auto vitr = voice_t.find(account.value);
+  if (vitr != voice_t.end()) {
+    value += get_voice_balance(*vitr, epoch);
+  }
+
+  delegated_voice_tables delegvoice_t(get_self(), scope.value);
+  auto pitr = delegvoice_t.find(account.value);
+  if (pitr != delegvoice_t.end()) {
+    value += get_delegated_balance(*pitr, epoch);
+  }
+
+  return value;
+}
+
+void dao::join_delegatee (const name & delegator, const name & delegatee, const name & scope) {
+
+  settle_delegation(delegatee, scope);
+
+  uint64_t epoch = get_decay_epoch();
+  uint64_t value = delegation_value(delegator, scope, epoch);
+
+  delegated_voice_tables delegvoice_t(get_self(), scope.value);
+  auto pitr = delegvoice_t.find(delegatee.value);
+
+  if (pitr == delegvoice_t.end()) {
+    pitr = delegvoice_t.emplace(_self, [&](auto & item){
+      item.delegatee = delegatee;
+      item.balance = 0;
+      item.decay_epoch = epoch;
+      item.shares = 0;
+      item.share_epoch = 0;
+      item.votes = 0;
+      item.delegators = 0;
+    });
+  }
+
+  uint64_t balance = get_delegated_balance(*pitr, epoch);
+  double pool_shares = pitr->shares;
+  uint64_t share_epoch = pitr->share_epoch;
+
+  if (balance == 0 && pool_shares > 0) {
+    share_epoch += 1;
+    pool_shares = 0;
+  }
+
+  double shares = pool_shares > 0 ? value * pool_shares / double(balance) : double(value);
+
+  delegvoice_t.modify(pitr, _self, [&](auto & item){
+    item.balance = balance + value;
+    item.decay_epoch = epoch;
+    item.shares = pool_shares + shares;
+    item.share_epoch = share_epoch;
+  });
+
+  delegate_trust_tables deltrust_t(get_self(), scope.value);
+  auto ditr = deltrust_t.require_find(delegator.value, "delegator not found");
+
+  deltrust_t.modify(ditr, _self, [&](auto & item){
+    item.shares = shares;
+    item.share_epoch = share_epoch;
+    item.votes = pitr->votes;
+  });
+
+  change_delegators(delegatee, scope, 1 + int64_t(pool_delegators(delegator, scope)));
+  change_delegation_value(delegatee, scope, int64_t(value));
+
+}
+
+void dao::leave_delegatee (const name & delegator, const name & scope) {
+
+  delegate_trust_tables deltrust_t(get_self(), scope.value);
+  auto ditr = deltrust_t.find(delegator.value);
+  if (ditr == deltrust_t.end() || !ditr->shares.has_value()) { return; }
+
+  name delegatee = ditr->delegatee;
+
+  change_delegators(delegatee, scope, -1 - int64_t(pool_delegators(delegator, scope)));
+
+  settle_delegation(delegator, scope);
+  detach_delegated_votes(delegator, scope);
+
+  // settle_delegation writes the delegation row, read it again
+  delegate_trust_tables deltrusts(get_self(), scope.value);
+  auto eitr = deltrusts.find(delegator.value);
+
+  delegated_voice_tables delegvoice_t(get_self(), scope.value);
+  auto pitr = delegvoice_t.find(delegatee.value);
+  if (pitr == delegvoice_t.end() || eitr->share_epoch.value() != pitr->share_epoch || !(pitr->shares > 0)) { return; }
+
+  uint64_t epoch = get_decay_epoch();
+  uint64_t balance = get_delegated_balance(*pitr, epoch);
+  double shares = std::min(eitr->shares.value(), pitr->shares);
+
+  // the last delegator takes the rounding left over
+  uint64_t removed = shares >= pitr->shares ? balance : std::min(balance, uint64_t(llround(balance * (shares / pitr->shares))));
+
+  delegvoice_t.modify(pitr, _self, [&](auto & item){
+    item.balance = balance - removed;
+    item.decay_epoch = epoch;
+    item.shares = shares >= item.shares ? 0 : item.shares - shares;
+  });
+
+  deltrusts.modify(eitr, _self, [&](auto & item){
+    item.shares = 0;
+  });
+
+  change_delegation_value(delegatee, scope, -int64_t(removed));
+
+}
+
+// Brings an account's voice up to date with the votes its delegatee cast since the last settle:
+// what the account owns of the delegvoice balance now is what is left of its voice.
+void dao::settle_delegation (const name & account, const name & scope) {
+
+  delegate_trust_tables deltrust_t(get_self(), scope.value);
+  auto ditr = deltrust_t.find(account.value);
+  if (ditr == deltrust_t.end() || !ditr->shares.has_value()) { return; }
+
+  settle_delegation(ditr->delegatee, scope);
+
+  delegated_voice_tables delegvoice_t(get_self(), scope.value);
+  auto pitr = delegvoice_t.find(ditr->delegatee.value);
+  if (pitr == delegvoice_t.end() || ditr->votes.value() == pitr->votes) { return; }
+
+  uint64_t epoch = get_decay_epoch();
+  uint64_t stored = delegation_value(account, scope, epoch);
+  uint64_t value = 0;
+
+  if (ditr->share_epoch.value() == pitr->share_epoch && pitr->shares > 0) {
+    value = std::min(stored, uint64_t(llround(get_delegated_balance(*pitr, epoch) * (ditr->shares.value() / pitr->shares))));
+  }
+
+  uint64_t votes = pitr->votes - ditr->votes.value();
+  double remaining = stored > 0 ? value / double(stored) : 1.0;
+
+  voice_tables voice_t(get_self(), scope.value);
+  auto vitr = voice_t.find(account.value);
+  if (vitr != voice_t.end() && remaining < 1.0) {
+    uint64_t balance = get_voice_balance(*vitr, epoch) * remaining;
+    voice_t.modify(vitr, _self, [&](auto & voice){
+      utils::stamp_voice(voice, balance, epoch);
+    });
+  }
+
+  // the account's delegators took part in the same votes
+  auto oitr = delegvoice_t.find(account.value);
+  if (oitr != delegvoice_t.end()) {
+    uint64_t balance = get_delegated_balance(*oitr, epoch) * remaining;
+    delegvoice_t.modify(oitr, _self, [&](auto & item){
+      item.balance = balance;
+      item.decay_epoch = epoch;
+      item.votes += votes;
+    });
+  }
+
+  deltrust_t.modify(ditr, _self, [&](auto & item){
+    item.votes = pitr->votes;
+  });
+
+  credit_delegated_votes(account, votes);
+
+}
+
+// An account's voice, or the voice delegated to it, changed by delta: its delegatee's balance
+// changes with it. The account must be settled.
+void dao::change_delegation_value (const name & account, const name & scope, const int64_t & delta) {
+
+  if (delta == 0) { return; }
+
+  delegate_trust_tables deltrust_t(get_self(), scope.value);
+  auto ditr = deltrust_t.find(account.value);
+  if (ditr == deltrust_t.end() || !ditr->shares.has_value()) { return; }
+
+  delegated_voice_tables delegvoice_t(get_self(), scope.value);
+  auto pitr = delegvoice_t.find(ditr->delegatee.value);
+  if (pitr == delegvoice_t.end()) { return; }
+
+  uint64_t epoch = get_decay_epoch();
+  uint64_t balance = get_delegated_balance(*pitr, epoch);
+  double pool_shares = pitr->shares;
+  uint64_t share_epoch = pitr->share_epoch;
+  double shares = ditr->share_epoch.value() == share_epoch ? ditr->shares.value() : 0.0;
+  int64_t applied = 0;
+
+  if (delta > 0) {
+    if (balance == 0 && pool_shares > 0) {
+      share_epoch += 1;
+      pool_shares = 0;
+      shares = 0;
+    }
+    double new_shares = pool_shares > 0 ? delta * pool_shares / double(balance) : double(delta);
+    shares += new_shares;
+    pool_shares += new_shares;
+    balance += delta;
+    applied = delta;
+  } else if (shares > 0 && pool_shares > 0 && balance > 0) {
+    uint64_t removed = std::min(uint64_t(-delta), balance);
+    double removed_shares = std::min(shares, pool_shares * (removed / double(balance)));
+    if (removed_shares >= pool_shares) {
+      removed = balance;
+    }
+    shares -= removed_shares;
+    pool_shares = removed_shares >= pool_shares ? 0 : pool_shares - removed_shares;
+    balance -= removed;
+    applied = -int64_t(removed);
+  }
+
+  if (applied == 0) { return; }
+
+  delegvoice_t.modify(pitr, _self, [&](auto & item){
+    item.balance = balance;
+    item.decay_epoch = epoch;
+    item.shares = pool_shares;
+    item.share_epoch = share_epoch;
+  });
+
+  deltrust_t.modify(ditr, _self, [&](auto & item){
+    item.shares = shares;
+    item.share_epoch = share_epoch;
+  });
+
+  change_delegation_value(ditr->delegatee, scope, applied);
+
+}
+
+// Casts the voter's delegated voice with the same part of it the voter used of its own voice.
+// Delegators that voted on the proposal themselves before delegating are left out, of the
+// amount and of the represented delegators.
+uint64_t dao::use_delegated_voice (const name & voter, const name & scope, const uint64_t & proposal_id, const double & percentage_used, double & shares, uint64_t & represented) {
+
+  shares = 0;
+  represented = 0;
+
+  delegated_voice_tables delegvoice_t(get_self(), scope.value);
+  auto pitr = delegvoice_t.find(voter.value);
+  if (pitr == delegvoice_t.end()) { return 0; }
+
+  uint64_t epoch = get_decay_epoch();
+  uint64_t balance = get_delegated_balance(*pitr, epoch);
+
+  uint64_t excluded = 0;
+  uint64_t excluded_delegators = 0;
+
+  delegation_exclusion_tables exclusions_t(get_self(), proposal_id);
+  for (auto eitr = exclusions_t.begin(); eitr != exclusions_t.end(); eitr++) {
+    if (delegates_to(eitr->account, voter, scope)) {
+      excluded += delegation_value(eitr->account, scope, epoch);
+      excluded_delegators += 1 + pool_delegators(eitr->account, scope);
+    }
+  }
+
+  uint64_t available = balance - std::min(excluded, balance);
+  uint64_t amount = percentage_used > 0 ? std::min(available, uint64_t(available * percentage_used)) : 0;
+  shares = pitr->shares;
+  represented = pitr->delegators - std::min(excluded_delegators, pitr->delegators);
+
+  delegvoice_t.modify(pitr, _self, [&](auto & item){
+    item.balance = balance - amount;
+    item.decay_epoch = epoch;
+    item.votes += 1;
+  });
+
+  change_delegation_value(voter, scope, -int64_t(amount));
+
+  return amount;
+
+}
+
+// Adds delta represented accounts to the delegatee and to every delegatee up its chain.
+void dao::change_delegators (const name & delegatee, const name & scope, const int64_t & delta) {
+
+  if (delta == 0) { return; }
+
+  delegate_trust_tables deltrust_t(get_self(), scope.value);
+  delegated_voice_tables delegvoice_t(get_self(), scope.value);
+  uint64_t max_depth = config_get("dlegate.dpth"_n);
+
+  name current = delegatee;
+
+  for (uint64_t depth = 0; depth < max_depth; depth++) {
+    auto pitr = delegvoice_t.find(current.value);
+    if (pitr == delegvoice_t.end()) { break; }
+
+    delegvoice_t.modify(pitr, _self, [&](auto & item){
+      item.delegators = delta < 0 && uint64_t(-delta) > item.delegators ? 0 : item.delegators + delta;
+    });
+
+    auto ditr = deltrust_t.find(current.value);
+    if (ditr == deltrust_t.end() || !ditr->shares.has_value()) { break; }
+
+    current = ditr->delegatee;
+  }
+
+}
+
+uint64_t dao::pool_delegators (const name & account, const name & scope) {
+  delegated_voice_tables delegvoice_t(get_self(), scope.value);
+  auto pitr = delegvoice_t.find(account.value);
+  return pitr != delegvoice_t.end() ? pitr->delegators : 0;
+}
+
+// true when the account's voice reaches delegatee through its joined delegations
+bool dao::delegates_to (const name & account, const name & delegatee, const name & scope) {
+
+  delegate_trust_tables deltrust_t(get_self(), scope.value);
+  uint64_t max_depth = config_get("dlegate.dpth"_n);
+
+  name current = account;
+
+  for (uint64_t depth = 0; depth < max_depth; depth++) {
+    auto ditr = deltrust_t.find(current.value);
+    if (ditr == deltrust_t.end() || !ditr->shares.has_value()) { return false; }
+    if (ditr->delegatee == delegatee) { return true; }
+    current = ditr->delegatee;
+  }
+
+  return false;
+
+}
+
+void dao::credit_delegated_votes (const name & account, const uint64_t & votes) {
+
+  if (votes == 0) { return; }
+
+  participant_tables participants_t(get_self(), get_self().value);
+  auto paitr = participants_t.find(account.value);
+
+  if (paitr == participants_t.end()) {
+    uint64_t rep_amount = uint64_t(round(config_get(name("voterep2.ind")) * (config_get(name("votedel.mul")) / 100.0)));
+
+    if (rep_amount > 0) {
+      send_inline_action(
+        permission_level(contracts::accounts, "addrep"_n),
+        contracts::accounts, "addrep"_n,
+        std::make_tuple(account, rep_amount)
+      );
+    }
+    participants_t.emplace(_self, [&](auto & participant){
+      participant.account = account;
+      participant.nonneutral = true;
+      participant.count = votes;
+    });
+  } else {
+    participants_t.modify(paitr, _self, [&](auto & participant){
+      participant.count += votes;
+    });
+  }
+
+  active_tables actives_t(get_self(), get_self().value);
+  auto aitr = actives_t.find(account.value);
+  if (aitr == actives_t.end()) {
+    actives_t.emplace(_self, [&](auto & item) {
+      item.account = account;
+      item.timestamp = current_time_point().sec_since_epoch();
+    });
+    size_change(user_active_size, 1);
+  } else {
+    actives_t.modify(aitr, _self, [&](auto & item){
+      item.timestamp = current_time_point().sec_since_epoch();
+    });
+  }
+
+}
+
+// A leaving delegator takes its part of the delegated voice its delegatees already cast on
+// active proposals, as a vote of its own in the same direction.
+void dao::detach_delegated_votes (const name & delegator, const name & scope) {
+
+  std::vector<uint64_t> proposal_ids = active_proposals_in_scope(scope);
+  if (proposal_ids.empty()) { return; }
+
+  delegate_trust_tables deltrust_t(get_self(), scope.value);
+  delegated_voice_tables delegvoice_t(get_self(), scope.value);
+
+  uint64_t epoch = get_decay_epoch();
+  uint64_t max_depth = config_get("dlegate.dpth"_n);
+
+  name current = delegator;
+  double part = 1.0; // the delegator's part of what current delegates
+
+  for (uint64_t depth = 0; depth < max_depth && part > 0; depth++) {
+    auto ditr = deltrust_t.find(current.value);
+    if (ditr == deltrust_t.end() || !ditr->shares.has_value()) { break; }
+
+    auto pitr = delegvoice_t.find(ditr->delegatee.value);
+    if (pitr == delegvoice_t.end() || ditr->share_epoch.value() != pitr->share_epoch) { break; }
+
+    for (auto & proposal_id : proposal_ids) {
+      votes_tables votes_t(get_self(), proposal_id);
+      auto vitr = votes_t.find(ditr->delegatee.value);
+      if (vitr == votes_t.end() || vitr->delegated.value_or(0) == 0 || !(vitr->delegated_shares.value_or(0) > 0)) { continue; }
+      if (votes_t.find(delegator.value) != votes_t.end()) { continue; }
+
+      double owned = std::min(1.0, ditr->shares.value() / vitr->delegated_shares.value()) * part;
+      uint64_t portion = std::min(vitr->delegated.value(), uint64_t(vitr->delegated.value() * owned));
+      if (portion == 0) { continue; }
+
+      bool favour = vitr->favour;
+
+      votes_t.modify(vitr, _self, [&](auto & item){
+        item.delegated = item.delegated.value() - portion;
+      });
+
+      votes_t.emplace(_self, [&](auto & item){
+        item.proposal_id = proposal_id;
+        item.account = delegator;
+        item.amount = portion;
+        item.favour = favour;
+      });
+    }
+
+    uint64_t delegatee_value = delegation_value(ditr->delegatee, scope, epoch);
+    uint64_t current_value = pitr->shares > 0 ? get_delegated_balance(*pitr, epoch) * (ditr->shares.value() / pitr->shares) : 0;
+    part = delegatee_value > 0 ? part * std::min(1.0, current_value / double(delegatee_value)) : 0;
+
+    current = ditr->delegatee;
+  }
+
+}
+
+std::vector<uint64_t> dao::active_proposals_in_scope (const name & scope) {
+
+  std::vector<uint64_t> proposal_ids;
+
+  proposal_tables proposals_t(get_self(), get_self().value);
+  auto proposals_by_stage_id = proposals_t.get_index<"bystageid"_n>();
+  auto pitr = proposals_by_stage_id.lower_bound(uint128_t(ProposalsCommon::stage_active.value) << 64);
+
+  while (pitr != proposals_by_stage_id.end() && pitr->stage == ProposalsCommon::stage_active) {
+    ProposalsFactory prop(*this, pitr->type);
+    if (prop->get_scope() == scope) {
+      proposal_ids.push_back(pitr->proposal_id);
+    }
+    pitr++;
+  }
+
+  return proposal_ids;
+
+}
+
+// settles the account and takes its voice out of its delegatee's balance, before the voice row is erased
+void dao::take_delegation_voice (const name & account, const name & scope) {
+
+  settle_delegation(account, scope);
+
+  voice_tables voice_t(get_self(), scope.value);
+  auto vitr = voice_t.find(account.value);
+  if (vitr == voice_t.end()) { return; }
+
+  change_delegation_value(account, scope, -int64_t(get_voice_balance(*vitr, get_decay_epoch())));
+
+}
@@ -17,6 +17,8 @@ void accounts::reset() {
     uitr = users.erase(uitr);
   }
 
+  utils::delete_table<user_core_tables>(contracts::accounts, contracts::accounts.value);
+
   utils::delete_table<flag_points_tables>(contracts::accounts, flag_total_scope.value);
   utils::delete_table<flag_points_tables>(contracts::accounts, flag_remove_scope.value);
 
@@ -32,6 +34,17 @@ void accounts::reset() {
   utils::delete_table<rep_tables>(contracts::accounts, contracts::accounts.value);
   utils::delete_table<rep_tables>(contracts::accounts, organization_scope.value);
 
+  utils::delete_table<score_bucket_tables>(contracts::accounts, rep_buckets.value);
+  utils::delete_table<score_bucket_tables>(contracts::accounts, rep_org_buckets.value);
+  utils::delete_table<score_bucket_tables>(contracts::accounts, cbs_buckets.value);
+  utils::delete_table<score_bucket_tables>(contracts::accounts, cbs_org_buckets.value);
+  utils::delete_table<score_count_tables>(contracts::accounts, rep_buckets.value);
+  utils::delete_table<score_count_tables>(contracts::accounts, rep_org_buckets.value);
+  utils::delete_table<score_count_tables>(contracts::accounts, cbs_buckets.value);
+  utils::delete_table<score_count_tables>(contracts::accounts, cbs_org_buckets.value);
+
+  utils::delete_table<rank_change_tables>(contracts::accounts, contracts::accounts.value);
+
   utils::delete_table<size_tables>(contracts::accounts, contracts::accounts.value);
 
   utils::delete_table<ban_tables>(contracts::accounts, contracts::accounts.value);
@@ -68,15 +81,19 @@ void accounts::adduser(name account, string nickname, name type)
   auto uitr = users.find(account.value);
   check(uitr == users.end(), "existing user");
 
+  uint64_t now = eosio::current_time_point().sec_since_epoch();
+
   users.emplace(_self, [&](auto& user) {
       user.account = account;
       user.status = visitor;
       user.reputation = 0;
       user.type = type;
       user.nickname = nickname;
-      user.timestamp = eosio::current_time_point().sec_since_epoch();
+      user.timestamp = now;
   });
 
+  set_user_core(account, visitor, type, now);
+
   size_change("users.sz"_n, 1);
 
 }
@@ -417,15 +434,18 @@ void accounts::add_cbs(name account, int points) {
 
   auto citr = cbs_t.find(account.value);
   if (citr != cbs_t.end()) {
+    utils::score_bucket_change(get_self(), cbs_buckets_for(scope), citr->community_building_score, -1, true);
     cbs_t.modify(citr, _self, [&](auto& item) {
       item.community_building_score += points;
     });
+    utils::score_bucket_change(get_self(), cbs_buckets_for(scope), citr->community_building_score, 1, true);
   } else {
     cbs_t.emplace(_self, [&](auto& item) {
       item.account = account;
       item.community_building_score = points;
       item.rank = 0;
     });
+    utils::score_bucket_change(get_self(), cbs_buckets_for(scope), uint32_t(points), 1, true);
     if (scope == individual_scope) {
       size_change("cbs.sz"_n, 1);
     } else if (scope == organization_scope) {
@@ -482,9 +502,11 @@ void accounts::addrep(name user, uint64_t amount)
   if (ritr == rep_t.end()) {
     add_rep_item(user, amount, scope);
   } else {
+    utils::score_bucket_change(get_self(), rep_buckets_for(scope), ritr->rep, -1, true);
     rep_t.modify(ritr, _self, [&](auto& item) {
       item.rep += amount;
     });
+    utils::score_bucket_change(get_self(), rep_buckets_for(scope), ritr->rep, 1, true);
   }
 
 }
@@ -513,10 +535,12 @@ void accounts::subrep(name user, uint64_t amount)
 
   auto ritr = rep_t.find(user.value);
   if (ritr != rep_t.end()) {
+    utils::score_bucket_change(get_self(), rep_buckets_for(scope), ritr->rep, -1, true);
     if (ritr->rep > amount) {
       rep_t.modify(ritr, _self, [&](auto& item) {
         item.rep -= amount;
       });
+      utils::score_bucket_change(get_self(), rep_buckets_for(scope), ritr->rep, 1, true);
     } else {
       rep_t.erase(ritr);
       if (scope == individual_scope) {
@@ -524,6 +548,7 @@ void accounts::subrep(name user, uint64_t amount)
       } else if (scope == organization_scope) {
         size_change("rep.org.sz"_n, -1);
       }
+      mark_rank_changed(user);
     }
   }
 
@@ -538,6 +563,14 @@ name accounts::get_scope (name type) {
   return not_found;
 }
 
+name accounts::rep_buckets_for (name scope) {
+  return scope == organization_scope ? rep_org_buckets : rep_buckets;
+}
+
+name accounts::cbs_buckets_for (name scope) {
+  return scope == organization_scope ? cbs_org_buckets : cbs_buckets;
+}
+
 void accounts::update(name user, name type, string nickname, string image, string story, string roles, string skills, string interests)
 {
     require_auth(user);
@@ -644,6 +677,8 @@ void accounts::updatestatus(name user, name status)
     user.status = status;
   });
 
+  set_user_core(user, status, uitr->type, uitr->timestamp);
+
   bool trust = status == citizen;
 
   action(
@@ -655,21 +690,11 @@ void accounts::updatestatus(name user, name status)
 }
 
 uint64_t accounts::config_get(name key) {
-  auto citr = config.find(key.value);
-  if (citr == config.end()) { 
-    // only create the error message string in error case for efficiency
-    check(false, ("settings: the "+key.to_string()+" parameter has not been initialized").c_str());
-  }
-  return citr->value;
+  return config_cache.get(config, key);
 }
 
 double accounts::config_float_get (name key) {
-  auto fitr = configfloat.find(key.value);
-  if (fitr == configfloat.end()) { 
-    // only create the error message string in error case for efficiency
-    check(false, ("settings: the "+key.to_string()+" parameter has not been initialized").c_str());
-  }
-  return fitr->value;
+  return config_float_cache.get(configfloat, key);
 }
 
 void accounts::cancitizen(name user) {
@@ -788,15 +813,15 @@ uint32_t accounts::num_transactions(name account, uint32_t limit) {
   return titr -> total_number_of_transactions;
 }
 
-void accounts::rankreps() {
-  rankrep(0, 0, 200, individual_scope);
+void accounts::rankreps(eosio::binary_extension<name> op_id) {
+  rankrep(0, 0, 200, individual_scope, op_id);
 }
 
-void accounts::rankorgreps() {
-  rankrep(0, 0, 200, organization_scope);
+void accounts::rankorgreps(eosio::binary_extension<name> op_id) {
+  rankrep(0, 0, 200, organization_scope, op_id);
 }
 
-void accounts::rankrep(uint64_t start_val, uint64_t chunk, uint64_t chunksize, name scope) {
+void accounts::rankrep(uint64_t start_val, uint64_t chunk, uint64_t chunksize, name scope, eosio::binary_extension<name> op_id) {
   require_auth(_self);
 
   uint64_t total = 0;
@@ -805,7 +830,10 @@ void accounts::rankrep(uint64_t start_val, uint64_t chunk, uint64_t chunksize, n
   } else if (scope == organization_scope) {
     total = get_size("rep.org.sz"_n);
   }
-  if (total == 0) return;
+  if (total == 0) {
+    utils::send_op_done(get_self(), op_id);
+    return;
+  }
 
   rep_tables rep_t(get_self(), scope.value);
 
@@ -818,9 +846,12 @@ void accounts::rankrep(uint64_t start_val, uint64_t chunk, uint64_t chunksize, n
 
     uint64_t rank = utils::spline_rank(current, total);
 
-    rep_by_rep.modify(ritr, _self, [&](auto& item) {
-      item.rank = rank;
-    });
+    if (ritr->rank != rank) {
+      rep_by_rep.modify(ritr, _self, [&](auto& item) {
+        item.rank = rank;
+      });
+      mark_rank_changed(ritr->account);
+    }
 
     current++;
     count++;
@@ -828,7 +859,7 @@ void accounts::rankrep(uint64_t start_val, uint64_t chunk, uint64_t chunksize, n
   }
 
   if (ritr == rep_by_rep.end()) {
-    // Done.
+    utils::send_op_done(get_self(), op_id);
   } else {
     // recursive call
     uint64_t next_value = ritr->by_rep();
@@ -836,7 +867,7 @@ void accounts::rankrep(uint64_t start_val, uint64_t chunk, uint64_t chunksize, n
         permission_level{get_self(), "active"_n},
         get_self(),
         "rankrep"_n,
-        std::make_tuple(next_value, chunk + 1, chunksize, scope)
+        std::make_tuple(next_value, chunk + 1, chunksize, scope, op_id)
     );
 
     transaction tx;
@@ -848,15 +879,46 @@ void accounts::rankrep(uint64_t start_val, uint64_t chunk, uint64_t chunksize, n
 
 }
 
-void accounts::rankcbss() {
-  rankcbs(0, 0, 200, individual_scope);
+// records that the rep or cbs rank of an account changed, harvest picks up
+// the account from here and recalculates its contribution score
+void accounts::mark_rank_changed(name account) {
+  rank_change_tables rankchanges(get_self(), get_self().value);
+
+  // rows harvest has already read are dropped a few at a time
+  rank_cursor_tables rankcursor(contracts::harvest, contracts::harvest.value);
+  if (rankcursor.exists()) {
+    uint128_t consumed = rankcursor.get().start_key;
+    auto changes_by_updated = rankchanges.get_index<"byupdated"_n>();
+    auto citr = changes_by_updated.begin();
+    uint64_t count = 0;
+    while (citr != changes_by_updated.end() && citr->by_updated() < consumed && citr->account != account && count < 2) {
+      citr = changes_by_updated.erase(citr);
+      count++;
+    }
+  }
+
+  auto ritr = rankchanges.find(account.value);
+  if (ritr == rankchanges.end()) {
+    rankchanges.emplace(_self, [&](auto& item) {
+      item.account = account;
+      item.updated_at = eosio::current_time_point().sec_since_epoch();
+    });
+  } else {
+    rankchanges.modify(ritr, _self, [&](auto& item) {
+      item.updated_at = eosio::current_time_point().sec_since_epoch();
+    });
+  }
+}
+
+void accounts::rankcbss(eosio::binary_extension<name> op_id) {
+  rankcbs(0, 0, 200, individual_scope, op_id);
 }
 
-void accounts::rankorgcbss() {
-  rankcbs(0, 0, 200, organization_scope);
+void accounts::rankorgcbss(eosio::binary_extension<name> op_id) {
+  rankcbs(0, 0, 200, organization_scope, op_id);
 }
 
-void accounts::rankcbs(uint64_t start_val, uint64_t chunk, uint64_t chunksize, name scope) {
+void accounts::rankcbs(uint64_t start_val, uint64_t chunk, uint64_t chunksize, name scope, eosio::binary_extension<name> op_id) {
   require_auth(_self);
 
   uint64_t total = 0;
@@ -866,7 +928,10 @@ void accounts::rankcbs(uint64_t start_val, uint64_t chunk, uint64_t chunksize, n
   } else {
     total = get_size("cbs.org.sz"_n);
   }
-  if (total == 0) return;
+  if (total == 0) {
+    utils::send_op_done(get_self(), op_id);
+    return;
+  }
 
   cbs_tables cbs_t(get_self(), scope.value);
 
@@ -879,9 +944,12 @@ void accounts::rankcbs(uint64_t start_val, uint64_t chunk, uint64_t chunksize, n
 
     uint64_t rank = utils::spline_rank(current, total);
 
-    cbs_by_cbs.modify(citr, _self, [&](auto& item) {
-      item.rank = rank;
-    });
+    if (citr->rank != rank) {
+      cbs_by_cbs.modify(citr, _self, [&](auto& item) {
+        item.rank = rank;
+      });
+      mark_rank_changed(citr->account);
+    }
 
     current++;
     count++;
@@ -889,7 +957,7 @@ void accounts::rankcbs(uint64_t start_val, uint64_t chunk, uint64_t chunksize, n
   }
 
   if (citr == cbs_by_cbs.end()) {
-    // Done.
+    utils::send_op_done(get_self(), op_id);
   } else {
     // recursive call
     uint64_t next_value = citr->by_cbs();
@@ -897,7 +965,7 @@ void accounts::rankcbs(uint64_t start_val, uint64_t chunk, uint64_t chunksize, n
         permission_level{get_self(), "active"_n},
         get_self(),
         "rankcbs"_n,
-        std::make_tuple(next_value, chunk + 1, chunksize, scope)
+        std::make_tuple(next_value, chunk + 1, chunksize, scope, op_id)
     );
 
     transaction tx;
@@ -919,6 +987,8 @@ void accounts::add_rep_item(name account, uint64_t reputation, name scope) {
     item.rep = reputation;
   });
 
+  utils::score_bucket_change(get_self(), rep_buckets_for(scope), reputation, 1, true);
+
   if (scope == individual_scope) {
     size_change("rep.sz"_n, 1);
   } else if (scope == organization_scope) {
@@ -998,11 +1068,47 @@ void accounts::testremove(name user)
     std::make_tuple(user, false)
   ).send();
 
+  remove_rank_rows(user, get_scope(uitr->type));
+
   users.erase(uitr);
   size_change("users.sz"_n, -1);
+
+  auto citr = usercore.find(user.value);
+  if (citr != usercore.end()) {
+    usercore.erase(citr);
+  }
   
 }
 
+// drops the rep and cbs rows of a removed user, harvest then drops its contribution score
+void accounts::remove_rank_rows(name user, name scope) {
+  rep_tables rep_t(get_self(), scope.value);
+  auto ritr = rep_t.find(user.value);
+  if (ritr != rep_t.end()) {
+    utils::score_bucket_change(get_self(), rep_buckets_for(scope), ritr->rep, -1, true);
+    rep_t.erase(ritr);
+    if (scope == individual_scope) {
+      size_change("rep.sz"_n, -1);
+    } else if (scope == organization_scope) {
+      size_change("rep.org.sz"_n, -1);
+    }
+  }
+
+  cbs_tables cbs_t(get_self(), scope.value);
+  auto citr = cbs_t.find(user.value);
+  if (citr != cbs_t.end()) {
+    utils::score_bucket_change(get_self(), cbs_buckets_for(scope), citr->community_building_score, -1, true);
+    cbs_t.erase(citr);
+    if (scope == individual_scope) {
+      size_change("cbs.sz"_n, -1);
+    } else if (scope == organization_scope) {
+      size_change("cbs.org.sz"_n, -1);
+    }
+  }
+
+  mark_rank_changed(user);
+}
+
 void accounts::testsetrep(name user, uint64_t amount) {
   require_auth(get_self());
 
@@ -1021,9 +1127,11 @@ void accounts::testsetrep(name user, uint64_t amount) {
   if (ritr == rep_t.end()) {
     add_rep_item(user, amount, scope);
   } else {
+    utils::score_bucket_change(get_self(), rep_buckets_for(scope), ritr->rep, -1, true);
     rep_t.modify(ritr, _self, [&](auto& item) {
       item.rep = amount;
     });
+    utils::score_bucket_change(get_self(), rep_buckets_for(scope), amount, 1, true);
   }
 }
 
@@ -1045,6 +1153,7 @@ void accounts::testsetrs(name user, uint64_t amount) {
       item.account = user;
       item.rank = amount;
     });
+    utils::score_bucket_change(get_self(), rep_buckets_for(scope), 0, 1, true);
     if (scope == individual_scope) {
       size_change("rep.sz"_n, 1);
     } else if (scope == organization_scope) {
@@ -1055,6 +1164,7 @@ void accounts::testsetrs(name user, uint64_t amount) {
       item.rank = amount;
     });
   }
+  mark_rank_changed(user);
 }
 
 void accounts::send_add_cbs_org (name user, uint64_t amount) {
@@ -1085,15 +1195,18 @@ void accounts::testsetcbs(name user, uint64_t amount) {
       item.community_building_score = amount;
       item.rank = 0;
     });
+    utils::score_bucket_change(get_self(), cbs_buckets_for(scope), amount, 1, true);
     if (scope == individual_scope) {
       size_change("cbs.sz"_n, 1);
     } else {
       size_change("cbs.org.sz"_n, 1);
     }
   } else {
+    utils::score_bucket_change(get_self(), cbs_buckets_for(scope), citr->community_building_score, -1, true);
     cbs_t.modify(citr, _self, [&](auto& item) {
       item.community_building_score = amount;
     });
+    utils::score_bucket_change(get_self(), cbs_buckets_for(scope), amount, 1, true);
   }
 }
 
@@ -1432,77 +1545,48 @@ void accounts::send_eval_demote (name to) {
 
 }
 
+// start_val, chunk and chunksize are unused - the histogram skips to the account's bucket,
+// kept in the signature for deferred evaldemote actions already scheduled
 void accounts::evaldemote (name to, uint64_t start_val, uint64_t chunk, uint64_t chunksize) {
   require_auth(get_self());
 
-  auto uritr = rep.find(to.value);
-  if (uritr == rep.end()) {
+  auto ritr = rep.find(to.value);
+  if (ritr == rep.end()) {
     updatestatus(to, visitor);
     return;
   }
 
-  uint64_t total = get_size("rep.sz"_n);
-  if (total == 0) return;
-
-  uint64_t current = chunk * chunksize;
-  auto rep_by_rep = rep.get_index<"byrep"_n>();
-  auto ritr = start_val == 0 ? rep_by_rep.begin() : rep_by_rep.lower_bound(start_val);
-  uint64_t count = 0;
-  bool evaluated = false;
-
-  while (ritr != rep_by_rep.end() && count < chunksize) {
-
-    if (ritr->account == to) {
-      uint64_t rank = utils::spline_rank(current, total);
+  // status changes need the exact position in the rep ordering, the rep histogram keeps
+  // the rows per score so it is found without walking the rows of the account's bucket
+  uint64_t rank = utils::score_bucket_rank(get_self(), rep_buckets, ritr->rep, true);
 
-      rep_by_rep.modify(ritr, _self, [&](auto& item) {
-        item.rank = rank;
-      });
-
-      auto uitr = users.find(ritr->account.value);
-
-      uint64_t min_rep_score_citizen = config_get("cit.rep.sc"_n);
-      uint64_t min_rep_score_resident = config_get("res.rep.pt"_n);
-
-      name current_rank = uitr->status;
+  if (ritr->rank != rank) {
+    rep.modify(ritr, _self, [&](auto& item) {
+      item.rank = rank;
+    });
+    mark_rank_changed(to);
+  }
 
-      if (rank < min_rep_score_resident) {
-        current_rank = visitor;
-      } else if (rank < min_rep_score_citizen) {
-        current_rank = resident;
-      } else {
-        current_rank = citizen;
-      }
+  auto uitr = users.find(to.value);
 
-      if (uitr->status == citizen && current_rank != citizen) {
-        updatestatus(uitr->account, current_rank);
-      }
-      else if (uitr->status == resident && current_rank == visitor) {
-        updatestatus(uitr->account, visitor);
-      }
+  uint64_t min_rep_score_citizen = config_get("cit.rep.sc"_n);
+  uint64_t min_rep_score_resident = config_get("res.rep.pt"_n);
 
-      evaluated = true;
-      break;
-    }
+  name current_rank = uitr->status;
 
-    current++;
-    count++;
-    ritr++;
+  if (rank < min_rep_score_resident) {
+    current_rank = visitor;
+  } else if (rank < min_rep_score_citizen) {
+    current_rank = resident;
+  } else {
+    current_rank = citizen;
   }
 
-  if (!evaluated && ritr != rep_by_rep.end()) {
-    uint64_t next_value = ritr->by_rep();
-    action next_execution(
-      permission_level{get_self(), "active"_n},
-      get_self(),
-      "evaldemote"_n,
-      std::make_tuple(to, next_value, chunk + 1, chunksize)
-    );
-
-    transaction tx;
-    tx.actions.emplace_back(next_execution);
-    tx.delay_sec = 1;
-    tx.send(next_value + 1, _self);
+  if (uitr->status == citizen && current_rank != citizen) {
+    updatestatus(uitr->account, current_rank);
+  }
+  else if (uitr->status == resident && current_rank == visitor) {
+    updatestatus(uitr->account, visitor);
   }
 
 }
@@ -1640,4 +1724,100 @@ ACTION accounts::migflags(name to) {
   }
 }
 
+ACTION accounts::migbuckets(name scope, name index, uint64_t start, uint64_t chunksize) {
+  require_auth(get_self());
+
+  check(scope == individual_scope || scope == organization_scope, "invalid scope");
+  check(index == "rep"_n || index == "cbs"_n, "index must be rep or cbs");
+
+  name buckets = index == "rep"_n ? rep_buckets_for(scope) : cbs_buckets_for(scope);
+
+  if (start == 0) {
+    utils::delete_table<score_bucket_tables>(get_self(), buckets.value);
+    utils::delete_table<score_count_tables>(get_self(), buckets.value);
+  }
+
+  uint64_t next = 0;
+  uint64_t count = 0;
 
+  if (index == "rep"_n) {
+    rep_tables rep_t(get_self(), scope.value);
+    auto ritr = rep_t.lower_bound(start);
+    while (ritr != rep_t.end() && count < chunksize) {
+      utils::score_bucket_change(get_self(), buckets, ritr->rep, 1, true);
+      ritr++;
+      count++;
+    }
+    if (ritr != rep_t.end()) { next = ritr->account.value; }
+  } else {
+    cbs_tables cbs_t(get_self(), scope.value);
+    auto citr = cbs_t.lower_bound(start);
+    while (citr != cbs_t.end() && count < chunksize) {
+      utils::score_bucket_change(get_self(), buckets, citr->community_building_score, 1, true);
+      citr++;
+      count++;
+    }
+    if (citr != cbs_t.end()) { next = citr->account.value; }
+  }
+
+  if (next != 0) {
+    action next_execution(
+      permission_level{get_self(), "active"_n},
+      get_self(),
+      "migbuckets"_n,
+      std::make_tuple(scope, index, next, chunksize)
+    );
+
+    transaction tx;
+    tx.actions.emplace_back(next_execution);
+    tx.delay_sec = 1;
+    tx.send(next + buckets.value, _self);
+  }
+}
+
+void accounts::set_user_core(name account, name status, name type, uint64_t timestamp) {
+  auto citr = usercore.find(account.value);
+  if (citr == usercore.end()) {
+    usercore.emplace(_self, [&](auto& item) {
+      item.account = account;
+      item.status = status;
+      item.type = type;
+      item.timestamp = timestamp;
+    });
+  } else {
+    usercore.modify(citr, _self, [&](auto& item) {
+      item.status = status;
+      item.type = type;
+      item.timestamp = timestamp;
+    });
+  }
+}
+
+// copies status and type of users added before the usercore table existed
+ACTION accounts::migusercore(uint64_t start, uint64_t chunksize) {
+  require_auth(get_self());
+
+  auto uitr = users.lower_bound(start);
+  uint64_t count = 0;
+
+  while (uitr != users.end() && count < chunksize) {
+    set_user_core(uitr->account, uitr->status, uitr->type, uitr->timestamp);
+    uitr++;
+    count++;
+  }
+
+  if (uitr != users.end()) {
+    uint64_t next_value = uitr->account.value;
+    action next_execution(
+      permission_level{get_self(), "active"_n},
+      get_self(),
+      "migusercore"_n,
+      std::make_tuple(next_value, chunksize)
+    );
+
+    transaction tx;
+    tx.actions.emplace_back(next_execution);
+    tx.delay_sec = 1;
+    tx.send(next_value, _self);
+  }
+}
@@ -2,6 +2,7 @@
 
 #include <proposals/proposals_factory.hpp>
 
+#include "proposals/proposal_args.cpp"
 #include "proposals/proposals_base.cpp"
 #include "proposals/referendums_settings.cpp"
 #include "proposals/proposal_alliance.cpp"
@@ -25,6 +26,12 @@ ACTION dao::reset () {
       vitr = votes_t.erase(vitr);
     }
 
+    delegation_exclusion_tables exclusions_t(get_self(), ritr->proposal_id);
+    auto eitr = exclusions_t.begin();
+    while (eitr != exclusions_t.end()) {
+      eitr = exclusions_t.erase(eitr);
+    }
+
     ritr = proposals_t.erase(ritr);
   }
 
@@ -46,8 +53,19 @@ ACTION dao::reset () {
     while (ditr != delegate_t.end()) {
       ditr = delegate_t.erase(ditr);
     }
+
+    delegated_voice_tables delegvoice_t(get_self(), s.value);
+    auto dvitr = delegvoice_t.begin();
+    while (dvitr != delegvoice_t.end()) {
+      dvitr = delegvoice_t.erase(dvitr);
+    }
   }
 
+  delegation_state_tables delegstate_t(get_self(), get_self().value);
+  delegation_state_table delegstate = delegstate_t.get_or_create(get_self(), delegation_state_table());
+  delegstate.ready = true;
+  delegstate_t.set(delegstate, get_self());
+
   for (auto & fund_type : fund_types) {
     support_level_tables support_t(get_self(), fund_type.value);
     auto fitr = support_t.begin();
@@ -126,6 +144,21 @@ ACTION dao::reset () {
 
   cycle_tables cycle_t(get_self(), get_self().value);
   cycle_t.remove();
+
+  decay_rate_tables decayrates_t(get_self(), get_self().value);
+  auto dritr = decayrates_t.begin();
+  while (dritr != decayrates_t.end()) {
+    dritr = decayrates_t.erase(dritr);
+  }
+
+  eval_cursor_tables evalcursor_t(get_self(), get_self().value);
+  evalcursor_t.remove();
+
+  eval_skip_tables evalskips_t(get_self(), get_self().value);
+  auto esitr = evalskips_t.begin();
+  while (esitr != evalskips_t.end()) {
+    esitr = evalskips_t.erase(esitr);
+  }
 }
 
 ACTION dao::initcycle (const uint64_t & cycle_id) {
@@ -160,60 +193,80 @@ ACTION dao::initsz() {
 }
 
 ACTION dao::create (std::map<std::string, VariantValue> & args) {
+  ProposalArgs pargs = ProposalArgs::from_map(args);
+  createprop(pargs);
+}
+
+ACTION dao::update (std::map<std::string, VariantValue> & args) {
+  ProposalArgs pargs = ProposalArgs::from_map(args);
+  updateprop(pargs);
+}
+
+ACTION dao::cancel (std::map<std::string, VariantValue> & args) {
+  ProposalArgs pargs = ProposalArgs::from_map(args);
+  cancelprop(pargs);
+}
+
+ACTION dao::callback (std::map<std::string, VariantValue> & args) {
+  ProposalArgs pargs = ProposalArgs::from_map(args);
+  callbackprop(pargs);
+}
 
-  name creator = std::get<name>(args["creator"]);
-  name type = std::get<name>(args["type"]);
+ACTION dao::createprop (ProposalArgs & args) {
 
-  require_auth(creator);
+  args.require(ProposalArgs::f_creator, "creator");
+  args.require(ProposalArgs::f_type, "type");
+
+  require_auth(args.creator);
   check_attributes(args);
 
-  std::unique_ptr<Proposal> prop = std::unique_ptr<Proposal>(ProposalsFactory::Factory(*this, type));
+  ProposalsFactory prop(*this, args.type);
 
   prop->create(args);
 
 }
 
-ACTION dao::update (std::map<std::string, VariantValue> & args) {
+ACTION dao::updateprop (ProposalArgs & args) {
 
-  uint64_t proposal_id = std::get<uint64_t>(args["proposal_id"]);
+  args.require(ProposalArgs::f_proposal_id, "proposal_id");
 
   proposal_tables proposals_t(get_self(), get_self().value);
-  auto ritr = proposals_t.require_find(proposal_id, "proposal not found");
+  auto ritr = proposals_t.require_find(args.proposal_id, "proposal not found");
 
   require_auth(ritr->creator);
   check_attributes(args);
 
-  std::unique_ptr<Proposal> prop = std::unique_ptr<Proposal>(ProposalsFactory::Factory(*this, ritr->type));
+  ProposalsFactory prop(*this, ritr->type);
 
   prop->update(args);
 
 }
 
-ACTION dao::cancel (std::map<std::string, VariantValue> & args) {
+ACTION dao::cancelprop (ProposalArgs & args) {
 
-  uint64_t proposal_id = std::get<uint64_t>(args["proposal_id"]);
+  args.require(ProposalArgs::f_proposal_id, "proposal_id");
 
   proposal_tables proposals_t(get_self(), get_self().value);
-  auto pitr = proposals_t.require_find(proposal_id, "proposal not found");
+  auto pitr = proposals_t.require_find(args.proposal_id, "proposal not found");
 
   require_auth(pitr->creator);
 
-  std::unique_ptr<Proposal> prop = std::unique_ptr<Proposal>(ProposalsFactory::Factory(*this, pitr->type));
+  ProposalsFactory prop(*this, pitr->type);
 
   prop->cancel(args);
 
 }
 
-ACTION dao::callback (std::map<std::string, VariantValue> & args) {
+ACTION dao::callbackprop (ProposalArgs & args) {
 
   require_auth(get_self());
 
-  uint64_t proposal_id = std::get<uint64_t>(args["proposal_id"]);
+  args.require(ProposalArgs::f_proposal_id, "proposal_id");
 
   proposal_tables proposals_t(get_self(), get_self().value);
-  auto pitr = proposals_t.require_find(proposal_id, "proposal not found");
+  auto pitr = proposals_t.require_find(args.proposal_id, "proposal not found");
 
-  std::unique_ptr<Proposal> prop = std::unique_ptr<Proposal>(ProposalsFactory::Factory(*this, pitr->type));
+  ProposalsFactory prop(*this, pitr->type);
 
   prop->callback(args);
 
@@ -244,13 +297,11 @@ ACTION dao::stake (const name & from, const name & to, const asset & quantity, c
     proposal_tables proposals_t(get_self(), get_self().value);
     auto pitr = proposals_t.require_find(proposal_id, "proposal not found");
 
-    std::unique_ptr<Proposal> prop = std::unique_ptr<Proposal>(ProposalsFactory::Factory(*this, pitr->type));
+    ProposalsFactory prop(*this, pitr->type);
 
-    std::map<std::string, VariantValue> args = {
-      { "from", from },
-      { "quantity", quantity },
-      { "proposal_id", proposal_id }
-    };
+    ProposalArgs args;
+    args.proposal_id = proposal_id;
+    args.quantity = quantity;
 
     prop->stake(args);
 
@@ -265,14 +316,13 @@ ACTION dao::evaluate (const uint64_t & proposal_id, const uint64_t & propcycle)
   proposal_tables proposals_t(get_self(), get_self().value);
   auto ritr = proposals_t.require_find(proposal_id, "proposal not found");
 
-  std::unique_ptr<Proposal> ref = std::unique_ptr<Proposal>(ProposalsFactory::Factory(*this, ritr->type));
+  ProposalsFactory ref(*this, ritr->type);
 
-  std::map<string, VariantValue> args = {
-    { string("proposal_id"), proposal_id },
-    { string("propcycle"), propcycle }
-  };
+  ProposalArgs args;
+  args.proposal_id = proposal_id;
+  args.propcycle = propcycle;
 
-  ref->evaluate(args);
+  ref.evaluate(args);
 
 }
 
@@ -284,36 +334,35 @@ ACTION dao::onperiod () {
   cycle_table c = cycle_t.get_or_create(get_self(), cycle_table());
 
   proposal_tables proposals_t(get_self(), get_self().value);
-  auto referendums_by_stage_id = proposals_t.get_index<"bystageid"_n>();
 
-  auto staged_itr = referendums_by_stage_id.lower_bound(uint128_t(ProposalsCommon::stage_staged.value) << 64);
-  while (staged_itr != referendums_by_stage_id.end() && staged_itr->stage == ProposalsCommon::stage_staged) {
-    send_deferred_transaction(
-      permission_level(get_self(), "active"_n),
-      get_self(),
-      "evaluate"_n,
-      std::make_tuple(staged_itr->proposal_id, c.propcycle)
-    );
-    staged_itr++;
-  }
+  eval_cursor_tables evalcursor_t(get_self(), get_self().value);
+  eval_cursor_table ec = evalcursor_t.get_or_default();
 
-  auto active_itr = referendums_by_stage_id.lower_bound(uint128_t(ProposalsCommon::stage_active.value) << 64);
-  while (active_itr != referendums_by_stage_id.end() && active_itr->stage == ProposalsCommon::stage_active) {
-    send_deferred_transaction(
-      permission_level(get_self(), "active"_n),
-      get_self(),
-      "evaluate"_n,
-      std::make_tuple(active_itr->proposal_id, c.propcycle)
-    );
-    active_itr++;
+  // an evaluation that has not finished does not hold up the new cycle, the proposals
+  // it did not reach keep their stage and are evaluated along with the new cycle's
+  if (ec.stage != name()) {
+    record_eval_skip(ec);
   }
 
+  ec.propcycle = c.propcycle;
+  ec.stage = ProposalsCommon::stage_active;
+  ec.next_id = 0;
+  ec.max_id = proposals_t.available_primary_key();
+  evalcursor_t.set(ec, get_self());
+
   c.propcycle += 1;
   c.t_onperiod = current_time_point().sec_since_epoch();
   cycle_t.set(c, get_self());
 
   init_cycle_new_stats();
 
+  send_deferred_transaction(
+    permission_level(get_self(), "active"_n),
+    get_self(),
+    "evalprops"_n,
+    std::make_tuple()
+  );
+
   send_deferred_transaction(
     permission_level(get_self(), "active"_n),
     get_self(),
@@ -332,6 +381,144 @@ ACTION dao::onperiod () {
 
 }
 
+// Evaluates the proposals queued by onperiod, prop.evl.bch per transaction.
+// Active proposals go first so the ones a staged evaluation activates are not
+// evaluated again in the same cycle.
+ACTION dao::evalprops () {
+
+  require_auth(get_self());
+
+  eval_cursor_tables evalcursor_t(get_self(), get_self().value);
+  eval_cursor_table ec = evalcursor_t.get_or_default();
+
+  if (ec.stage == name()) { return; }
+
+  uint64_t batch_size = config_get("prop.evl.bch"_n);
+  uint64_t count = 0;
+
+  uint64_t proposal_id;
+  name type;
+
+  while (count < batch_size && next_eval_proposal(ec, proposal_id, type)) {
+    ec.next_id = proposal_id + 1;
+
+    ProposalArgs args;
+    args.proposal_id = proposal_id;
+    args.propcycle = ec.propcycle;
+
+    ProposalsFactory handler(*this, type);
+    handler.evaluate(args);
+    count++;
+  }
+
+  evalcursor_t.set(ec, get_self());
+
+  if (ec.stage != name()) {
+    send_deferred_transaction(
+      permission_level(get_self(), "active"_n),
+      get_self(),
+      "evalprops"_n,
+      std::make_tuple()
+    );
+  }
+
+}
+
+// Moves the evaluation past a proposal whose evaluation fails, evalprops would otherwise stop at it every cycle.
+ACTION dao::skipeval (const uint64_t & proposal_id) {
+
+  require_auth(get_self());
+
+  eval_cursor_tables evalcursor_t(get_self(), get_self().value);
+  eval_cursor_table ec = evalcursor_t.get_or_default();
+
+  uint64_t next_id;
+  name type;
+
+  check(next_eval_proposal(ec, next_id, type), "no proposals left to evaluate");
+  check(next_id == proposal_id, "proposal " + std::to_string(proposal_id) + " is not the next to evaluate, next is " + std::to_string(next_id));
+
+  print("skipping evaluation of proposal ", proposal_id, " in cycle ", ec.propcycle);
+
+  ec.next_id = proposal_id + 1;
+  evalcursor_t.set(ec, get_self());
+
+  send_deferred_transaction(
+    permission_level(get_self(), "active"_n),
+    get_self(),
+    "evalprops"_n,
+    std::make_tuple()
+  );
+
+}
+
+void dao::record_eval_skip (const eval_cursor_table & ec) {
+
+  print("abandoning evaluation of cycle ", ec.propcycle, " at proposal ", ec.next_id, " in stage ", ec.stage);
+
+  eval_skip_tables evalskips_t(get_self(), get_self().value);
+  auto esitr = evalskips_t.find(ec.propcycle);
+
+  if (esitr == evalskips_t.end()) {
+    evalskips_t.emplace(_self, [&](auto & item){
+      item.propcycle = ec.propcycle;
+      item.stage = ec.stage;
+      item.next_id = ec.next_id;
+      item.max_id = ec.max_id;
+      item.skipped_at = current_time_point().sec_since_epoch();
+    });
+  } else {
+    evalskips_t.modify(esitr, _self, [&](auto & item){
+      item.stage = ec.stage;
+      item.next_id = ec.next_id;
+      item.max_id = ec.max_id;
+      item.skipped_at = current_time_point().sec_since_epoch();
+    });
+  }
+
+}
+
+// Finds the next proposal evalprops has to evaluate, moving the cursor to the next stage when one is done.
+bool dao::next_eval_proposal (eval_cursor_table & ec, uint64_t & proposal_id, name & type) {
+
+  proposal_tables proposals_t(get_self(), get_self().value);
+  auto proposals_by_stage_id = proposals_t.get_index<"bystageid"_n>();
+
+  while (ec.stage != name()) {
+    auto pitr = proposals_by_stage_id.lower_bound((uint128_t(ec.stage.value) << 64) + ec.next_id);
+
+    if (pitr == proposals_by_stage_id.end() || pitr->stage != ec.stage || pitr->proposal_id >= ec.max_id) {
+      ec.stage = ec.stage == ProposalsCommon::stage_active ? ProposalsCommon::stage_staged : name();
+      ec.next_id = 0;
+      continue;
+    }
+
+    proposal_id = pitr->proposal_id;
+    type = pitr->type;
+    return true;
+  }
+
+  return false;
+}
+
+bool dao::get_support_level (const name & type, const uint64_t & propcycle, support_level_table & support) {
+
+  auto citr = support_cache.find(type.value);
+  if (citr != support_cache.end() && citr->second.propcycle == propcycle) {
+    support = citr->second;
+    return true;
+  }
+
+  support_level_tables support_t(get_self(), type.value);
+  auto sitr = support_t.find(propcycle);
+
+  if (sitr == support_t.end()) { return false; }
+
+  support = *sitr;
+  support_cache[type.value] = support;
+  return true;
+}
+
 
 
 // ==================================================================== //
@@ -417,27 +604,10 @@ ACTION dao::revertvote (const name & voter, const uint64_t & proposal_id) {
 
   check(pitr->stage == ProposalsCommon::stage_active, "proposal is not in stage active");
   check(vitr->favour == true && amount > 0, "only trust votes can be changed");
-  
-  votes_t.modify(vitr, _self, [&](auto& item) {
-    item.favour = false;
-  });
 
-  proposals_t.modify(pitr, _self, [&](auto& item) {
-    item.against += amount;
-    item.favour -= amount;
-  });
+  ProposalsFactory prop(*this, pitr->type);
 
-  std::unique_ptr<Proposal> prop = std::unique_ptr<Proposal>(ProposalsFactory::Factory(*this, pitr->type));
-  name scope = prop->get_scope();
-
-  if (has_delegates(voter, scope)) {
-    send_inline_action(
-      permission_level(get_self(), "active"_n),
-      get_self(), 
-      "mimicrevert"_n,
-      std::make_tuple(voter, (uint64_t)0, scope, proposal_id, (uint64_t)30)
-    );
-  }
+  revert_trust_vote(voter, proposal_id, prop->get_scope());
 
 }
 
@@ -544,49 +714,68 @@ ACTION dao::votedhos (const name & account, std::vector<DhoVote> votes) {
 
   dho_tables dho_t(get_self(), get_self().value);
 
+  cs_points_tables cs_t(contracts::harvest, contracts::harvest.value);
+  auto csitr = cs_t.require_find(account.value, "contribution score not found");
+
+  // using the rank so the percentages don't get canceled due to low percentage and low rep multiplier
+  uint64_t multiplier = csitr->rank;
+
+  std::map<uint64_t, uint64_t> new_points_by_dho;
+  uint64_t total_percentage = 0;
+
+  for (auto & vote : votes) {
+    dho_t.require_find(vote.dho.value, ("dho " + vote.dho.to_string() + " not found").c_str());
+    new_points_by_dho[vote.dho.value] += vote.points * multiplier;
+    total_percentage += vote.points;
+  }
+
+  check(total_percentage == 100, "the total votes have to sum up to 100%");
+
+  int64_t total_old = 0;
+  int64_t total_new = 0;
+  uint64_t now = current_time_point().sec_since_epoch();
+
   dho_vote_tables voted_t(get_self(), get_self().value);
   auto voted_by_account = voted_t.get_index<"byacctid"_n>();
   auto vitr = voted_by_account.lower_bound(uint128_t(account.value) << 64);
 
-  int64_t total_old = 0;
-
+  // only the allocations that changed touch the dhos table, kept votes are
+  // refreshed in place so they don't expire
   while (vitr != voted_by_account.end() && vitr->account == account) {
 
-    auto ditr = dho_t.find(vitr->dho.value);
+    total_old += vitr->points;
+    auto nitr = new_points_by_dho.find(vitr->dho.value);
 
-    if (ditr != dho_t.end()) {
-      dho_t.modify(ditr, _self, [&](auto & item){
-        item.points -= vitr->points;
-      });
+    if (nitr == new_points_by_dho.end()) {
+      change_dho_points(dho_t, vitr->dho, -1 * int64_t(vitr->points));
+      vitr = voted_by_account.erase(vitr);
+      continue;
     }
 
-    print("erasing vote for dho: ", vitr->dho, ", points: ", vitr->points, "\n");
-
-    total_old += vitr->points;
-    vitr = voted_by_account.erase(vitr);
-
-  }
+    uint64_t new_points = nitr->second;
+    if (new_points != vitr->points) {
+      change_dho_points(dho_t, vitr->dho, int64_t(new_points) - int64_t(vitr->points));
+    }
 
-  int64_t total_new = 0;
-  uint64_t total_percentage = 0;
-  uint64_t now = current_time_point().sec_since_epoch();
+    voted_by_account.modify(vitr, _self, [&](auto & item){
+      item.points = new_points;
+      item.timestamp = now;
+    });
 
-  cs_points_tables cs_t(contracts::harvest, contracts::harvest.value);
-  auto csitr = cs_t.require_find(account.value, "contribution score not found");
+    total_new += new_points;
+    new_points_by_dho.erase(nitr);
+    vitr++;
 
-  // using the rank so the percentages don't get canceled due to low percentage and low rep multiplier
-  uint64_t multiplier = csitr->rank;
+  }
 
   for (auto & vote : votes) {
 
-    uint64_t new_points = vote.points * multiplier;
+    auto nitr = new_points_by_dho.find(vote.dho.value);
+    if (nitr == new_points_by_dho.end()) { continue; }
 
-    auto ditr = dho_t.require_find(vote.dho.value, ("dho " + vote.dho.to_string() + " not found").c_str());
+    uint64_t new_points = nitr->second;
+    change_dho_points(dho_t, vote.dho, int64_t(new_points));
 
-    dho_t.modify(ditr, _self, [&](auto & item){
-      item.points += new_points;
-    });
-    
     voted_t.emplace(_self, [&](auto & item){
       item.vote_id = voted_t.available_primary_key();
       item.account = account;
@@ -594,14 +783,12 @@ ACTION dao::votedhos (const name & account, std::vector<DhoVote> votes) {
       item.points = new_points;
       item.timestamp = now;
     });
-    
+
     total_new += new_points;
-    total_percentage += vote.points;
+    new_points_by_dho.erase(nitr);
 
   }
 
-  check(total_percentage == 100, "the total votes have to sum up to 100%");
-
   print("updating size:\n");
   print("total old: ", total_old, "\n");
   print("total new: ", total_new, "\n");
@@ -643,23 +830,24 @@ ACTION dao::dhocleanvote (const uint64_t & cutoff, const uint64_t & chunksize) {
   uint64_t count = 0;
   int64_t total_removed = 0;
 
-  dho_tables dho_t(get_self(), get_self().value);
+  // expired votes come first in the timestamp index, the dhos they point to
+  // are updated once per batch
+  std::map<uint64_t, int64_t> removed_by_dho;
 
   while (vitr != votes_by_timestamp.end() && cutoff > vitr->timestamp && count < chunksize) {
 
     total_removed += vitr->points;
-
-    auto ditr = dho_t.find(vitr->dho.value);
-    if (ditr != dho_t.end()) {
-      dho_t.modify(ditr, _self, [&](auto & item){
-        item.points -= vitr->points;
-      });
-    }
+    removed_by_dho[vitr->dho.value] += vitr->points;
 
     vitr = votes_by_timestamp.erase(vitr);
     count++;
   }
 
+  dho_tables dho_t(get_self(), get_self().value);
+  for (const auto & [dho, removed] : removed_by_dho) {
+    change_dho_points(dho_t, name(dho), -1 * removed);
+  }
+
   size_change(dhos_vote_size, -1 * total_removed);
 
   if (vitr != votes_by_timestamp.end() && cutoff > vitr->timestamp) {
@@ -706,22 +894,53 @@ ACTION dao::dhocalcdists () {
   if (total_valid_points == 0) return;
 
   dho_share_tables shares_t(get_self(), get_self().value);
-  
+
+  std::set<uint64_t> valid_names;
+  for (auto & valid_dho : valid_dhos) {
+    valid_names.insert(valid_dho.dho.value);
+  }
+
   auto sitr = shares_t.begin();
   while (sitr != shares_t.end()) {
-    sitr = shares_t.erase(sitr);
+    if (valid_names.count(sitr->dho.value) == 0) {
+      sitr = shares_t.erase(sitr);
+    } else {
+      sitr++;
+    }
   }
 
   for (auto & valid_dho : valid_dhos) {
-    shares_t.emplace(_self, [&](auto & item){
-      item.dho = valid_dho.dho;
-      item.total_percentage = double(valid_dho.points) / total_points;
-      item.dist_percentage = double(valid_dho.points) / total_valid_points;
-    });
+    double total_percentage = double(valid_dho.points) / total_points;
+    double dist_percentage = double(valid_dho.points) / total_valid_points;
+
+    auto shitr = shares_t.find(valid_dho.dho.value);
+    if (shitr == shares_t.end()) {
+      shares_t.emplace(_self, [&](auto & item){
+        item.dho = valid_dho.dho;
+        item.total_percentage = total_percentage;
+        item.dist_percentage = dist_percentage;
+      });
+    } else if (shitr->total_percentage != total_percentage || shitr->dist_percentage != dist_percentage) {
+      shares_t.modify(shitr, _self, [&](auto & item){
+        item.total_percentage = total_percentage;
+        item.dist_percentage = dist_percentage;
+      });
+    }
   }
 
 }
 
+void dao::change_dho_points (dho_tables & dho_t, const name & dho, const int64_t & delta) {
+
+  auto ditr = dho_t.find(dho.value);
+  if (ditr == dho_t.end()) { return; }
+
+  dho_t.modify(ditr, _self, [&](auto & item){
+    item.points += delta;
+  });
+
+}
+
 void dao::vote_aux (const name & voter, const uint64_t & proposal_id, const uint64_t & amount, const name & option, const bool & is_delegated) {
 
   proposal_tables proposals_t(get_self(), get_self().value);
@@ -731,14 +950,36 @@ void dao::vote_aux (const name & voter, const uint64_t & proposal_id, const uint
   auto vitr = votes_t.find(voter.value);
   check(vitr == votes_t.end(), "only one vote");
 
-  std::unique_ptr<Proposal> prop = std::unique_ptr<Proposal>(ProposalsFactory::Factory(*this, pitr->type));
+  ProposalsFactory prop(*this, pitr->type);
   prop->check_can_vote(pitr->status, pitr->stage);
 
+  name scope = prop->get_scope();
+
+  if (!is_delegated) {
+    check(!is_trust_delegated(voter, scope), "voice is delegated, user can not vote by itself");
+  }
+
+  // reduce voice
+  double percenetage_used = voice_change(voter, amount, true, scope);
+
+  // the voice delegated to the voter is cast with the same part the voter used of its own,
+  // delegators catch up on their next settle
+  bool aggregated = delegated_voice_ready();
+  uint64_t delegated = 0;
+  double delegated_shares = 0;
+  uint64_t represented = 0;
+
+  if (aggregated) {
+    delegated = use_delegated_voice(voter, scope, proposal_id, percenetage_used, delegated_shares, represented);
+  }
+
+  uint64_t voice_cast = amount + delegated;
+
   proposals_t.modify(pitr, _self, [&](auto & item){
     if (option == ProposalsCommon::trust) {
-      item.favour += amount;  
+      item.favour += voice_cast;
     } else if (option == ProposalsCommon::distrust) {
-      item.against += amount;
+      item.against += voice_cast;
     }
   });
 
@@ -747,33 +988,32 @@ void dao::vote_aux (const name & voter, const uint64_t & proposal_id, const uint
     item.account = voter;
     item.amount = amount;
     item.favour = option == ProposalsCommon::trust;
+    if (aggregated) {
+      item.delegated = delegated;
+      item.delegated_shares = delegated_shares;
+    }
   });
 
-  // storing the number of voters per proposal in a separate scope
+  // storing the number of voters per proposal in a separate scope,
+  // the delegators whose voice went into the vote count as voters too
   size_tables sizes_t(get_self(), ProposalsCommon::vote_scope.value);
   auto sitr = sizes_t.find(proposal_id);
 
   if (sitr == sizes_t.end()) {
     sizes_t.emplace(_self, [&](auto & item){
       item.id = name(proposal_id);
-      item.size = 1;
+      item.size = 1 + represented;
     });
   } else {
     sizes_t.modify(sitr, _self, [&](auto & item){
-      item.size += 1;
+      item.size += 1 + represented;
     });
   }
 
-  // reduce voice
-  name scope = prop->get_scope();
-  double percenetage_used = voice_change(voter, amount, true, scope);
-
-  if (!is_delegated) {
-    check(!is_trust_delegated(voter, scope), "voice is delegated, user can not vote by itself");
+  if (!aggregated) {
+    send_mimic_delegatee_vote(voter, scope, proposal_id, percenetage_used, option);
   }
 
-  send_mimic_delegatee_vote(voter, scope, proposal_id, percenetage_used, option);
-
   auto rep = config_get(name("voterep2.ind"));
   double rep_multiplier = is_delegated ? config_get(name("votedel.mul")) / 100.0 : 1.0;
 
@@ -823,7 +1063,7 @@ void dao::vote_aux (const name & voter, const uint64_t & proposal_id, const uint
   // this one, maybe it should be called as a callback in the proposal's implementation?
   // because not all proposals increase the voice cast, currently only the ones that are funded
   // have an entry in the support table
-  increase_voice_cast(amount, option, prop->get_fund_type());
+  increase_voice_cast(voice_cast, option, prop->get_fund_type());
 }
 
 void dao::increase_voice_cast (const uint64_t & amount, const name & option, const name & prop_type) {
@@ -923,6 +1163,37 @@ bool dao::revert_vote (const name & voter, const uint64_t & proposal_id) {
 
 }
 
+void dao::revert_trust_vote (const name & voter, const uint64_t & proposal_id, const name & scope) {
+
+  proposal_tables proposals_t(get_self(), get_self().value);
+  auto pitr = proposals_t.require_find(proposal_id, "proposal not found");
+
+  votes_tables votes_t(get_self(), proposal_id);
+  auto vitr = votes_t.require_find(voter.value, "voter has not voted on this proposal, can't revert");
+
+  uint64_t amount = vitr->amount + vitr->delegated.value_or(0);
+  bool aggregated = vitr->delegated.has_value();
+
+  votes_t.modify(vitr, _self, [&](auto& item) {
+    item.favour = false;
+  });
+
+  proposals_t.modify(pitr, _self, [&](auto& item) {
+    item.against += amount;
+    item.favour -= amount;
+  });
+
+  if (!aggregated && has_delegates(voter, scope)) {
+    send_inline_action(
+      permission_level(get_self(), "active"_n),
+      get_self(), 
+      "mimicrevert"_n,
+      std::make_tuple(voter, (uint64_t)0, scope, proposal_id, (uint64_t)30)
+    );
+  }
+
+}
+
 bool dao::is_trust_delegated (const name & account, const name & scope) {
   delegate_trust_tables deltrust_t(get_self(), scope.value);
   auto ditr = deltrust_t.find(account.value);
@@ -1034,13 +1305,19 @@ void dao::check_citizen (const name & account) {
   check(uitr->status == name("citizen"), "user is not a citizen");
 }
 
-void dao::check_attributes (const std::map<std::string, VariantValue> & args) {
+void dao::check_attributes (const ProposalArgs & args) {
+
+  args.require(ProposalArgs::f_title, "title");
+  args.require(ProposalArgs::f_summary, "summary");
+  args.require(ProposalArgs::f_description, "description");
+  args.require(ProposalArgs::f_image, "image");
+  args.require(ProposalArgs::f_url, "url");
 
-  string title = std::get<string>(args.at("title"));
-  string summary = std::get<string>(args.at("summary"));
-  string description = std::get<string>(args.at("description"));
-  string image = std::get<string>(args.at("image"));
-  string url = std::get<string>(args.at("url"));
+  const string & title = args.title;
+  const string & summary = args.summary;
+  const string & description = args.description;
+  const string & image = args.image;
+  const string & url = args.url;
 
   check(title.size() <= 128, "title must be less or equal to 128 characters long");
   check(title.size() > 0, "must have a title");
@@ -21,11 +21,17 @@ void exchange::reset() {
   check(false, "Comment this out- safety stop. Always check in uncommented. ");
   
   sold.remove();
+  price.remove();
 
   auto pitr = payhistory.begin();
   while(pitr != payhistory.end()) {
     pitr = payhistory.erase(pitr);
   }
+
+  auto ditr = paydigests.begin();
+  while(ditr != paydigests.end()) {
+    ditr = paydigests.erase(ditr);
+  }
   
   auto ritr = rounds.begin();
   while(ritr != rounds.end()){
@@ -45,7 +51,7 @@ void exchange::reset() {
 }
 
 asset exchange::seeds_for_usd(asset usd_quantity) {
-  update_price();
+  price_table p = update_price();
 
   soldtable s = sold.get_or_create(get_self(), soldtable());
  
@@ -53,9 +59,10 @@ asset exchange::seeds_for_usd(asset usd_quantity) {
   double usd_remaining = usd_total;
   double seeds_amount = 0.0;
 
-  auto ritr = rounds.begin(); //rounds.find(p -> current_round);
+  // update_price moved the cursor to the round total_sold falls in, earlier rounds are sold out
+  auto ritr = rounds.find(p.current_round_id);
 
-  uint64_t round_start_volume = 0;
+  uint64_t round_start_volume = s.total_sold;
 
   while(ritr != rounds.end() && usd_remaining > 0) {
     uint64_t round_end_volume = ritr->max_sold;
@@ -255,11 +262,9 @@ void exchange::newpayment(name recipientAccount, string paymentSymbol, string pa
  
     asset usd_asset = asset(multipliedUsdValue, usd_symbol);
 
-    auto history_by_payment_id = payhistory.get_index<"bypaymentid"_n>();
-
-    uint64_t key = std::hash<std::string>{}(paymentId);
+    checksum256 digest = payment_digest(paymentId);
 
-    check( history_by_payment_id.find(key) == history_by_payment_id.end(), "duplicate transaction: "+paymentId);
+    check( !is_duplicate_payment(paymentId, digest), "duplicate transaction: "+paymentId);
 
     string memo = (paymentSymbol + ": " + paymentId).substr(0, 255);
 
@@ -275,16 +280,103 @@ void exchange::newpayment(name recipientAccount, string paymentSymbol, string pa
 
 }
 
+checksum256 exchange::payment_digest(const string & paymentId) {
+  return sha256(paymentId.c_str(), paymentId.size());
+}
+
+bool exchange::is_duplicate_payment(const string & paymentId, const checksum256 & digest) {
+  auto digests_by_digest = paydigests.get_index<"bydigest"_n>();
+  if (digests_by_digest.find(digest) != digests_by_digest.end()) {
+    return true;
+  }
+
+  // payments still in payhistory, the hash key can collide so compare the ids
+  auto history_by_payment_id = payhistory.get_index<"bypaymentid"_n>();
+  uint64_t key = std::hash<std::string>{}(paymentId);
+
+  auto hitr = history_by_payment_id.find(key);
+  while (hitr != history_by_payment_id.end() && hitr->by_payment_id() == key) {
+    if (hitr->paymentId == paymentId) {
+      return true;
+    }
+    hitr++;
+  }
+
+  return false;
+}
+
+// drops payhistory rows older than before_id, a digest of each pruned newpayment id keeps it deduplicated
+void exchange::prunepays(uint64_t before_id, uint64_t chunksize) {
+  require_auth(get_self());
+
+  auto digests_by_digest = paydigests.get_index<"bydigest"_n>();
+
+  auto pitr = payhistory.begin();
+  uint64_t count = 0;
+
+  while (pitr != payhistory.end() && pitr->id < before_id && count < chunksize) {
+    // TLOS and HUSD ids are generated here and never checked for duplicates
+    if (pitr->paymentSymbol != "TLOS" && pitr->paymentSymbol != "HUSD") {
+      checksum256 digest = payment_digest(pitr->paymentId);
+      if (digests_by_digest.find(digest) == digests_by_digest.end()) {
+        paydigests.emplace(_self, [&](auto& item) {
+          item.id = paydigests.available_primary_key();
+          item.digest = digest;
+        });
+      }
+    }
+    pitr = payhistory.erase(pitr);
+    count++;
+  }
+
+  if (pitr != payhistory.end() && pitr->id < before_id) {
+    action next_execution(
+      permission_level{get_self(), "active"_n},
+      get_self(),
+      "prunepays"_n,
+      std::make_tuple(before_id, chunksize)
+    );
+
+    transaction tx;
+    tx.actions.emplace_back(next_execution);
+    tx.delay_sec = 1;
+    tx.send("prunepays"_n.value, _self);
+  }
+}
+
 void exchange::onperiod() {
   require_auth(get_self());
-  
+  clear_daily_stats();
+}
+
+void exchange::clearstats() {
+  require_auth(get_self());
+  clear_daily_stats();
+}
+
+// erases the daily purchase totals a chunk at a time, continuing in a deferred transaction
+void exchange::clear_daily_stats() {
   auto sitr = dailystats.begin();
-  
-  while (sitr != dailystats.end()) {
+  uint64_t count = 0;
+
+  while (sitr != dailystats.end() && count < daily_stats_batch_size) {
     sitr = dailystats.erase(sitr);
+    count++;
   }
 
-
+  if (sitr != dailystats.end()) {
+    action next_execution(
+      permission_level{get_self(), "active"_n},
+      get_self(),
+      "clearstats"_n,
+      std::make_tuple()
+    );
+
+    transaction tx;
+    tx.actions.emplace_back(next_execution);
+    tx.delay_sec = 1;
+    tx.send("clearstats"_n.value, _self, true);
+  }
 }
 
 void exchange::updatelimit(asset citizen_limit, asset resident_limit, asset visitor_limit) {
@@ -322,7 +414,7 @@ void exchange::updatetlos(asset tlos_per_usd) {
   config.set(c, get_self());
 }
 
-void exchange::update_price() {
+exchange::price_table exchange::update_price() {
 
   soldtable stb = sold.get_or_create(get_self(), soldtable());
   uint64_t total_sold = stb.total_sold;
@@ -331,7 +423,12 @@ void exchange::update_price() {
 
   configtable c = config.get_or_create(get_self(), configtable());
 
-  auto ritr = rounds.begin();
+  // max_sold is the running sum of round volumes and total_sold only grows, so the search
+  // can resume from the round the previous update stopped at
+  auto ritr = rounds.find(p.current_round_id);
+  if (ritr == rounds.end()) {
+    ritr = rounds.begin();
+  }
 
   while(true) {
     
@@ -357,6 +454,7 @@ void exchange::update_price() {
 
   price_history_update();
 
+  return p;
 }
 
 ACTION exchange::addround(uint64_t volume, asset seeds_per_usd) {
@@ -438,6 +536,11 @@ ACTION exchange::initrounds(uint64_t volume_per_round, asset initial_seeds_per_u
     seeds_per_usd = uint64_t(round( 10000.0 / usd_per_seeds));
   }
 
+  // the rounds were replaced, restart the cursor from the first one
+  price_table p = price.get_or_create(get_self(), price_table());
+  p.current_round_id = 0;
+  price.set(p, get_self());
+
   update_price();
 
 }
@@ -451,11 +451,7 @@ uint64_t gratitude::get_size(name id) {
 
 
 uint64_t gratitude::config_get(name key) {
-  auto citr = config.find(key.value);
-  if (citr == config.end()) { 
-    check(false, ("settings: the "+key.to_string()+" parameter has not been initialized").c_str());
-  }
-  return citr->value;
+  return config_cache.get(config, key);
 }
 
 // Transfers out stored SEEDS
@@ -40,6 +40,7 @@ void harvest::reset() {
   while (pitr != planted.end()) {
     pitr = planted.erase(pitr);
   }
+  utils::delete_table<score_bucket_tables>(get_self(), planted_buckets.value);
 
   auto qitr = monthlyqevs.begin();
   while (qitr != monthlyqevs.end()) {
@@ -68,7 +69,19 @@ void harvest::reset() {
     bcsitr = regioncstemp.erase(bcsitr);
   }
 
+  auto ditr = csdirty.begin();
+  while (ditr != csdirty.end()) {
+    ditr = csdirty.erase(ditr);
+  }
+
+  rewardindex.remove();
+  utils::delete_table<reward_tables>(get_self(), individual_scope_harvest.value);
+  utils::delete_table<reward_tables>(get_self(), organization_scope.value);
+
   total.remove();
+  scorecursor.remove();
+  txptcursor.remove();
+  rankcursor.remove();
 
   init_balance(_self);
 }
@@ -115,11 +128,14 @@ void harvest::add_planted(name account, asset quantity) {
       item.planted = quantity;
       item.rank = 0;
     });
+    utils::score_bucket_change(get_self(), planted_buckets, quantity.amount, 1);
     size_change(planted_size, 1);
   } else {
+    utils::score_bucket_change(get_self(), planted_buckets, pitr->planted.amount, -1);
     planted.modify(pitr, _self, [&](auto& item) {
       item.planted += quantity;
     });
+    utils::score_bucket_change(get_self(), planted_buckets, pitr->planted.amount, 1);
   }
   
   change_total(true, quantity);
@@ -142,9 +158,11 @@ void harvest::sub_planted(name account, asset quantity) {
     check(pitr->planted.amount - quantity.amount >= min_planted, "Can't unplant last Seeds " + std::to_string(min_planted/10000.0));
   }
 
+  utils::score_bucket_change(get_self(), planted_buckets, pitr->planted.amount, -1);
   planted.modify(pitr, _self, [&](auto& item) {
     item.planted -= quantity;
   });
+  utils::score_bucket_change(get_self(), planted_buckets, pitr->planted.amount, 1);
   
   change_total(false, quantity);
 
@@ -285,14 +303,26 @@ void harvest::unplant(name from, asset quantity) {
 
 ACTION harvest::updatetxpt(name account) {
   require_auth(get_self());
-  auto uitr = users.get(account.value, "user not found");
-  calc_transaction_points(account, uitr.type);
+  utils::user_core user = utils::get_user_core(account);
+  check(user.exists, "user not found");
+  calc_transaction_points(account, user.type);
 }
 
 ACTION harvest::updatecs(name account) {
   require_auth(account);
-  auto uitr = users.get(account.value, "user not found");
-  calc_contribution_score(account, uitr.type);
+  utils::user_core user = utils::get_user_core(account);
+  check(user.exists, "user not found");
+
+  // bring the planted rank up to date from the planted histogram instead of waiting for the next ranking
+  auto pitr = planted.find(account.value);
+  if (pitr != planted.end()) {
+    uint64_t rank = utils::score_bucket_rank(get_self(), planted_buckets, pitr->planted.amount);
+    planted.modify(pitr, _self, [&](auto& item) {
+      item.rank = rank;
+    });
+  }
+
+  calc_contribution_score(account, user.type);
 }
 
 ACTION harvest::calctotal(uint64_t startval) {
@@ -334,23 +364,15 @@ ACTION harvest::calctotal(uint64_t startval) {
 // Calculate Transaction Points for a single account
 // Returns count of iterations
 uint32_t harvest::calc_transaction_points(name account, name type) {
-  uint64_t now = eosio::current_time_point().sec_since_epoch();
-  uint64_t cutoffdate = now - (utils::moon_cycle * config_float_get("cyctrx.trail"_n));
+  trx_points_sum_tables sums(contracts::history, contracts::history.value);
+  auto sitr = sums.find(account.value);
 
-  transaction_points_tables transactions(contracts::history, account.value);
+  set_transaction_points(account, type, sitr == sums.end() ? 0 : sitr -> points);
 
-  uint64_t count = 0;
-  uint64_t total_points = 0;
-
-  auto titr = transactions.rbegin();
-  while (titr != transactions.rend() && titr -> timestamp >= cutoffdate) {
-
-    total_points += titr -> points;
-
-    titr++;
-    count++;
-  }
+  return 1;
+}
 
+void harvest::set_transaction_points(name account, name type, uint64_t total_points) {
   if (type == name("organisation")) {
     setorgtxpt(account, total_points);
   } else {
@@ -372,47 +394,63 @@ uint32_t harvest::calc_transaction_points(name account, name type) {
       } else {
         txpoints.erase(tx_points_itr);
         size_change(tx_points_size, -1);
+        mark_cs_dirty(account);
       }
     }
   }
-
-  return count;
 }
 
-void harvest::calctrxpts() {
-    calctrxpt(0, 0, 400);
+void harvest::calctrxpts(eosio::binary_extension<name> op_id) {
+  require_auth(_self);
+
+  change_cursor_table c = txptcursor.get_or_create(get_self(), change_cursor_table());
+  c.until = eosio::current_time_point().sec_since_epoch();
+  txptcursor.set(c, get_self());
+
+  calctrxpt(400, op_id);
 }
 
-void harvest::calctrxpt(uint64_t start_val, uint64_t chunk, uint64_t chunksize) {
+// Only the accounts whose rolling sum in history changed since the last run are visited
+void harvest::calctrxpt(uint64_t chunksize, eosio::binary_extension<name> op_id) {
   require_auth(_self);
 
   check(chunksize > 0, "chunk size must be > 0");
 
-  uint64_t total = utils::get_users_size();
-  auto uitr = start_val == 0 ? users.begin() : users.lower_bound(start_val);
+  change_cursor_table c = txptcursor.get();
+
+  trx_points_sum_tables sums(contracts::history, contracts::history.value);
+  auto sums_by_updated = sums.get_index<"byupdated"_n>();
+  auto sitr = sums_by_updated.lower_bound(c.start_key);
   uint64_t count = 0;
 
-  while (uitr != users.end() && count < chunksize) {
-    uint32_t num = calc_transaction_points(uitr->account, uitr->type);
-    count += 1 + num;
-    uitr++;
+  while (sitr != sums_by_updated.end() && sitr -> updated_at < c.until && count < chunksize) {
+    utils::user_core user = utils::get_user_core(sitr -> account);
+    if (user.exists) {
+      set_transaction_points(sitr -> account, user.type, sitr -> points);
+    }
+    count++;
+    sitr++;
   }
 
-  if (uitr == users.end()) {
-    // done
+  if (sitr == sums_by_updated.end() || sitr -> updated_at >= c.until) {
+    c.start_key = uint128_t(c.until) << 64;
+    txptcursor.set(c, get_self());
+    utils::send_op_done(get_self(), op_id);
   } else {
-    uint64_t next_value = uitr->account.value;
+    c.start_key = sitr -> by_updated();
+    txptcursor.set(c, get_self());
+
     action next_execution(
         permission_level{get_self(), "active"_n},
         get_self(),
         "calctrxpt"_n,
-        std::make_tuple(next_value, chunk + 1, chunksize)
+        std::make_tuple(chunksize, op_id)
     );
 
     transaction tx;
     tx.actions.emplace_back(next_execution);
     tx.delay_sec = 1;
-    tx.send(next_value, _self);
+    tx.send("calctrxpt"_n.value, _self);
   }
 }
 
@@ -442,9 +480,12 @@ void harvest::ranktx(uint64_t start_val, uint64_t chunk, uint64_t chunksize, nam
 
     uint64_t rank = utils::spline_rank(current, total);
 
-    txpt_by_points.modify(titr, _self, [&](auto& item) {
-      item.rank = rank;
-    });
+    if (titr->rank != rank) {
+      txpt_by_points.modify(titr, _self, [&](auto& item) {
+        item.rank = rank;
+      });
+      mark_cs_dirty(titr->account);
+    }
 
     current++;
     count++;
@@ -491,9 +532,12 @@ void harvest::rankplanted(uint128_t start_val, uint64_t chunk, uint64_t chunksiz
 
     uint64_t rank = utils::spline_rank(current, total);
 
-    planted_by_planted.modify(pitr, _self, [&](auto& item) {
-      item.rank = rank;
-    });
+    if (pitr->rank != rank) {
+      planted_by_planted.modify(pitr, _self, [&](auto& item) {
+        item.rank = rank;
+      });
+      mark_cs_dirty(pitr->account);
+    }
 
     current++;
     count++;
@@ -521,7 +565,48 @@ void harvest::rankplanted(uint128_t start_val, uint64_t chunk, uint64_t chunksiz
 
 }
 
+// Full sweep over all users, the fallback to the dirty set consumed by rankscores.
+// The region sums are rebuilt from scratch as every account adds its full points again.
+// The sweep covers every rank change up to now, so the dirty set and the rank change
+// cursor are reset, and rankscores is refused until the sweep has finished.
 void harvest::calccss() {
+  require_auth(_self);
+
+  if (scorecursor.exists()) {
+    name step = scorecursor.get().step;
+    check(step == score_step_done || step == score_step_fullcs, "rankscores is running, wait for it to finish");
+  }
+
+  cancel_deferred("calccs"_n.value);
+
+  auto rgnitr = regioncstemp.begin();
+  while (rgnitr != regioncstemp.end()) {
+    rgnitr = regioncstemp.erase(rgnitr);
+  }
+  size_set(cs_rgn_size, 0);
+
+  auto ditr = csdirty.begin();
+  while (ditr != csdirty.end()) {
+    ditr = csdirty.erase(ditr);
+  }
+
+  change_cursor_table c = rankcursor.get_or_create(get_self(), change_cursor_table());
+  c.start_key = uint128_t(eosio::current_time_point().sec_since_epoch()) << 64;
+  c.until = 0;
+  rankcursor.set(c, get_self());
+
+  score_cursor_table sc;
+  sc.id = 0;
+  sc.step = score_step_fullcs;
+  sc.start_val = 0;
+  sc.current = 0;
+  sc.total = utils::get_users_size();
+  sc.sum_rank = 0;
+  sc.chunk = 0;
+  sc.started_at = eosio::current_time_point().sec_since_epoch();
+
+  scorecursor.set(sc, get_self());
+
   calccs(0, 0, 200);
 }
 
@@ -531,19 +616,32 @@ void harvest::calccs(uint64_t start_val, uint64_t chunk, uint64_t chunksize) {
   check(chunksize > 0, "chunk size must be > 0");
 
   uint64_t total = utils::get_users_size();
-  auto uitr = start_val == 0 ? users.begin() : users.lower_bound(start_val);
+  auto uitr = start_val == 0 ? usercore.begin() : usercore.lower_bound(start_val);
   uint64_t count = 0;
 
-  while (uitr != users.end() && count < chunksize) {
-    calc_contribution_score(uitr->account, uitr->type);
+  while (uitr != usercore.end() && count < chunksize) {
+    calc_contribution_score(uitr->account, uitr->type, true);
     count++;
     uitr++;
   }
 
-  if (uitr == users.end()) {
-    // done
+  score_cursor_table sc = scorecursor.get_or_default(score_cursor_table());
+
+  if (uitr == usercore.end()) {
+    if (sc.step == score_step_fullcs) {
+      sc.step = score_step_done;
+      scorecursor.set(sc, get_self());
+    }
   } else {
     uint64_t next_value = uitr->account.value;
+
+    if (sc.step == score_step_fullcs) {
+      sc.start_val = next_value;
+      sc.current += count;
+      sc.chunk = chunk + 1;
+      scorecursor.set(sc, get_self());
+    }
+
     action next_execution(
         permission_level{get_self(), "active"_n},
         get_self(),
@@ -554,12 +652,14 @@ void harvest::calccs(uint64_t start_val, uint64_t chunk, uint64_t chunksize) {
     transaction tx;
     tx.actions.emplace_back(next_execution);
     tx.delay_sec = 1;
-    tx.send(next_value, _self);
+    tx.send("calccs"_n.value, _self);
   }
 }
 
 // [PS+RT+CB X Rep = Total Contribution Score]
-void harvest::calc_contribution_score(name account, name type) {
+// The region sum is moved by the change in the account's points, or by all of its
+// points when full_region is set and the region sums are being rebuilt by calccs
+void harvest::calc_contribution_score(name account, name type, bool full_region) {
   uint64_t planted_score = 0;
   uint64_t transactions_score = 0;
   uint64_t community_building_score = 0;
@@ -612,6 +712,8 @@ void harvest::calc_contribution_score(name account, name type) {
 
   cs_points_tables cspoints_t(get_self(), cs_scope.value);
 
+  uint64_t previous_points = 0;
+
   auto csitr = cspoints_t.find(account.value);
   if (csitr == cspoints_t.end()) {
     if (contribution_points > 0) {
@@ -622,45 +724,111 @@ void harvest::calc_contribution_score(name account, name type) {
       size_change(cs_sz, 1);
     }
   } else {
+    previous_points = csitr->contribution_points;
     if (contribution_points > 0) {
       cspoints_t.modify(csitr, _self, [&](auto& item) {
         item.contribution_points = contribution_points;
       });
     } else {
+      settle_reward(account, cs_scope, csitr->rank);
       cspoints_t.erase(csitr);
       size_change(cs_sz, -1);
     }
   }
 
-  if (type != "organisation"_n) {
-    add_cs_to_region(account, uint32_t(contribution_points));
+  if (type != "organisation"_n && (full_region || !region_rebuild_pending(account))) {
+    int64_t delta = full_region ? int64_t(contribution_points) : int64_t(contribution_points) - int64_t(previous_points);
+    add_cs_to_region(account, delta);
   }
 }
 
-void harvest::add_cs_to_region(name account, uint32_t points) {
+// True while calccss has not yet reached the account, its full points are added to the
+// region sum when it does, so a delta added now would be counted twice
+bool harvest::region_rebuild_pending(name account) {
+  if (!scorecursor.exists()) return false;
+
+  score_cursor_table sc = scorecursor.get();
+  return sc.step == score_step_fullcs && account.value >= uint64_t(sc.start_val);
+}
+
+void harvest::add_cs_to_region(name account, int64_t delta) {
+  if (delta == 0) { return; }
+
   auto bitr = members.find(account.value);
   if (bitr == members.end()) { return; }
 
-  auto csitr = regioncstemp.find(bitr -> region.value);
+  add_cs_to_rgn(bitr -> region, delta);
+}
+
+void harvest::add_cs_to_rgn(name region, int64_t delta) {
+  if (delta == 0) { return; }
+
+  auto csitr = regioncstemp.find(region.value);
   if (csitr == regioncstemp.end()) {
-    if (points > 0) {
+    if (delta > 0) {
       regioncstemp.emplace(_self, [&](auto & item){
-        item.region = bitr -> region;
-        item.points = points;
+        item.region = region;
+        item.points = uint32_t(delta);
       });
       size_change(cs_rgn_size, 1);
     }
   } else {
+    int64_t points = int64_t(csitr -> points) + delta;
     if (points > 0) {
       regioncstemp.modify(csitr, _self, [&](auto & item){
-        item.points += points;
+        item.points = uint32_t(points);
       });
     } else {
       regioncstemp.erase(csitr);
+      size_change(cs_rgn_size, -1);
+      remove_rgn_rank(region);
     }
   }
 }
 
+void harvest::remove_rgn_rank(name region) {
+  cs_points_tables rgncspoints(get_self(), name("rgn").value);
+  auto ritr = rgncspoints.find(region.value);
+  if (ritr != rgncspoints.end()) {
+    rgncspoints.erase(ritr);
+  }
+}
+
+// Sent by the region contract after an account joins or leaves a region. The membership
+// row is already written, so the account's current points move with it
+ACTION harvest::rgnmember(name region, name account, bool joined) {
+  require_auth(contracts::region);
+
+  if (region_rebuild_pending(account)) { return; }
+
+  cs_points_tables cspoints_t(get_self(), individual_scope_harvest.value);
+  auto csitr = cspoints_t.find(account.value);
+  if (csitr == cspoints_t.end()) { return; }
+
+  int64_t points = int64_t(csitr -> contribution_points);
+  add_cs_to_rgn(region, joined ? points : -points);
+}
+
+ACTION harvest::removergncs(name region) {
+  require_auth(contracts::region);
+
+  auto csitr = regioncstemp.find(region.value);
+  if (csitr != regioncstemp.end()) {
+    regioncstemp.erase(csitr);
+    size_change(cs_rgn_size, -1);
+  }
+  remove_rgn_rank(region);
+}
+
+void harvest::mark_cs_dirty(name account) {
+  auto ditr = csdirty.find(account.value);
+  if (ditr == csdirty.end()) {
+    csdirty.emplace(_self, [&](auto & item){
+      item.account = account;
+    });
+  }
+}
+
 void harvest::rankcss() {
   size_set(sum_rank_users, 0);
   rankcs(0, 0, 200, individual_scope_harvest);
@@ -699,9 +867,12 @@ void harvest::rankcs(uint64_t start_val, uint64_t chunk, uint64_t chunksize, nam
 
     uint64_t rank = utils::linear_rank(current, total);
 
-    cs_by_points.modify(citr, _self, [&](auto& item) {
-      item.rank = rank;
-    });
+    if (citr->rank != rank) {
+      settle_reward(citr->account, cs_scope, citr->rank);
+      cs_by_points.modify(citr, _self, [&](auto& item) {
+        item.rank = rank;
+      });
+    }
 
     if (cs_scope == organization_scope) {
       auto org = organizations.find(citr -> account.value);
@@ -782,7 +953,7 @@ void harvest::rankrgncs(uint64_t start, uint64_t chunk, uint64_t chunksize) {
 
     sum_rank_b += rank;
 
-    bitr = rgns_by_points.erase(bitr);
+    bitr++;
     count++;
     current++;
   }
@@ -802,10 +973,288 @@ void harvest::rankrgncs(uint64_t start, uint64_t chunk, uint64_t chunksize) {
     tx.actions.emplace_back(next_execution);
     tx.delay_sec = 1;
     tx.send(next_value, _self);
+  }
+
+}
+
+
+ACTION harvest::migbuckets(uint64_t start, uint64_t chunksize) {
+  require_auth(get_self());
+
+  if (start == 0) {
+    utils::delete_table<score_bucket_tables>(get_self(), planted_buckets.value);
+  }
+
+  auto pitr = planted.lower_bound(start);
+  uint64_t count = 0;
+
+  while (pitr != planted.end() && count < chunksize) {
+    utils::score_bucket_change(get_self(), planted_buckets, pitr->planted.amount, 1);
+    pitr++;
+    count++;
+  }
+
+  if (pitr != planted.end()) {
+    uint64_t next_value = pitr->account.value;
+    action next_execution(
+      permission_level{get_self(), "active"_n},
+      get_self(),
+      "migbuckets"_n,
+      std::make_tuple(next_value, chunksize)
+    );
+
+    transaction tx;
+    tx.actions.emplace_back(next_execution);
+    tx.delay_sec = 1;
+    tx.send(next_value, _self);
+  }
+}
+
+void harvest::rankscores(eosio::binary_extension<name> op_id) {
+  require_auth(get_self());
+
+  check(!scorecursor.exists() || scorecursor.get().step != score_step_fullcs, "calccss is running, wait for it to finish");
+
+  cancel_deferred("rankscore"_n.value);
+
+  score_cursor_table sc;
+  sc.id = 0;
+  sc.step = score_step_planted;
+  sc.start_val = 0;
+  sc.current = 0;
+  sc.total = get_size(planted_size);
+  sc.sum_rank = 0;
+  sc.chunk = 0;
+  sc.started_at = eosio::current_time_point().sec_since_epoch();
+
+  scorecursor.set(sc, get_self());
+
+  rankscore(config_get("cs.budget"_n), op_id);
+}
+
+// Runs the steps of rankplanteds, ranktxs, rankorgtxs, calccss, rankcss and rankorgcss
+// back to back, sharing a single row budget per transaction. The position in the pipeline
+// and the running rank counters are kept in the scorecursor singleton.
+// Rep and cbs are not ranked here: their ranks are rows of the accounts contract, which
+// only accounts can write. rankreps and rankcbss run there first (hrvst.score depends on
+// them in the scheduler) and calccs picks up their changes from the rankchanges table.
+void harvest::rankscore(uint64_t budget, eosio::binary_extension<name> op_id) {
+  require_auth(get_self());
+
+  check(budget > 0, "budget must be > 0");
+  check(scorecursor.exists(), "the score pipeline has not been started");
+
+  score_cursor_table sc = scorecursor.get();
+  uint64_t remaining = budget;
+  uint64_t min_eligible = config_get(name("org.minharv"));
+
+  while (sc.step != score_step_done && remaining > 0) {
+    bool finished = false;
+
+    if (sc.step == score_step_planted) {
+      finished = score_planted(sc, remaining);
+    } else if (sc.step == score_step_txpoints) {
+      finished = score_txpoints(sc, remaining, get_self());
+    } else if (sc.step == score_step_orgtxpoints) {
+      finished = score_txpoints(sc, remaining, organization_scope);
+    } else if (sc.step == score_step_calccs) {
+      finished = score_calccs(sc, remaining);
+    } else if (sc.step == score_step_rankcs) {
+      finished = score_rankcs(sc, remaining, individual_scope_harvest, min_eligible);
+    } else if (sc.step == score_step_rankorgcs) {
+      finished = score_rankcs(sc, remaining, organization_scope, min_eligible);
+    }
+
+    if (finished) {
+      score_next_step(sc);
+    }
+  }
+
+  sc.chunk++;
+  scorecursor.set(sc, get_self());
+
+  if (sc.step != score_step_done) {
+    action next_execution(
+      permission_level{get_self(), "active"_n},
+      get_self(),
+      "rankscore"_n,
+      std::make_tuple(budget, op_id)
+    );
+
+    transaction tx;
+    tx.actions.emplace_back(next_execution);
+    tx.delay_sec = 1;
+    tx.send("rankscore"_n.value, _self);
+  } else {
+    utils::send_op_done(get_self(), op_id);
+  }
+}
+
+void harvest::score_next_step(score_cursor_table & sc) {
+  if (sc.step == score_step_planted) {
+    sc.step = score_step_txpoints;
+    sc.total = get_size(tx_points_size);
+  } else if (sc.step == score_step_txpoints) {
+    sc.step = score_step_orgtxpoints;
+    sc.total = get_size(org_tx_points_size);
+  } else if (sc.step == score_step_orgtxpoints) {
+    change_cursor_table c = rankcursor.get_or_create(get_self(), change_cursor_table());
+    c.until = eosio::current_time_point().sec_since_epoch();
+    rankcursor.set(c, get_self());
+
+    sc.step = score_step_calccs;
+    sc.total = 0;
+  } else if (sc.step == score_step_calccs) {
+    sc.step = score_step_rankcs;
+    sc.total = get_size(cs_size);
+  } else if (sc.step == score_step_rankcs) {
+    size_set(sum_rank_users, sc.sum_rank);
+    sc.step = score_step_rankorgcs;
+    sc.total = get_size(cs_org_size);
   } else {
-    size_set(cs_rgn_size, 0);
+    size_set(sum_rank_orgs, sc.sum_rank);
+    sc.step = score_step_done;
+    sc.total = 0;
   }
 
+  sc.start_val = 0;
+  sc.current = 0;
+  sc.sum_rank = 0;
+}
+
+bool harvest::score_planted(score_cursor_table & sc, uint64_t & budget) {
+  if (sc.total == 0) return true;
+
+  auto planted_by_planted = planted.get_index<"byplanted"_n>();
+  auto pitr = sc.start_val == 0 ? planted_by_planted.begin() : planted_by_planted.lower_bound(sc.start_val);
+
+  while (pitr != planted_by_planted.end() && budget > 0) {
+    uint64_t rank = utils::spline_rank(sc.current, sc.total);
+
+    if (pitr->rank != rank) {
+      planted_by_planted.modify(pitr, _self, [&](auto& item) {
+        item.rank = rank;
+      });
+      mark_cs_dirty(pitr->account);
+    }
+
+    sc.current++;
+    budget--;
+    pitr++;
+  }
+
+  if (pitr == planted_by_planted.end()) return true;
+
+  sc.start_val = pitr->by_planted();
+  return false;
+}
+
+bool harvest::score_txpoints(score_cursor_table & sc, uint64_t & budget, name table) {
+  if (sc.total == 0) return true;
+
+  tx_points_tables txpoints_table(get_self(), table.value);
+  auto txpt_by_points = txpoints_table.get_index<"bypoints"_n>();
+  auto titr = sc.start_val == 0 ? txpt_by_points.begin() : txpt_by_points.lower_bound(uint64_t(sc.start_val));
+
+  while (titr != txpt_by_points.end() && budget > 0) {
+    uint64_t rank = utils::spline_rank(sc.current, sc.total);
+
+    if (titr->rank != rank) {
+      txpt_by_points.modify(titr, _self, [&](auto& item) {
+        item.rank = rank;
+      });
+      mark_cs_dirty(titr->account);
+    }
+
+    sc.current++;
+    budget--;
+    titr++;
+  }
+
+  if (titr == txpt_by_points.end()) return true;
+
+  sc.start_val = titr->by_points();
+  return false;
+}
+
+// Only accounts with a changed rank are recalculated. Rep and cbs rank changes are
+// read from the accounts contract up to the time the step started and added to the
+// dirty set, the planted and tx ranking steps before this one add their own.
+bool harvest::score_calccs(score_cursor_table & sc, uint64_t & budget) {
+  change_cursor_table c = rankcursor.get_or_create(get_self(), change_cursor_table());
+
+  rank_change_tables rankchanges(contracts::accounts, contracts::accounts.value);
+  auto changes_by_updated = rankchanges.get_index<"byupdated"_n>();
+  auto citr = changes_by_updated.lower_bound(c.start_key);
+
+  while (citr != changes_by_updated.end() && citr->updated_at < c.until && budget > 0) {
+    mark_cs_dirty(citr->account);
+    budget--;
+    citr++;
+  }
+
+  if (citr != changes_by_updated.end() && citr->updated_at < c.until) {
+    c.start_key = citr->by_updated();
+    rankcursor.set(c, get_self());
+    return false;
+  }
+
+  c.start_key = uint128_t(c.until) << 64;
+  rankcursor.set(c, get_self());
+
+  auto ditr = csdirty.begin();
+
+  while (ditr != csdirty.end() && budget > 0) {
+    utils::user_core user = utils::get_user_core(ditr->account);
+    if (user.exists) {
+      calc_contribution_score(ditr->account, user.type);
+    } else {
+      // removed user, without rep its points are 0 and the cspoints row is dropped
+      calc_contribution_score(ditr->account, "individual"_n);
+      calc_contribution_score(ditr->account, "organisation"_n);
+    }
+    budget = budget > calc_cs_cost ? budget - calc_cs_cost : 0;
+    ditr = csdirty.erase(ditr);
+  }
+
+  return ditr == csdirty.end();
+}
+
+bool harvest::score_rankcs(score_cursor_table & sc, uint64_t & budget, name cs_scope, uint64_t min_eligible) {
+  if (sc.total == 0) return true;
+
+  cs_points_tables cspoints_t(get_self(), cs_scope.value);
+  auto cs_by_points = cspoints_t.get_index<"bycspoints"_n>();
+  auto citr = sc.start_val == 0 ? cs_by_points.begin() : cs_by_points.lower_bound(uint64_t(sc.start_val));
+
+  while (citr != cs_by_points.end() && budget > 0) {
+    uint64_t rank = utils::linear_rank(sc.current, sc.total);
+
+    if (citr->rank != rank) {
+      settle_reward(citr->account, cs_scope, citr->rank);
+      cs_by_points.modify(citr, _self, [&](auto& item) {
+        item.rank = rank;
+      });
+    }
+
+    if (cs_scope == organization_scope) {
+      auto org = organizations.find(citr -> account.value);
+      if (org -> status >= min_eligible) {
+        sc.sum_rank += rank;
+      }
+    } else {
+      sc.sum_rank += rank;
+    }
+
+    sc.current++;
+    budget--;
+    citr++;
+  }
+
+  if (citr == cs_by_points.end()) return true;
+
+  sc.start_val = citr->by_cs_points();
+  return false;
 }
 
 
@@ -946,6 +1395,7 @@ void harvest::testupdatecs(name account, uint64_t contribution_score) {
       size_change(cs_sz, 1);
     }
   } else {
+    settle_reward(account, scope, csitr->rank);
     if (contribution_score > 0) {
       cspoints_t.modify(csitr, _self, [&](auto& item) {
         item.rank = contribution_score;
@@ -1040,6 +1490,7 @@ ACTION harvest::setorgtxpt(name organization, uint64_t tx_points) {
     } else {
       orgtxpoints.erase(oitr);
       size_change(org_tx_points_size, -1);
+      mark_cs_dirty(organization);
     }
   } 
 
@@ -1057,12 +1508,19 @@ void harvest::calcmqevs () {
     return;
   }
 
-  auto qitr = qevs.rbegin();
   uint64_t total_volume = 0;
 
-  while (qitr != qevs.rend() && qitr -> timestamp >= cutoff) {
-    total_volume += qitr -> qualifying_volume;
-    qitr++;
+  // transfers add rows to qevsums before the migration has filled in the older days
+  qev_sum_state_tables qevsumstate(contracts::history, contracts::history.value);
+  if (qevsumstate.get_or_default().ready) {
+    total_volume = qev_window_volume(cutoff, day + utils::seconds_per_day);
+  } else {
+    // qevsums not built yet, see history::migqevsums
+    auto qitr = qevs.rbegin();
+    while (qitr != qevs.rend() && qitr -> timestamp >= cutoff) {
+      total_volume += qitr -> qualifying_volume;
+      qitr++;
+    }
   }
 
   circulating_supply_table c = circulating.get();
@@ -1111,9 +1569,13 @@ void harvest::calcmintrate () {
   uint64_t previous_day = previous_day_temp.utc_seconds;
 
   auto current_qev_itr = monthlyqevs.find(day);
-  auto previous_qev_itr = monthlyqevs.find(previous_day);
+  if (current_qev_itr == monthlyqevs.end()) { return; }
 
-  if (current_qev_itr == monthlyqevs.end() || previous_qev_itr == monthlyqevs.end()) { return; }
+  // latest snapshot taken on or before previous_day, so a missed calcmqevs day does not stall the mint rate
+  auto previous_qev_itr = monthlyqevs.upper_bound(previous_day);
+  if (previous_qev_itr == monthlyqevs.begin()) { return; }
+  previous_qev_itr--;
+  if (previous_qev_itr -> timestamp + utils::moon_cycle < previous_day) { return; }
 
   double volume_growth = double(current_qev_itr -> qualifying_volume - previous_qev_itr -> qualifying_volume) / previous_qev_itr -> qualifying_volume;
 
@@ -1146,19 +1608,29 @@ void harvest::calcmintrate () {
 }
 
 uint64_t harvest::config_get(name key) {
-  auto citr = config.find(key.value);
-  if (citr == config.end()) { 
-    check(false, ("settings: the "+key.to_string()+" parameter has not been initialized").c_str());
-  }
-  return citr->value;
+  return config_cache.get(config, key);
 }
 
 double harvest::config_float_get(name key) {
-  auto citr = configfloat.find(key.value);
-  if (citr == configfloat.end()) { 
-    check(false, ("settings: the "+key.to_string()+" parameter has not been initialized").c_str());
+  return config_float_cache.get(configfloat, key);
+}
+
+// qualifying volume of all days before timestamp, read from the history contract's running totals
+uint64_t harvest::qev_volume_before(uint64_t timestamp) {
+  qev_sum_tables qevsums(contracts::history, contracts::history.value);
+
+  auto sitr = qevsums.lower_bound(timestamp);
+  if (sitr == qevsums.begin()) {
+    return 0;
   }
-  return citr->value;
+  sitr--;
+
+  return sitr -> cumulative_volume;
+}
+
+// qualifying volume of the days in [from, to)
+uint64_t harvest::qev_window_volume(uint64_t from, uint64_t to) {
+  return qev_volume_before(to) - qev_volume_before(from);
 }
 
 void harvest::send_distribute_harvest (name key, asset amount) {
@@ -1241,52 +1713,150 @@ void harvest::runharvest() {
   print("amount for orgs: ", asset(quantity.amount * orgs_percentage, test_symbol), "\n");
   print("amount for global: ", asset(quantity.amount * global_percentage, test_symbol), "\n");
 
-  send_distribute_harvest("disthvstusrs"_n, asset(quantity.amount * users_percentage, test_symbol));
+  add_reward_index(individual_scope_harvest, asset(quantity.amount * users_percentage, test_symbol));
+  add_reward_index(organization_scope, asset(quantity.amount * orgs_percentage, test_symbol));
   send_distribute_harvest("disthvstrgns"_n, asset(quantity.amount * rgns_percentage, test_symbol));
-  send_distribute_harvest("disthvstorgs"_n, asset(quantity.amount * orgs_percentage, test_symbol));
   send_distribute_harvest("disthvstdhos"_n, asset(quantity.amount * global_percentage, test_symbol));
 
 }
 
-void harvest::disthvstusrs (uint64_t start, uint64_t chunksize, asset total_amount) {
-  require_auth(get_self());
+void harvest::add_reward_index(name cs_scope, asset amount) {
+  uint64_t sum_rank = get_size(cs_scope == organization_scope ? sum_rank_orgs : sum_rank_users);
 
-  auto csitr = start == 0 ? cspoints.begin() : cspoints.find(start);
-  uint64_t count = 0;
+  if (amount.amount <= 0) { return; }
 
-  uint64_t sum_rank = get_size(sum_rank_users);
-  check(sum_rank > 0, "the sum rank for users must be greater than zero");
+  auto index = rewardindex.get_or_default();
+  if (!index.users_pending.has_value()) index.users_pending = 0;
+  if (!index.orgs_pending.has_value()) index.orgs_pending = 0;
 
-  double fragment_seeds = total_amount.amount / double(sum_rank);
-  
-  while (csitr != cspoints.end() && count < chunksize) {
+  int64_t & pending = cs_scope == organization_scope ? index.orgs_pending.value() : index.users_pending.value();
 
-    // auto uitr = users.find(csitr -> account.value);
-    if (csitr->rank > 0) {
+  // nothing ranked, the amount is carried over to the next harvest with a ranked account
+  if (sum_rank == 0) {
+    pending += amount.amount;
+    print("no rank in " + cs_scope.to_string() + ", carried over: " + asset(pending, test_symbol).to_string() + "\n");
+    index.timestamp = eosio::current_time_point().sec_since_epoch();
+    rewardindex.set(index, get_self());
+    return;
+  }
 
-      print("user:", csitr->account, ", rank:", csitr -> rank, ", amount:", asset(csitr -> rank * fragment_seeds, test_symbol), "\n");
-      withdraw_aux(get_self(), csitr->account, asset(csitr->rank * fragment_seeds, test_symbol), "harvest");
-    
+  uint128_t delta = (uint128_t(amount.amount + pending) * reward_index_scale) / sum_rank;
+  pending = 0;
+
+  if (cs_scope == organization_scope) {
+    index.orgs_index += delta;
+  } else {
+    index.users_index += delta;
+  }
+  index.timestamp = eosio::current_time_point().sec_since_epoch();
+
+  rewardindex.set(index, get_self());
+}
+
+// credits the harvest earned at rank since the account was last settled, must be called
+// before the rank of a cspoints row changes
+void harvest::settle_reward(name account, name cs_scope, uint64_t rank) {
+  auto index = rewardindex.get_or_default();
+  uint128_t current = cs_scope == organization_scope ? index.orgs_index : index.users_index;
+
+  reward_tables rewards_t(get_self(), cs_scope.value);
+  auto ritr = rewards_t.find(account.value);
+
+  // accounts without a row have not been settled since the index started at 0
+  uint128_t last = ritr == rewards_t.end() ? 0 : ritr->last_index;
+  int64_t earned = 0;
+
+  if (rank > 0 && current > last) {
+    bool eligible = true;
+    if (cs_scope == organization_scope) {
+      auto oitr = organizations.find(account.value);
+      eligible = oitr != organizations.end() && oitr->status >= config_get(name("org.minharv"));
     }
+    if (eligible) {
+      earned = int64_t((uint128_t(rank) * (current - last)) / reward_index_scale);
+    }
+  }
 
-    csitr++;
+  if (ritr == rewards_t.end()) {
+    rewards_t.emplace(_self, [&](auto & item){
+      item.account = account;
+      item.last_index = current;
+      item.unclaimed = asset(earned, test_symbol);
+    });
+  } else if (ritr->last_index != current) {
+    rewards_t.modify(ritr, _self, [&](auto & item){
+      item.last_index = current;
+      item.unclaimed.amount += earned;
+    });
+  }
+}
+
+void harvest::pay_reward(name account, name cs_scope) {
+  cs_points_tables cspoints_t(get_self(), cs_scope.value);
+  auto csitr = cspoints_t.find(account.value);
+  settle_reward(account, cs_scope, csitr == cspoints_t.end() ? 0 : csitr->rank);
+
+  reward_tables rewards_t(get_self(), cs_scope.value);
+  auto ritr = rewards_t.find(account.value);
+  if (ritr->unclaimed.amount <= 0) { return; }
+
+  asset amount = ritr->unclaimed;
+  rewards_t.modify(ritr, _self, [&](auto & item){
+    item.unclaimed.amount = 0;
+  });
+
+  withdraw_aux(get_self(), account, amount, "harvest");
+}
+
+void harvest::claimreward(name account) {
+  check(has_auth(account) || has_auth(get_self()), "harvest: missing authority of " + account.to_string());
+
+  utils::user_core user = utils::get_user_core(account);
+  check(user.exists, "harvest: no user");
+
+  pay_reward(account, user.type == "organisation"_n ? organization_scope : individual_scope_harvest);
+}
+
+// pays out everything owed in a cspoints scope, for accounts that do not claim themselves.
+// Every rank change settles the account first, so the rewards rows cover all accounts that
+// ever had a rank, including the ones that dropped out of cspoints with unclaimed harvest
+void harvest::sweeprewards(name cs_scope, uint64_t start, uint64_t chunksize) {
+  require_auth(get_self());
+
+  check(cs_scope == individual_scope_harvest || cs_scope == organization_scope, "harvest: invalid scope " + cs_scope.to_string());
+
+  cs_points_tables cspoints_t(get_self(), cs_scope.value);
+  reward_tables rewards_t(get_self(), cs_scope.value);
+  auto ritr = start == 0 ? rewards_t.begin() : rewards_t.lower_bound(start);
+  uint64_t count = 0;
+
+  while (ritr != rewards_t.end() && count < chunksize) {
+    name account = ritr->account;
+    pay_reward(account, cs_scope);
+
+    // nothing more to earn or to pay, the row is created again when the account is ranked
+    if (cspoints_t.find(account.value) == cspoints_t.end()) {
+      ritr = rewards_t.erase(rewards_t.find(account.value));
+    } else {
+      ritr++;
+    }
     count++;
   }
 
-  if (csitr != cspoints.end()) {
+  if (ritr != rewards_t.end()) {
+    uint64_t next_value = ritr->account.value;
     action next_execution(
       permission_level{get_self(), "active"_n},
       get_self(),
-      "disthvstusrs"_n,
-      std::make_tuple(csitr -> account.value, chunksize, total_amount)
+      "sweeprewards"_n,
+      std::make_tuple(cs_scope, next_value, chunksize)
     );
 
     transaction tx;
     tx.actions.emplace_back(next_execution);
     tx.delay_sec = 1;
-    tx.send(csitr -> account.value, _self);
+    tx.send(cs_scope.value + next_value, _self);
   }
-
 }
 
 void harvest::disthvstrgns (uint64_t start, uint64_t chunksize, asset total_amount) {
@@ -1333,51 +1903,6 @@ void harvest::disthvstrgns (uint64_t start, uint64_t chunksize, asset total_amou
 
 }
 
-void harvest::disthvstorgs (uint64_t start, uint64_t chunksize, asset total_amount) {
-  require_auth(get_self());
-
-  cs_points_tables cspoints_t(get_self(), organization_scope.value);
-
-  auto csitr = start == 0 ? cspoints_t.begin() : cspoints_t.find(start);
-  uint64_t count = 0;
-
-  uint64_t sum_rank = get_size(sum_rank_orgs);
-  check(sum_rank > 0, "the sum rank for organizations must be greater than zero");
-
-  double fragment_seeds = total_amount.amount / double(sum_rank);
-
-  uint64_t min_eligible = config_get(name("org.minharv"));
-  
-  while (csitr != cspoints_t.end() && count < chunksize) {
-
-    // auto uitr = users.find(csitr -> account.value);
-    if (csitr->rank > 0) {
-      auto uitr = organizations.find(csitr -> account.value);
-      if (uitr -> status >= min_eligible) {
-        print("org:", csitr -> account, ", rank:", csitr -> rank, ", amount:", asset(csitr -> rank * fragment_seeds, test_symbol), "\n");
-        withdraw_aux(get_self(), csitr -> account, asset(csitr -> rank * fragment_seeds, test_symbol), "harvest");
-      }
-    }
-
-    csitr++;
-    count++;
-  }
-
-  if (csitr != cspoints_t.end()) {
-    action next_execution(
-      permission_level{get_self(), "active"_n},
-      get_self(),
-      "disthvstorgs"_n,
-      std::make_tuple(csitr -> account.value, chunksize, total_amount)
-    );
-
-    transaction tx;
-    tx.actions.emplace_back(next_execution);
-    tx.delay_sec = 1;
-    tx.send(sum_rank_orgs.value, _self);
-  }
-}
-
 void harvest::disthvstdhos (uint64_t start, uint64_t chunksize, asset total_amount) {
   require_auth(get_self());
 
@@ -25,6 +25,27 @@ void history::reset(name account) {
     qitr = qevs.erase(qitr);
   }
 
+  if (account == get_self()) {
+    qev_sum_tables qevsums(get_self(), get_self().value);
+    auto qsitr = qevsums.begin();
+    while (qsitr != qevsums.end()) {
+      qsitr = qevsums.erase(qsitr);
+    }
+
+    // an empty history has nothing left to migrate
+    set_qev_sums_ready(true);
+  }
+
+  trx_points_sum_tables sums(get_self(), get_self().value);
+  auto psitr = sums.find(account.value);
+  if (psitr != sums.end()) {
+    // zeroed rather than erased so harvest sees the change on its next calctrxpts
+    sums.modify(psitr, _self, [&](auto & item){
+      item.points = 0;
+      item.updated_at = eosio::current_time_point().sec_since_epoch();
+    });
+  }
+
   auto citr = citizens.begin();
   while (citr != citizens.end()) {
     citr = citizens.erase(citr);
@@ -63,6 +84,21 @@ void history::reset(name account) {
   while (ptrx_itr != ptrx_t.end()) {
     ptrx_itr = ptrx_t.erase(ptrx_itr);
   }
+
+  trx_queue_tables queue(get_self(), get_self().value);
+  auto tqitr = queue.begin();
+  while (tqitr != queue.end()) {
+    tqitr = queue.erase(tqitr);
+  }
+
+  trx_queue_failed_tables failed(get_self(), get_self().value);
+  auto fitr = failed.begin();
+  while (fitr != failed.end()) {
+    fitr = failed.erase(fitr);
+  }
+
+  drain_stats_tables drainstats(get_self(), get_self().value);
+  drainstats.remove();
 }
 
 void history::deldailytrx (uint64_t day) {
@@ -158,10 +194,10 @@ void history::trxentry(name from, name to, asset quantity) {
     return;
   }
 
-  auto from_user = users.find(from.value);
-  auto to_user = users.find(to.value);
+  utils::user_core from_user = utils::get_user_core(from);
+  utils::user_core to_user = utils::get_user_core(to);
   
-  if (from_user == users.end() || to_user == users.end()) {
+  if (!from_user.exists || !to_user.exists) {
     return;
   }
 
@@ -171,8 +207,8 @@ void history::trxentry(name from, name to, asset quantity) {
   uint64_t transaction_id = transactions.available_primary_key();
   uint64_t timestamp = eosio::current_time_point().sec_since_epoch();
 
-  bool from_is_organization = from_user -> type == "organisation"_n;
-  bool to_is_organization = to_user -> type == "organisation"_n;
+  bool from_is_organization = from_user.type == "organisation"_n;
+  bool to_is_organization = to_user.type == "organisation"_n;
 
   int64_t transactions_cap = int64_t(config_get("qev.trx.cap"_n));
   int64_t max_transaction_points_individuals = int64_t(config_get("i.trx.max"_n));
@@ -232,19 +268,179 @@ void history::trxentry(name from, name to, asset quantity) {
     }
   }
 
-  uint64_t deferred_id = get_deferred_id();
+  trx_queue_tables queue(get_self(), get_self().value);
 
+  queue.emplace(_self, [&](auto & item){
+    item.id = queue.available_primary_key();
+    item.transaction_id = transaction_id;
+    item.day = day;
+    item.from = from;
+    item.to = to;
+    item.timestamp = timestamp;
+  });
+
+  drain_stats_tables drainstats(get_self(), get_self().value);
+  drain_stats_table stats = drainstats.get_or_create(get_self(), drain_stats_table());
+
+  // a drain that is pending is left alone, replacing it under load would keep pushing it back
+  if (stats.scheduled_at != 0 && stats.scheduled_at + queue_stale_sec >= timestamp) { return; }
+
+  // The scheduled drain never completed. Any entry of its batch may have failed it, and it may
+  // only have been delayed, so the batch is retried one entry per drain first. Only an entry
+  // that keeps stalling a drain on its own is moved aside, requeuetrxs brings it back.
+  auto qitr = queue.begin();
+  if (stats.scheduled_at != 0) {
+    if (qitr->id >= stats.isolate_until) {
+      stats.isolate_until = qitr->id + config_get("trxq.batch"_n);
+      stats.head_id = qitr->id;
+      stats.head_stalls = 0;
+    } else if (stats.head_id == qitr->id) {
+      stats.head_stalls += 1;
+    } else {
+      stats.head_id = qitr->id;
+      stats.head_stalls = 1;
+    }
+
+    if (stats.head_stalls >= queue_max_stalls) {
+      trx_queue_failed_tables failed(get_self(), get_self().value);
+      failed.emplace(_self, [&](auto & item){
+        item = *qitr;
+      });
+      queue.erase(qitr);
+      stats.moved_aside += 1;
+      stats.head_stalls = 0;
+    }
+  }
+
+  stats.scheduled_at = timestamp;
+  drainstats.set(stats, get_self());
+
+  send_drain_queue();
+}
+
+void history::send_drain_queue () {
   action a(
-    permission_level{contracts::history, "active"_n},
+    permission_level{get_self(), "active"_n},
     get_self(),
-    "savepoints"_n,
-    std::make_tuple(transaction_id, timestamp)
+    "drainqueue"_n,
+    std::make_tuple()
   );
 
   transaction tx;
   tx.actions.emplace_back(a);
   tx.delay_sec = 1;
-  tx.send(deferred_id, _self);
+  tx.send("drainqueue"_n.value, _self, true);
+}
+
+void history::drainqueue () {
+  require_auth(get_self());
+
+  drain_stats_tables drainstats(get_self(), get_self().value);
+  drain_stats_table stats = drainstats.get_or_create(get_self(), drain_stats_table());
+
+  trx_queue_tables queue(get_self(), get_self().value);
+  auto qitr = queue.begin();
+
+  bool isolating = qitr != queue.end() && qitr->id < stats.isolate_until;
+  uint64_t batch_size = isolating ? 1 : config_get("trxq.batch"_n);
+  uint64_t now = eosio::current_time_point().sec_since_epoch();
+  uint64_t count = 0;
+  uint64_t skipped = 0;
+  uint64_t max_lag = 0;
+  std::map<name, int32_t> rewards;
+
+  while (qitr != queue.end() && count < batch_size) {
+    max_lag = std::max(max_lag, now - qitr->timestamp);
+
+    if (save_points(qitr->transaction_id, qitr->day)) {
+      trx_cbp_rewards(qitr->from, qitr->to, rewards);
+    } else {
+      skipped++;
+    }
+
+    qitr = queue.erase(qitr);
+    count++;
+  }
+
+  stats.batches += 1;
+
+  // the cbs rewards of the whole batch go out in one deferred transaction, a failing addcbs
+  // must not revert the batch and pin the queue head
+  std::vector<CbsReward> batch_rewards;
+  for (auto & reward : rewards) {
+    if (reward.second != 0) {
+      batch_rewards.push_back(CbsReward{ reward.first, reward.second });
+    }
+  }
+
+  if (!batch_rewards.empty()) {
+    action a(
+      permission_level{get_self(), "active"_n},
+      get_self(),
+      "sendcbsrwds"_n,
+      std::make_tuple(batch_rewards)
+    );
+
+    transaction tx;
+    tx.actions.emplace_back(a);
+    tx.delay_sec = 1;
+    tx.send((uint128_t("sendcbsrwds"_n.value) << 64) + stats.batches, _self);
+  }
+
+  stats.processed += count;
+  stats.skipped += skipped;
+  stats.last_batch_size = count;
+  stats.last_max_lag = max_lag;
+  stats.last_left_pending = qitr != queue.end();
+  stats.last_drained_at = now;
+  stats.scheduled_at = qitr != queue.end() ? now : 0;
+  stats.head_stalls = 0;
+  // queue ids start over once it is empty
+  if (qitr == queue.end() || qitr->id >= stats.isolate_until) {
+    stats.isolate_until = 0;
+  }
+
+  drainstats.set(stats, get_self());
+
+  if (qitr != queue.end()) {
+    send_drain_queue();
+  }
+}
+
+void history::sendcbsrwds (std::vector<CbsReward> rewards) {
+  require_auth(get_self());
+  for (auto & reward : rewards) {
+    send_add_cbs(reward.account, reward.points);
+  }
+}
+
+void history::requeuetrxs (uint64_t chunksize) {
+  require_auth(get_self());
+
+  trx_queue_failed_tables failed(get_self(), get_self().value);
+  trx_queue_tables queue(get_self(), get_self().value);
+
+  auto fitr = failed.begin();
+  uint64_t count = 0;
+
+  while (fitr != failed.end() && count < chunksize) {
+    queue.emplace(_self, [&](auto & item){
+      item = *fitr;
+      item.id = queue.available_primary_key();
+    });
+    fitr = failed.erase(fitr);
+    count++;
+  }
+
+  if (count == 0) { return; }
+
+  drain_stats_tables drainstats(get_self(), get_self().value);
+  drain_stats_table stats = drainstats.get_or_create(get_self(), drain_stats_table());
+  stats.requeued += count;
+  stats.scheduled_at = eosio::current_time_point().sec_since_epoch();
+  drainstats.set(stats, get_self());
+
+  send_drain_queue();
 }
 
 uint64_t history::get_deferred_id () {
@@ -264,16 +460,30 @@ void history::savepoints(uint64_t id, uint64_t timestamp) {
   auto date = eosio::time_point_sec(timestamp / 86400 * 86400);
   uint64_t day = date.utc_seconds;
 
+  daily_transactions_tables transactions(get_self(), day);
+  auto titr = transactions.require_find(id, "transaction not found");
+  name from = titr -> from;
+  name to = titr -> to;
+
+  save_points(id, day);
+
+  std::map<name, int32_t> rewards;
+  trx_cbp_rewards(from, to, rewards);
+  send_cbs_rewards(rewards);
+}
+
+bool history::save_points(uint64_t id, uint64_t day) {
   daily_transactions_tables transactions(get_self(), day);
   auto transactions_by_from_to = transactions.get_index<"byfromto"_n>();
 
   auto titr = transactions.find(id);
-  check(titr != transactions.end(), "transaction not found");
+  if (titr == transactions.end()) { return false; }
   name from = titr -> from;
   name to = titr -> to;
 
-  auto uitr_from = users.find(from.value);
-  auto uitr_to = users.find(to.value);
+  utils::user_core user_from = utils::get_user_core(from);
+  utils::user_core user_to = utils::get_user_core(to);
+  if (!user_from.exists || !user_to.exists) { return false; }
 
   uint64_t max_number_transactions = config_get("htry.trx.max"_n);
 
@@ -327,24 +537,8 @@ void history::savepoints(uint64_t id, uint64_t timestamp) {
   if (save_points) {
     save_from_metrics (from, from_points, qualifying_volume, day);
 
-    if (uitr_to -> type == name("organisation")) {
-      transaction_points_tables trx_points_to(get_self(), to.value);
-      auto trx_itr_to = trx_points_to.find(day);
-
-      if (trx_itr_to != trx_points_to.end()) {
-        trx_points_to.modify(trx_itr_to, _self, [&](auto & item){
-          item.points += to_points;
-        });
-      } else {
-        trx_points_to.emplace(_self, [&](auto & item){
-          item.timestamp = day;
-          item.points = to_points;
-        });
-      }
-    }
-
-    if (uitr_from -> type != name("organisation")) {
-      send_update_txpoints(from);
+    if (user_to.type == name("organisation")) {
+      save_to_points(to, to_points, day);
     }
 
     ptrx_t.emplace(_self, [&](auto & ptrx){
@@ -354,7 +548,7 @@ void history::savepoints(uint64_t id, uint64_t timestamp) {
     });
   }
 
-  send_trx_cbp_reward_action(from, to);
+  return true;
 }
 
 void history::save_from_metrics (name from, int64_t & from_points, int64_t & qualifying_volume, uint64_t & day) {
@@ -366,6 +560,8 @@ void history::save_from_metrics (name from, int64_t & from_points, int64_t & qua
   auto qev_itr = qevs.find(day);
   auto qev_total_itr = qevs_total.find(day);
 
+  bool in_window = day >= trx_points_cutoff();
+
   if (trx_itr != trx_points_from.end()) {
     trx_points_from.modify(trx_itr, _self, [&](auto & item){
       item.points += from_points;
@@ -375,6 +571,13 @@ void history::save_from_metrics (name from, int64_t & from_points, int64_t & qua
       item.timestamp = day;
       item.points = from_points;
     });
+    if (in_window) {
+      add_trx_expiry(from, day);
+    }
+  }
+
+  if (in_window) {
+    change_trx_points_sum(from, from_points);
   }
 
   if (qev_itr != qevs.end()) {
@@ -398,23 +601,274 @@ void history::save_from_metrics (name from, int64_t & from_points, int64_t & qua
       item.qualifying_volume = qualifying_volume;
     });
   }
+
+  change_qev_sum(day, qualifying_volume);
 }
 
-void history::send_trx_cbp_reward_action (name from, name to) {
+void history::change_qev_sum (uint64_t day, int64_t delta) {
+  if (delta == 0) { return; }
 
-  uint64_t deferred_id = get_deferred_id();
+  qev_sum_tables qevsums(get_self(), get_self().value);
+  auto sitr = qevsums.find(day);
 
-  action a(
-    permission_level(get_self(), "active"_n),
-    get_self(),
-    "sendtrxcbp"_n,
-    std::make_tuple(deferred_id, from, to)
-  );
+  if (sitr == qevsums.end()) {
+    uint64_t previous = 0;
+    auto pitr = qevsums.lower_bound(day);
+    if (pitr != qevsums.begin()) {
+      pitr--;
+      previous = pitr->cumulative_volume;
+    }
+    sitr = qevsums.emplace(_self, [&](auto & item){
+      item.timestamp = day;
+      item.cumulative_volume = previous;
+    });
+  }
 
-  transaction tx;
-  tx.actions.emplace_back(a);
-  tx.delay_sec = 1;
-  tx.send(deferred_id, _self);
+  // later days only exist when a past day is changed, normally day is the newest row
+  while (sitr != qevsums.end()) {
+    qevsums.modify(sitr, _self, [&](auto & item){
+      item.cumulative_volume += delta;
+    });
+    sitr++;
+  }
+}
+
+void history::save_to_points (name to, int64_t to_points, uint64_t day) {
+  transaction_points_tables trx_points_to(get_self(), to.value);
+  auto trx_itr_to = trx_points_to.find(day);
+
+  bool in_window = day >= trx_points_cutoff();
+
+  if (trx_itr_to != trx_points_to.end()) {
+    trx_points_to.modify(trx_itr_to, _self, [&](auto & item){
+      item.points += to_points;
+    });
+  } else {
+    trx_points_to.emplace(_self, [&](auto & item){
+      item.timestamp = day;
+      item.points = to_points;
+    });
+    if (in_window) {
+      add_trx_expiry(to, day);
+    }
+  }
+
+  if (in_window) {
+    change_trx_points_sum(to, to_points);
+  }
+}
+
+void history::change_trx_points_sum (name account, int64_t delta) {
+  trx_points_sum_tables sums(get_self(), get_self().value);
+  auto sitr = sums.find(account.value);
+
+  uint64_t now = eosio::current_time_point().sec_since_epoch();
+
+  if (sitr == sums.end()) {
+    if (delta <= 0) { return; }
+    sums.emplace(_self, [&](auto & item){
+      item.account = account;
+      item.points = uint64_t(delta);
+      item.updated_at = now;
+    });
+  } else {
+    sums.modify(sitr, _self, [&](auto & item){
+      if (delta < 0 && item.points < uint64_t(-delta)) {
+        item.points = 0;
+      } else {
+        item.points += delta;
+      }
+      item.updated_at = now;
+    });
+  }
+}
+
+void history::add_trx_expiry (name account, uint64_t day) {
+  trx_expiry_tables expiry(get_self(), day);
+
+  if (expiry.find(account.value) == expiry.end()) {
+    expiry.emplace(_self, [&](auto & item){
+      item.account = account;
+    });
+  }
+
+  expiry_cursor_tables expirycursor(get_self(), get_self().value);
+  expiry_cursor_table cursor = expirycursor.get_or_create(get_self(), expiry_cursor_table());
+
+  if (cursor.next_day == 0 || day < cursor.next_day) {
+    cursor.next_day = day;
+    expirycursor.set(cursor, get_self());
+  }
+}
+
+uint64_t history::trx_points_cutoff () {
+  uint64_t now = eosio::current_time_point().sec_since_epoch();
+  return now - (utils::moon_cycle * config_float_get("cyctrx.trail"_n));
+}
+
+// Takes the points of the days that fell out of the cyctrx.trail window off the trxptsums
+void history::expiretrx () {
+  require_auth(get_self());
+
+  expiry_cursor_tables expirycursor(get_self(), get_self().value);
+  expiry_cursor_table cursor = expirycursor.get_or_create(get_self(), expiry_cursor_table());
+
+  if (cursor.next_day == 0) { return; }
+
+  uint64_t cutoff = trx_points_cutoff();
+  uint64_t batch_size = config_get("batchsize"_n);
+  uint64_t count = 0;
+
+  while (cursor.next_day < cutoff && count < batch_size) {
+    trx_expiry_tables expiry(get_self(), cursor.next_day);
+    auto eitr = expiry.begin();
+
+    while (eitr != expiry.end() && count < batch_size) {
+      transaction_points_tables trx_points(get_self(), eitr->account.value);
+      auto titr = trx_points.find(cursor.next_day);
+
+      if (titr != trx_points.end()) {
+        change_trx_points_sum(eitr->account, -int64_t(titr->points));
+      }
+
+      eitr = expiry.erase(eitr);
+      count++;
+    }
+
+    if (eitr != expiry.end()) { break; }
+
+    cursor.next_day += utils::seconds_per_day;
+    count++;
+  }
+
+  expirycursor.set(cursor, get_self());
+
+  if (cursor.next_day < cutoff) {
+    action a(
+      permission_level{get_self(), "active"_n},
+      get_self(),
+      "expiretrx"_n,
+      std::make_tuple()
+    );
+
+    transaction tx;
+    tx.actions.emplace_back(a);
+    tx.delay_sec = 1; 
+    tx.send(get_deferred_id(), _self);
+  }
+}
+
+// Builds the trxptsums and the expiry lists from the existing trxpoints rows
+void history::migtrxsums (uint64_t start, uint64_t chunksize) {
+  require_auth(get_self());
+
+  uint64_t cutoff = trx_points_cutoff();
+  trx_points_sum_tables sums(get_self(), get_self().value);
+
+  auto uitr = start == 0 ? users.begin() : users.lower_bound(start);
+  uint64_t count = 0;
+
+  while (uitr != users.end() && count < chunksize) {
+    transaction_points_tables trx_points(get_self(), uitr->account.value);
+    uint64_t total_points = 0;
+
+    auto titr = trx_points.rbegin();
+    while (titr != trx_points.rend() && titr->timestamp >= cutoff) {
+      total_points += titr->points;
+      add_trx_expiry(uitr->account, titr->timestamp);
+      titr++;
+      count++;
+    }
+
+    auto sitr = sums.find(uitr->account.value);
+    if (sitr != sums.end()) {
+      sums.erase(sitr);
+    }
+    change_trx_points_sum(uitr->account, int64_t(total_points));
+
+    uitr++;
+    count++;
+  }
+
+  if (uitr != users.end()) {
+    action next_execution(
+      permission_level{get_self(), "active"_n},
+      get_self(),
+      "migtrxsums"_n,
+      std::make_tuple(uitr->account.value, chunksize)
+    );
+
+    transaction tx;
+    tx.actions.emplace_back(next_execution);
+    tx.delay_sec = 1;
+    tx.send(uitr->account.value, _self);
+  }
+}
+
+// Builds qevsums from the existing total qevs rows, oldest day first
+void history::migqevsums (uint64_t start, uint64_t chunksize) {
+  require_auth(get_self());
+
+  qev_tables qevs_total(get_self(), get_self().value);
+  qev_sum_tables qevsums(get_self(), get_self().value);
+
+  if (start == 0) {
+    set_qev_sums_ready(false);
+  }
+
+  uint64_t running_total = 0;
+  if (start != 0) {
+    auto pitr = qevsums.lower_bound(start);
+    if (pitr != qevsums.begin()) {
+      pitr--;
+      running_total = pitr->cumulative_volume;
+    }
+  }
+
+  auto qitr = start == 0 ? qevs_total.begin() : qevs_total.lower_bound(start);
+  uint64_t count = 0;
+
+  while (qitr != qevs_total.end() && count < chunksize) {
+    running_total += qitr->qualifying_volume;
+
+    auto sitr = qevsums.find(qitr->timestamp);
+    if (sitr != qevsums.end()) {
+      qevsums.modify(sitr, _self, [&](auto & item){
+        item.cumulative_volume = running_total;
+      });
+    } else {
+      qevsums.emplace(_self, [&](auto & item){
+        item.timestamp = qitr->timestamp;
+        item.cumulative_volume = running_total;
+      });
+    }
+
+    qitr++;
+    count++;
+  }
+
+  if (qitr != qevs_total.end()) {
+    action next_execution(
+      permission_level{get_self(), "active"_n},
+      get_self(),
+      "migqevsums"_n,
+      std::make_tuple(qitr->timestamp, chunksize)
+    );
+
+    transaction tx;
+    tx.actions.emplace_back(next_execution);
+    tx.delay_sec = 1;
+    tx.send(get_deferred_id(), _self);
+  } else {
+    set_qev_sums_ready(true);
+  }
+}
+
+void history::set_qev_sums_ready (bool ready) {
+  qev_sum_state_tables qevsumstate(get_self(), get_self().value);
+  qev_sum_state_table state = qevsumstate.get_or_create(get_self(), qev_sum_state_table());
+  state.ready = ready;
+  qevsumstate.set(state, get_self());
 }
 
 void history::send_add_cbs (name account, int points) {
@@ -426,7 +880,8 @@ void history::send_add_cbs (name account, int points) {
   ).send();
 }
 
-void history::trx_cbp_reward (name account, name key) {
+// records the reward and returns its points, 0 if the account already got it this moon cycle
+int32_t history::trx_cbp_reward (name account, name key) {
 
   auto trxcbprewards_by_acct_key = trxcbprewards.get_index<"byacctkey"_n>();
 
@@ -438,7 +893,7 @@ void history::trx_cbp_reward (name account, name key) {
   if (itr != trxcbprewards_by_acct_key.end()) {
 
     uint64_t threshold = now - utils::moon_cycle;
-    if (itr->timestamp > threshold) { return; }
+    if (itr->timestamp > threshold) { return 0; }
 
     trxcbprewards_by_acct_key.modify(itr, _self, [&](auto & item){
       item.timestamp = now;
@@ -453,20 +908,35 @@ void history::trx_cbp_reward (name account, name key) {
     });
   }
 
-  send_add_cbs(account, int(config_get(key)));
+  return int32_t(config_get(key));
+}
+
+void history::send_cbs_rewards (const std::map<name, int32_t> & rewards) {
+  for (auto & reward : rewards) {
+    if (reward.second != 0) {
+      send_add_cbs(reward.first, reward.second);
+    }
+  }
 }
 
 void history::sendtrxcbp (uint64_t deferred_id, name from, name to) {
   require_auth(get_self());
 
+  std::map<name, int32_t> rewards;
+  trx_cbp_rewards(from, to, rewards);
+  send_cbs_rewards(rewards);
+}
+
+// adds the cbs rewards the transfer earns to rewards, by account
+void history::trx_cbp_rewards (name from, name to, std::map<name, int32_t> & rewards) {
   auto oitr = organizations.find(to.value);
 
   if (oitr != organizations.end()) {
     if (oitr->status == status_regenerative) {
-      trx_cbp_reward(from, "buyregen.cbp"_n);
+      rewards[from] += trx_cbp_reward(from, "buyregen.cbp"_n);
     }
     if (oitr->status == status_thrivable) {
-      trx_cbp_reward(from, "buythriv.cbp"_n);
+      rewards[from] += trx_cbp_reward(from, "buythriv.cbp"_n);
     }
   }
 
@@ -478,7 +948,7 @@ void history::sendtrxcbp (uint64_t deferred_id, name from, name to) {
     bitr_to != members.end() && 
     bitr_from->region == bitr_to->region
   ) {
-    trx_cbp_reward(from, "buylocal.cbp"_n);
+    rewards[from] += trx_cbp_reward(from, "buylocal.cbp"_n);
   }
 }
 
@@ -557,24 +1027,6 @@ void history::updatetxpt (uint64_t deferred_id, name from) {
   );
 }
 
-void history::send_update_txpoints (name from) {
-  // delayed update
-
-  uint64_t deferred_id = get_deferred_id();
-
-  action a(
-    permission_level{get_self(), "active"_n},
-    get_self(),
-    "updatetxpt"_n,
-    std::make_tuple(deferred_id, from)
-  );
-
-  transaction tx;
-  tx.actions.emplace_back(a);
-  tx.delay_sec = 1; 
-  tx.send(deferred_id, _self);
-}
-
 void history::numtrx(name account) {
   auto titr = totals.find(account.value);
   uint64_t num = 0;
@@ -589,8 +1041,7 @@ void history::numtrx(name account) {
 
 void history::check_user(name account)
 {
-  auto uitr = users.find(account.value);
-  check(uitr != users.end(), "no user");
+  check(utils::get_user_core(account).exists, "no user");
 }
 
 uint64_t history::config_get(name key) {
@@ -598,11 +1049,7 @@ uint64_t history::config_get(name key) {
   DEFINE_CONFIG_TABLE_MULTI_INDEX
   config_tables config(contracts::settings, contracts::settings.value);
 
-  auto citr = config.find(key.value);
-  if (citr == config.end()) { 
-    check(false, ("settings: the "+key.to_string()+" parameter has not been initialized").c_str());
-  }
-  return citr->value;
+  return config_cache.get(config, key);
 }
 
 double history::config_float_get(name key) {
@@ -610,11 +1057,7 @@ double history::config_float_get(name key) {
   DEFINE_CONFIG_FLOAT_TABLE_MULTI_INDEX
   config_float_tables config(contracts::settings, contracts::settings.value);
 
-  auto citr = config.find(key.value);
-  if (citr == config.end()) { 
-    check(false, ("settings: the "+key.to_string()+" parameter has not been initialized").c_str());
-  }
-  return citr->value;
+  return config_float_cache.get(config, key);
 }
 
 
@@ -631,10 +1074,12 @@ void history::testtotalqev (uint64_t numdays, uint64_t volume) {
     auto qitr = qevs_total.find(current_day);
 
     if (qitr != qevs_total.end()) {
+      change_qev_sum(current_day, int64_t(volume) - int64_t(qitr->qualifying_volume));
       qevs_total.modify(qitr, _self, [&](auto & item){
         item.qualifying_volume = volume;
       });
     } else {
+      change_qev_sum(current_day, int64_t(volume));
       qevs_total.emplace(_self, [&](auto & item){
         item.timestamp = current_day;
         item.qualifying_volume = volume;
@@ -850,18 +1295,7 @@ void history::adjust_transactions (uint64_t id, uint64_t timestamp) {
   save_from_metrics(from, from_points, qualifying_volume, day);
   
   if (uitr_to -> type == name("organisation")) {
-    transaction_points_tables trx_points_to(get_self(), to.value);
-    auto trx_itr_to = trx_points_to.find(day);
-    if (trx_itr_to != trx_points_to.end()) {
-      trx_points_to.modify(trx_itr_to, _self, [&](auto & item){
-        item.points += to_points;
-      });
-    } else {
-      trx_points_to.emplace(_self, [&](auto & item){
-        item.timestamp = day;
-        item.points = to_points;
-      });
-    }
+    save_to_points(to, to_points, day);
   }
 }
 
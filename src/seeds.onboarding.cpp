@@ -645,12 +645,7 @@ void onboarding::check_user(name account)
 
 uint64_t onboarding::config_get(name key)
 {
-  auto citr = config.find(key.value);
-  if (citr == config.end())
-  {
-    check(false, ("settings: the " + key.to_string() + " parameter has not been initialized").c_str());
-  }
-  return citr->value;
+  return config_cache.get(config, key);
 }
 
 ACTION onboarding::createcampg(
@@ -75,12 +75,7 @@ void organization::decrease_size_by_one(name id) {
 }
 
 uint64_t organization::config_get (name key) {
-    auto citr = config.find(key.value);
-        if (citr == config.end()) { 
-        // only create the error message string in error case for efficiency
-        eosio::check(false, ("settings: the "+key.to_string()+" parameter has not been initialized").c_str());
-    }
-    return citr->value;
+    return config_cache.get(config, key);
 }
 
 
@@ -162,6 +157,11 @@ ACTION organization::reset() {
         dsitr = dausscores.erase(dsitr);
     }
 
+    auto tritr = apptrails.begin();
+    while (tritr != apptrails.end()) {
+        tritr = apptrails.erase(tritr);
+    }
+
     auto bitr = sponsors.begin();
     while(bitr != sponsors.end()){
         bitr = sponsors.erase(bitr);
@@ -652,6 +652,9 @@ ACTION organization::appuse (name appname, name account) {
     uint64_t points = uitr.status == "citizen"_n ? config_get("dau.cit.pt"_n) : config_get("dau.res.pt"_n);
     points *= utils::get_rep_multiplier(account);
 
+    int64_t added_points = 0;
+    uint64_t added_users = 0;
+
     if (ditr != daus_by_day_account.end()) {
         uint64_t max_uses = config_get("dau.maxuse"_n);
         if (ditr->number_app_uses < max_uses) {
@@ -662,6 +665,7 @@ ACTION organization::appuse (name appname, name account) {
             daus_totals.modify(dtitr, _self, [&](auto & item){
                 item.daily_points += points;
             });
+            added_points = points;
         }
     } else {
         daus.emplace(_self, [&](auto & item){
@@ -685,6 +689,16 @@ ACTION organization::appuse (name appname, name account) {
             });
         }
 
+        added_points = points;
+        added_users = 1;
+    }
+
+    auto tritr = apptrails.find(appname.value);
+    if (added_points > 0 && tritr != apptrails.end() && day >= tritr->window_start) {
+        apptrails.modify(tritr, _self, [&](auto & item){
+            item.trailing_points += added_points;
+            item.trailing_uses += added_users;
+        });
     }
 }
 
@@ -714,15 +728,15 @@ ACTION organization::calcmappuse (uint64_t start, uint64_t chunksize, uint64_t t
         print("app:", appitr->app_name, "\n");
 
         if (!appitr->is_banned) {
-            calculate_trailing_app_use(appitr->app_name, cutoff, threshold);
+            count += calculate_trailing_app_use(appitr->app_name, cutoff, threshold);
         } else {
             auto dsitr = dausscores.find(appitr->app_name.value);
             if (dsitr != dausscores.end()) {
                 dausscores.erase(dsitr);
             }
+            count++;
         }
         appitr++;
-        count += 4;
     }
 
     if (appitr != apps.end()) {
@@ -739,20 +753,65 @@ ACTION organization::calcmappuse (uint64_t start, uint64_t chunksize, uint64_t t
     }
 }
 
-void organization::calculate_trailing_app_use (const name & appname, const uint64_t & cutoff, const int64_t & threshold) {
+// Moves the app's trailing window up to cutoff and updates its dausscores row
+// returns the number of rows touched, so calcmappuse can budget its chunk
+uint64_t organization::calculate_trailing_app_use (const name & appname, const uint64_t & cutoff, const int64_t & threshold) {
 
     daus_totals_tables daus_totals(get_self(), appname.value);
+    uint64_t work = 1;
 
-    int64_t trailing_points = 0;
-    uint64_t trailing_uses = 0;
+    auto tritr = apptrails.find(appname.value);
+
+    if (tritr == apptrails.end() || cutoff < tritr->window_start) {
+        // no trail yet, or dau.cyc was raised: sum the window once
+        int64_t trailing_points = 0;
+        uint64_t trailing_uses = 0;
+
+        auto dtitr = daus_totals.lower_bound(cutoff);
+        while (dtitr != daus_totals.end()) {
+            trailing_points += dtitr->daily_points;
+            trailing_uses += dtitr->daily_users;
+            dtitr++;
+            work++;
+        }
+
+        if (tritr == apptrails.end()) {
+            tritr = apptrails.emplace(_self, [&](auto & item){
+                item.app_name = appname;
+                item.trailing_points = trailing_points;
+                item.trailing_uses = trailing_uses;
+                item.window_start = cutoff;
+            });
+        } else {
+            apptrails.modify(tritr, _self, [&](auto & item){
+                item.trailing_points = trailing_points;
+                item.trailing_uses = trailing_uses;
+                item.window_start = cutoff;
+            });
+        }
+    } else {
+        // subtract the days that left the window since the last run
+        int64_t expired_points = 0;
+        uint64_t expired_uses = 0;
+
+        auto dtitr = daus_totals.lower_bound(tritr->window_start);
+        while (dtitr != daus_totals.end() && dtitr->day < cutoff) {
+            expired_points += dtitr->daily_points;
+            expired_uses += dtitr->daily_users;
+            dtitr++;
+            work++;
+        }
 
-    auto dtitr = daus_totals.rbegin();
-    while (dtitr != daus_totals.rend() && dtitr->day >= cutoff) {
-        trailing_points += dtitr->daily_points;
-        trailing_uses += dtitr->daily_users;
-        dtitr++;
+        apptrails.modify(tritr, _self, [&](auto & item){
+            item.trailing_points -= expired_points;
+            item.trailing_uses -= expired_uses;
+            item.window_start = cutoff;
+        });
     }
 
+    int64_t trailing_points = tritr->trailing_points;
+    uint64_t trailing_uses = tritr->trailing_uses;
+
     auto dsitr = dausscores.find(appname.value);
     if (dsitr != dausscores.end()) {
         if (trailing_points >= threshold) {
@@ -773,6 +832,55 @@ void organization::calculate_trailing_app_use (const name & appname, const uint6
         });
         increase_size_by_one(app_use_size);
     }
+
+    return work;
+}
+
+// daus rows are only needed for the current day's dau.maxuse check, older days live on in daustotals
+ACTION organization::cleandaus () {
+    require_auth(get_self());
+    uint64_t batch_size = config_get("batchsize"_n);
+    cleandau(uint64_t(0), batch_size);
+}
+
+ACTION organization::cleandau (uint64_t start, uint64_t chunksize) {
+    require_auth(get_self());
+
+    uint64_t today = utils::get_beginning_of_day_in_seconds();
+
+    auto appitr = start == 0 ? apps.begin() : apps.find(start);
+    uint64_t count = 0;
+
+    while (appitr != apps.end() && count < chunksize) {
+        daus_tables daus(get_self(), appitr->app_name.value);
+        auto daus_by_day_account = daus.get_index<"bydayacct"_n>();
+
+        auto ditr = daus_by_day_account.begin();
+        while (ditr != daus_by_day_account.end() && ditr->day < today && count < chunksize) {
+            ditr = daus_by_day_account.erase(ditr);
+            count++;
+        }
+
+        if (ditr != daus_by_day_account.end() && ditr->day < today) {
+            break; // continue with this app in the next chunk
+        }
+
+        appitr++;
+        count++;
+    }
+
+    if (appitr != apps.end()) {
+        action next_execution(
+            permission_level(get_self(), "active"_n),
+            get_self(),
+            "cleandau"_n,
+            std::make_tuple((appitr->app_name).value, chunksize)
+        );
+        transaction tx;
+        tx.actions.emplace_back(next_execution);
+        tx.delay_sec = 1;
+        tx.send("cleandau"_n.value, _self);
+    }
 }
 
 ACTION organization::rankappuses () {
@@ -18,6 +18,14 @@ ACTION pool::reset () {
   while (sitr != sizes.end()) {
     sitr = sizes.erase(sitr);
   }
+
+  poolindex.remove();
+  sweepstate.remove();
+
+  auto eitr = epochs.begin();
+  while (eitr != epochs.end()) {
+    eitr = epochs.erase(eitr);
+  }
 }
 
 
@@ -33,6 +41,7 @@ ACTION pool::ontransfer (name from, name to, asset quantity, string memo) {
     name account = name(memo);
     check(is_account(account), account.to_string() + " is not an account");
 
+    settle_balance(account);
     add_balance(account, quantity, get_self());
     size_change(total_balance_size, quantity.amount);
   }}
@@ -50,9 +59,12 @@ void pool::add_balance( const name& owner, const asset& value, const name& ram_p
 {
    const auto& bal_to = balances.find( owner.value );
    if( bal_to == balances.end() ) {
+      pool_index_table index = get_pool_index();
       balances.emplace( get_self(), [&]( auto& a ){
         a.account = owner;
         a.balance = value;
+        a.settled_index = index.balance_index;
+        a.settled_epoch = index.epoch;
       });
       accounts acct(get_self(), owner.value);
       const auto& aitr = acct.find(utils::pool_symbol.raw());
@@ -102,11 +114,16 @@ ACTION pool::transfer(name from, name to, asset quantity, const string& memo)
 {
   check(quantity.symbol == utils::pool_symbol, "poolxfr: unknown token");
   quantity.symbol = utils::seeds_symbol;
-  auto& bal_from = balances.get(from.value, "poolxfr: unknown sender");
+  check(balances.find(from.value) != balances.end(), "poolxfr: unknown sender");
   require_auth(from);
   check(is_account(to), "poolxfr: " + to.to_string() + " is not an account");
   check( quantity.amount > 0, "poolxfr: must transfer positive quantity" );
   check( memo.size() <= 256, "poolxfr: memo has more than 256 bytes" );
+  // both balances have to be current before one moves to the other
+  settle_balance( from );
+  settle_balance( to );
+  auto bal_from = balances.find(from.value);
+  check( bal_from != balances.end(), "poolxfr: overdrawn balance" );
   bool emptied = sub_balance( from, quantity );
   if( emptied ) { balances.erase(bal_from); }
   name payer = get_self(); // TBD: make from acct pay ram, or a SEEDS fee?
@@ -117,52 +134,96 @@ ACTION pool::payouts (asset quantity) {
 
   require_auth(get_self());
 
-  uint64_t batch_size = config_get("batchsize"_n);
-  payout(quantity, uint64_t(0), batch_size, uint64_t(0));
+  int64_t total_balance = int64_t(get_size(total_balance_size));
+
+  if (total_balance <= 0) { return; }
+  if (quantity.amount <= 0) { return; }
+  if (total_balance < quantity.amount) { return; }
+
+  // holders receive their part when their balance is next settled
+  pool_index_table index = get_pool_index();
+
+  uint128_t next_index = quantity.amount == total_balance ?
+    0 : (index.balance_index * uint128_t(total_balance - quantity.amount)) / uint128_t(total_balance);
+
+  // a payout of everything ends the epoch at 0, an index that got too small to keep its
+  // precision ends it where it is and the next epoch starts again from the full scale
+  if (next_index < balance_index_floor) {
+    epochs.emplace(_self, [&](auto & item){
+      item.epoch = index.epoch;
+      item.end_index = next_index;
+    });
+    index.balance_index = balance_index_scale;
+    index.epoch += 1;
+  } else {
+    index.balance_index = next_index;
+  }
+  index.timestamp = eosio::current_time_point().sec_since_epoch();
+
+  poolindex.set(index, get_self());
+  size_change(total_balance_size, -1 * quantity.amount);
 
 }
 
+ACTION pool::claim (name account) {
 
-ACTION pool::payout (asset quantity, uint64_t start, uint64_t chunksize, int64_t old_total_balance) {
+  check(has_auth(account) || has_auth(get_self()), "pool: missing authority of " + account.to_string());
+  check(balances.find(account.value) != balances.end(), "pool: " + account.to_string() + " has no balance");
 
-  require_auth(get_self());
+  settle_balance(account);
 
-  auto bitr = start == 0 ? balances.begin() : balances.lower_bound(start);
-  uint64_t current = 0;
+}
 
-  int64_t total_balance = old_total_balance == 0 ? int64_t(get_size(total_balance_size)) : old_total_balance;
+// settles every holder, for accounts that do not claim or transfer.
+// Settled balances round down what they owe, so once every holder has been settled at the
+// same index the rounding dust is added back to total.sz by setting it to the sum of balances
+ACTION pool::sweep (uint64_t start, uint64_t chunksize) {
 
-  if (total_balance <= 0) { return; }
-  if (quantity.amount <= 0) { return; }
-  if (total_balance < quantity.amount) { return; }
+  require_auth(get_self());
 
-  double total_balance_divisor = double(total_balance);
-  string memo("dSeeds pool distribution");
+  pool_index_table index = get_pool_index();
+  int64_t total_balance = int64_t(get_size(total_balance_size));
 
-  while (bitr != balances.end() && current < chunksize) {
+  if (start == 0) {
+    sweepstate.set(sweep_state_table{ index.balance_index, index.epoch, total_balance, 0 }, get_self());
+  }
 
-    double percentage = bitr->balance.amount / total_balance_divisor;
-    asset amount_to_payout = asset(std::min(bitr->balance.amount, int64_t(percentage * quantity.amount)), utils::seeds_symbol);
-    
+  sweep_state_table state = sweepstate.get_or_default(sweep_state_table{ 0, 0, 0, 0 });
+
+  auto bitr = start == 0 ? balances.begin() : balances.lower_bound(start);
+  uint64_t count = 0;
+
+  while (bitr != balances.end() && count < chunksize) {
     name account = bitr->account;
-    send_transfer(account, amount_to_payout, memo);
-    size_change(total_balance_size, -1 * amount_to_payout.amount);
+    bitr++;
+    settle_balance(account);
 
-    bool emptied = sub_balance( account, amount_to_payout );
-    if( emptied ) {
-      bitr = balances.erase(bitr);
-    } else {
-      bitr++;
+    auto sitr = balances.find(account.value);
+    if (sitr != balances.end()) {
+      state.sum += sitr->balance.amount;
     }
-    current += 8;
+    count++;
+  }
+
+  // a payout or deposit during the sweep leaves holders settled at different points
+  bool unchanged = sweepstate.exists() &&
+    state.balance_index == index.balance_index && state.epoch == index.epoch && state.total == total_balance;
+
+  if (bitr == balances.end()) {
+    if (unchanged) {
+      size_set(total_balance_size, state.sum);
+    }
+    sweepstate.remove();
+  } else if (unchanged) {
+    sweepstate.set(state, get_self());
   }
 
   if (bitr != balances.end()) {
     action next_execution(
       permission_level(get_self(), "active"_n),
       get_self(),
-      "payout"_n,
-      std::make_tuple(asset(quantity.amount, utils::seeds_symbol), bitr->account.value, chunksize, total_balance)
+      "sweep"_n,
+      std::make_tuple(bitr->account.value, chunksize)
     );
 
     transaction tx;
@@ -170,6 +231,66 @@ ACTION pool::payout (asset quantity, uint64_t start, uint64_t chunksize, int64_t
     tx.delay_sec = 1;
     tx.send(bitr->account.value, _self);
   }
+
+}
+
+pool::pool_index_table pool::get_pool_index () {
+  pool_index_table index;
+  index.balance_index = balance_index_scale;
+  index.epoch = 0;
+  index.timestamp = 0;
+  return poolindex.get_or_default(index);
+}
+
+// pays out what the payouts since the last settlement took from the balance of owner
+void pool::settle_balance (const name & owner) {
+
+  auto bitr = balances.find(owner.value);
+  if (bitr == balances.end()) { return; }
+
+  pool_index_table index = get_pool_index();
+
+  // rows written before the index existed hold their balance as of the first epoch's start
+  uint128_t settled_index = bitr->settled_index.has_value() ? bitr->settled_index.value() : balance_index_scale;
+  uint64_t settled_epoch = bitr->settled_epoch.has_value() ? bitr->settled_epoch.value() : 0;
+
+  if (settled_index == index.balance_index && settled_epoch == index.epoch) { return; }
+
+  // what is left rounds up, so a holder is never paid more than its exact share
+  auto remaining_after = [](uint128_t amount, uint128_t to_index, uint128_t from_index) {
+    return (amount * to_index + from_index - 1) / from_index;
+  };
+
+  uint128_t remaining = bitr->balance.amount;
+  if (settled_epoch == index.epoch) {
+    remaining = remaining_after(remaining, index.balance_index, settled_index);
+  } else {
+    // epochs without a row ended with a payout of everything
+    auto eitr = epochs.find(settled_epoch);
+    remaining = remaining_after(remaining, eitr == epochs.end() ? 0 : eitr->end_index, settled_index);
+    for (uint64_t epoch = settled_epoch + 1; epoch < index.epoch && remaining > 0; epoch++) {
+      eitr = epochs.find(epoch);
+      remaining = remaining_after(remaining, eitr == epochs.end() ? 0 : eitr->end_index, balance_index_scale);
+    }
+    remaining = remaining_after(remaining, index.balance_index, balance_index_scale);
+  }
+
+  int64_t owed = bitr->balance.amount - int64_t(remaining);
+
+  if (owed > 0) {
+    send_transfer(owner, asset(owed, utils::seeds_symbol), "dSeeds pool distribution");
+    bool emptied = sub_balance(owner, asset(owed, utils::seeds_symbol));
+    if (emptied) {
+      balances.erase(bitr);
+      return;
+    }
+  }
+
+  balances.modify(bitr, _self, [&](auto & item){
+    item.settled_index = index.balance_index;
+    item.settled_epoch = index.epoch;
+  });
+
 }
 
 void pool::send_transfer (const name & to, const asset & quantity, const string & memo) {
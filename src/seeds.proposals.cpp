@@ -66,6 +66,8 @@ void proposals::reset() {
 
   cycle.remove();
 
+  utils::delete_table<decay_rate_tables>(get_self(), get_self().value);
+
 }
 
 bool proposals::is_enough_stake(asset staked, asset quantity, name fund) {
@@ -848,44 +850,35 @@ void proposals::decayvoices() {
       && (now - c.t_onperiod >= decay_time)
       && (now - c.t_voicedecay >= decay_sec)
   ) {
+    // voice rows are not touched here, each row catches up with the
+    // decay epoch the next time it is read or written
     c.t_voicedecay = now;
+    c.decay_epoch = c.decay_epoch.value_or(0) + 1;
     cycle.set(c, get_self());
-    uint64_t batch_size = config_get(name("batchsize"));
-    decayvoice(0, batch_size);
+    utils::record_decay_rate(get_self(), c.decay_epoch.value(), config_get(name("vdecayprntge")));
   }
 }
 
 void proposals::decayvoice(uint64_t start, uint64_t chunksize) {
   require_auth(get_self());
 
-  voice_tables voice_alliance(get_self(), alliance_type.value);
-  voice_tables voice_milestone(get_self(), milestone_type.value);
+  // materializes pending decay into the voice rows, decayvoices no longer needs it
+  uint64_t epoch = get_decay_epoch();
 
-  uint64_t percentage_decay = config_get(name("vdecayprntge"));
-  check(percentage_decay <= 100, "Voice decay parameter can not be more than 100%.");
   auto vitr = start == 0 ? voice.begin() : voice.find(start);
   uint64_t count = 0;
 
-  double multiplier = (100.0 - (double)percentage_decay) / 100.0;
-
   while (vitr != voice.end() && count < chunksize) {
-    auto vaitr = voice_alliance.find(vitr->account.value);
-    auto hvitr = voice_milestone.find(vitr->account.value);
-
-    voice.modify(vitr, _self, [&](auto & v){
-      v.balance *= multiplier;
-    });
-
-    if (vaitr != voice_alliance.end()) {
-      voice_alliance.modify(vaitr, _self, [&](auto & va){
-        va.balance *= multiplier;
-      });
-    }
+    for (auto & s : scopes) {
+      voice_tables voice_t(get_self(), s.value);
+      auto voice_itr = voice_t.find(vitr->account.value);
 
-    if (hvitr != voice_milestone.end()) {
-      voice_milestone.modify(hvitr, _self, [&](auto & hv){
-        hv.balance *= multiplier;
-      });
+      if (voice_itr != voice_t.end() && voice_itr->decay_epoch.value_or(0) < epoch) {
+        uint64_t balance = get_voice_balance(*voice_itr, s, epoch);
+        voice_t.modify(voice_itr, _self, [&](auto & v){
+          utils::stamp_voice(v, balance, epoch);
+        });
+      }
     }
     vitr++;
     count++;
@@ -907,6 +900,16 @@ void proposals::decayvoice(uint64_t start, uint64_t chunksize) {
   }
 }
 
+uint64_t proposals::get_decay_epoch() {
+  cycle_table c = cycle.get_or_create(get_self(), cycle_table());
+  return c.decay_epoch.value_or(0);
+}
+
+uint64_t proposals::get_voice_balance(const voice_table & v, name scope, uint64_t epoch) {
+  if (scope == referendum_type || v.decay_epoch.value_or(0) >= epoch) { return v.balance; }
+  return utils::decayed_voice_balance(get_self(), v, epoch, utils::voice_decay_multiplier(config_get(name("vdecayprntge"))));
+}
+
 void proposals::update_cycle() {
     cycle_table c = cycle.get_or_create(get_self(), cycle_table());
     c.propcycle += 1;
@@ -1607,6 +1610,7 @@ void proposals::questvote (name user, uint64_t amount, bool reduce, name scope)
 
 double proposals::voice_change (name user, uint64_t amount, bool reduce, name scope) {
   double percentage_used = 0.0;
+  uint64_t epoch = get_decay_epoch();
 
   if (scope == ""_n) {
 
@@ -1620,21 +1624,23 @@ double proposals::voice_change (name user, uint64_t amount, bool reduce, name sc
         check(!reduce, "user can not have negative voice balance");
         voice_t.emplace(_self, [&](auto & voice){
           voice.account = user;
-          voice.balance = amount;
+          utils::stamp_voice(voice, amount, epoch);
         });
       }
       else {
+        uint64_t balance = get_voice_balance(*vitr, s, epoch);
+
         if (reduce) {
-          check(amount <= vitr->balance, s.to_string() + " voice balance exceeded");
+          check(amount <= balance, s.to_string() + " voice balance exceeded");
         }
 
         increase_size = false;
 
         voice_t.modify(vitr, _self, [&](auto & voice){
           if (reduce) {
-            voice.balance -= amount;
+            utils::stamp_voice(voice, balance - amount, epoch);
           } else {
-            voice.balance += amount;
+            utils::stamp_voice(voice, balance + amount, epoch);
           }
         });
       }
@@ -1649,15 +1655,17 @@ double proposals::voice_change (name user, uint64_t amount, bool reduce, name sc
     auto vitr = voice_t.find(user.value);
     check(vitr != voice_t.end(), "user does not have voice");
 
+    uint64_t balance = get_voice_balance(*vitr, scope, epoch);
+
     if (reduce) {
-      check(amount <= vitr->balance, "voice balance exceeded");
-      percentage_used = amount / double(vitr -> balance);
+      check(amount <= balance, "voice balance exceeded");
+      percentage_used = amount / double(balance);
     }
     voice_t.modify(vitr, _self, [&](auto & voice){
       if (reduce) {
-        voice.balance -= amount;
+        utils::stamp_voice(voice, balance - amount, epoch);
       } else {
-        voice.balance += amount;
+        utils::stamp_voice(voice, balance + amount, epoch);
       }
     });
   }
@@ -1665,6 +1673,8 @@ double proposals::voice_change (name user, uint64_t amount, bool reduce, name sc
 }
 
 void proposals::set_voice (name user, uint64_t amount, name scope) {
+  uint64_t epoch = get_decay_epoch();
+
   if (scope == ""_n) {
 
     bool increase_size = true;
@@ -1676,13 +1686,13 @@ void proposals::set_voice (name user, uint64_t amount, name scope) {
       if (vitr == voice_t.end()) {
         voice_t.emplace(_self, [&](auto & voice){
           voice.account = user;
-          voice.balance = amount;
+          utils::stamp_voice(voice, amount, epoch);
         });
       }
       else {
         increase_size = false;
         voice_t.modify(vitr, _self, [&](auto & voice){
-          voice.balance = amount;
+          utils::stamp_voice(voice, amount, epoch);
         });
       }
     }
@@ -1697,7 +1707,7 @@ void proposals::set_voice (name user, uint64_t amount, name scope) {
     check(vitr != voices.end(), "user does not have a voice entry");
 
     voices.modify(vitr, _self, [&](auto & voice){
-      voice.balance = amount;
+      utils::stamp_voice(voice, amount, epoch);
     });
   }
 }
@@ -1858,9 +1868,14 @@ uint64_t proposals::calculate_decay(uint64_t voice) {
 
   if (temp >= c.t_voicedecay) { return voice; }
   uint64_t n = ((c.t_voicedecay - temp) / decay_sec) + 1;
-  
-  double multiplier = 1.0 - (decay_percentage / 100.0);
-  return voice * pow(multiplier, n);
+
+  // the last n decay epochs, each at the rate it was started with
+  uint64_t epoch = c.decay_epoch.value_or(0);
+  uint64_t from_epoch = epoch > n ? epoch - n : 0;
+  double fallback = 1.0 - (decay_percentage / 100.0);
+  double multiplier = utils::decay_multiplier_between(get_self(), from_epoch, epoch, fallback) * pow(fallback, n - (epoch - from_epoch));
+
+  return voice * multiplier;
 }
 
 void proposals::recover_voice(name account) {
@@ -2073,6 +2088,9 @@ void proposals::send_mimic_delegatee_vote (name delegatee, name scope, uint64_t
 
 }
 
+// This contract keeps its own voice and delegation tables, without dao's delegvoice aggregate
+// or the settle hooks on every voice write it relies on, so delegated votes are still cast one
+// deferred transaction per delegator here, and each delegator is counted as a voter by its own vote.
 ACTION proposals::mimicvote (name delegatee, name delegator, name scope, uint64_t proposal_id, double percentage_used, name option, uint64_t chunksize) {
 
   require_auth(get_self());
@@ -2088,16 +2106,19 @@ ACTION proposals::mimicvote (name delegatee, name delegator, name scope, uint64_
   auto ditr = deltrusts_by_delegatee_delegator.find(id);
   uint64_t count = 0;
 
+  uint64_t epoch = get_decay_epoch();
+
   while (ditr != deltrusts_by_delegatee_delegator.end() && ditr -> delegatee == delegatee && count < chunksize) {
 
     name voter = ditr -> delegator;
 
     auto vitr = voices.find(voter.value);
     if (vitr != voices.end()) {
+      uint64_t balance = get_voice_balance(*vitr, scope, epoch);
       if (option == trust) {
-        send_vote_on_behalf(voter, proposal_id, vitr -> balance * percentage_used, trust);
+        send_vote_on_behalf(voter, proposal_id, balance * percentage_used, trust);
       } else if (option == distrust) {
-        send_vote_on_behalf(voter, proposal_id, vitr -> balance * percentage_used, distrust);
+        send_vote_on_behalf(voter, proposal_id, balance * percentage_used, distrust);
       } else if (option == abstain) {
         send_vote_on_behalf(voter, proposal_id, uint64_t(0), abstain);
       }
@@ -23,6 +23,7 @@ ACTION quests::reset () {
   while (eitr != e_t.end()) {
     eitr = e_t.erase(eitr);
   }
+  hypha::Edge::setKeysReady(get_self(), true);
 
   // create the root node
   hypha::ContentGroups root_cgs {
@@ -1329,8 +1330,18 @@ hypha::Document quests::get_root_node () {
 }
 
 hypha::Document quests::get_doc_from_edge (const checksum256 & node_hash, const name & edge_name) {
-  std::vector<hypha::Edge> edges = m_documentGraph.getEdgesFromOrFail(node_hash, edge_name);
-  hypha::Document node_to(get_self(), edges[0].getToNode());
+  checksum256 to_node;
+  bool found = false;
+
+  m_documentGraph.forEachEdgeFrom(node_hash, edge_name, [&](const hypha::Edge & edge) {
+    to_node = edge.to_node;
+    found = true;
+    return false;
+  });
+
+  check(found, "no edges exist: from " + hypha::readableHash(node_hash) + " with name " + edge_name.to_string());
+
+  hypha::Document node_to(get_self(), to_node);
   return node_to;
 }
 
@@ -1359,9 +1370,7 @@ void quests::check_auth (name & creator, name & fund) {
 void quests::check_quest_status_stage (const checksum256 & quest_hash, const name & status, const name & stage, const string & error_msg) {
 
   hypha::Document quest_doc(get_self(), quest_hash);
-  std::vector<hypha::Edge> edges = m_documentGraph.getEdgesFromOrFail(quest_hash, graph::VARIABLE);
-
-  hypha::Document quest_v_doc(get_self(), edges[0].getToNode());
+  hypha::Document quest_v_doc = get_variable_node_or_fail(quest_doc);
   hypha::ContentWrapper cw = quest_v_doc.getContentWrapper();
 
   check_quest_status_stage(cw, status, stage, error_msg);
@@ -1384,18 +1393,22 @@ void quests::check_quest_status_stage (hypha::ContentWrapper & cw, const name &
 
 void quests::validate_milestones (const checksum256 & quest_hash) {
 
-  std::vector<hypha::Edge> edges = m_documentGraph.getEdgesFromOrFail(quest_hash, graph::HAS_MILESTONE);
   int64_t total = 0;
+  bool found = false;
 
-  for (int i = 0; i < edges.size(); i++) {
+  m_documentGraph.forEachEdgeFrom(quest_hash, graph::HAS_MILESTONE, [&](const hypha::Edge & edge) {
 
-    hypha::Document milestone_doc(get_self(), edges[i].getToNode());
+    hypha::Document milestone_doc(get_self(), edge.to_node);
     hypha::ContentWrapper cw = milestone_doc.getContentWrapper();
 
     hypha::Content * milestone_content = cw.getOrFail(FIXED_DETAILS, PAYOUT_PERCENTAGE);
     total += std::get<int64_t>(milestone_content -> value);
+    found = true;
 
-  }
+    return true;
+  });
+
+  check(found, "no edges exist: from " + hypha::readableHash(quest_hash) + " with name " + graph::HAS_MILESTONE.to_string());
 
   check(total == 10000, "The total payout of the milestones must be 100.00%");
 
@@ -1547,8 +1560,7 @@ void quests::send_to_escrow (const name & fromfund, const name & recipient, asse
 }
 
 bool quests::edge_exists (const checksum256 & from_node_hash, const name & edge_name) {
-  std::vector<hypha::Edge> edges = m_documentGraph.getEdgesFrom(from_node_hash, edge_name);
-  return edges.size() > 0;
+  return m_documentGraph.hasEdgeFrom(from_node_hash, edge_name);
 }
 
 bool quests::is_voted_quest (hypha::Document & quest_doc) {
@@ -1559,3 +1571,61 @@ bool quests::is_voted_quest (hypha::Document & quest_doc) {
 
   return fund != creator;
 }
+
+// edges saved before the 128 bit edge indexes were added have no entries in them until rewritten
+ACTION quests::migedges (uint64_t start, uint64_t chunksize) {
+  require_auth(get_self());
+
+  uint64_t next = m_documentGraph.reindexEdges(start, chunksize);
+
+  if (next != 0) {
+    action next_execution(
+      permission_level{get_self(), "active"_n},
+      get_self(),
+      "migedges"_n,
+      std::make_tuple(next, chunksize)
+    );
+
+    transaction tx;
+    tx.actions.emplace_back(next_execution);
+    tx.delay_sec = 1;
+    tx.send(next, _self);
+  }
+}
+
+// writes an edge the way it was saved before the 128 bit edge indexes were added
+ACTION quests::testoldedge (checksum256 from_node, checksum256 to_node, name edge_name) {
+  require_auth(get_self());
+
+  typedef eosio::multi_index<eosio::name("edges"), hypha::Edge,
+    eosio::indexed_by<eosio::name("fromnode"), eosio::const_mem_fun<hypha::Edge, eosio::checksum256, &hypha::Edge::by_from>>,
+    eosio::indexed_by<eosio::name("tonode"), eosio::const_mem_fun<hypha::Edge, eosio::checksum256, &hypha::Edge::by_to>>,
+    eosio::indexed_by<eosio::name("edgename"), eosio::const_mem_fun<hypha::Edge, uint64_t, &hypha::Edge::by_edge_name>>,
+    eosio::indexed_by<eosio::name("byfromname"), eosio::const_mem_fun<hypha::Edge, uint64_t, &hypha::Edge::by_from_node_edge_name_index>>,
+    eosio::indexed_by<eosio::name("byfromto"), eosio::const_mem_fun<hypha::Edge, uint64_t, &hypha::Edge::by_from_node_to_node_index>>,
+    eosio::indexed_by<eosio::name("bytoname"), eosio::const_mem_fun<hypha::Edge, uint64_t, &hypha::Edge::by_to_node_edge_name_index>>,
+    eosio::indexed_by<eosio::name("bycreated"), eosio::const_mem_fun<hypha::Edge, uint64_t, &hypha::Edge::by_created>>,
+    eosio::indexed_by<eosio::name("bycreator"), eosio::const_mem_fun<hypha::Edge, uint64_t, &hypha::Edge::by_creator>>>
+    legacy_edge_table;
+
+  legacy_edge_table e_t(get_self(), get_self().value);
+  e_t.emplace(get_self(), [&](auto & e){
+    e.id = hypha::concatHash(from_node, to_node, edge_name);
+    e.from_node_edge_name_index = hypha::concatHash(from_node, edge_name);
+    e.from_node_to_node_index = hypha::concatHash(from_node, to_node);
+    e.to_node_edge_name_index = hypha::concatHash(to_node, edge_name);
+    e.creator = get_self();
+    e.contract = get_self();
+    e.from_node = from_node;
+    e.to_node = to_node;
+    e.edge_name = edge_name;
+    e.created_date = eosio::current_time_point();
+  });
+
+  hypha::Edge::setKeysReady(get_self(), false);
+}
+
+ACTION quests::testhasedge (checksum256 from_node, name edge_name) {
+  require_auth(get_self());
+  check(m_documentGraph.hasEdgeFrom(from_node, edge_name), "edge not found from " + hypha::readableHash(from_node) + " with name " + edge_name.to_string());
+}
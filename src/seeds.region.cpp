@@ -263,6 +263,7 @@ ACTION region::join(name region, name account) {
         item.account = account;
     });
     update_members_count(region, 1);
+    send_member_cs(region, account, true);
 
 }
 
@@ -333,9 +334,11 @@ void region::remove_member(name account) {
         roles.erase(ritr);
     }
 
-    update_members_count(mitr->region, -1);
+    name region = mitr -> region;
+    update_members_count(region, -1);
 
     members.erase(mitr);
+    send_member_cs(region, account, false);
 }
 
 ACTION region::setfounder(name region, name founder, name new_founder) {
@@ -370,6 +373,20 @@ ACTION region::removergn(name region) {
     while (mitr != rgnmembers.end() && mitr->region.value == region.value) {
         mitr = rgnmembers.erase(mitr);
     }
+
+    action(
+        permission_level{get_self(), "active"_n},
+        contracts::harvest, "removergncs"_n,
+        std::make_tuple(region)
+    ).send();
+}
+
+void region::send_member_cs(name region, name account, bool joined) {
+    action(
+        permission_level{get_self(), "active"_n},
+        contracts::harvest, "rgnmember"_n,
+        std::make_tuple(region, account, joined)
+    ).send();
 }
 
 void region::create_telos_account(name sponsor, name orgaccount, string publicKey) 
@@ -432,17 +449,9 @@ void region::update_members_count(name region, int delta) {
 }
 
 double region::config_float_get(name key) {
-  auto citr = configfloat.find(key.value);
-  if (citr == configfloat.end()) { 
-    check(false, ("settings: the "+key.to_string()+" parameter has not been initialized").c_str());
-  }
-  return citr->value;
+  return config_float_cache.get(configfloat, key);
 }
 
 uint64_t region::config_get(name key) {
-  auto citr = config.find(key.value);
-  if (citr == config.end()) { 
-    check(false, ("settings: the "+key.to_string()+" parameter has not been initialized").c_str());
-  }
-  return citr->value;
+  return config_cache.get(config, key);
 }
@@ -3,6 +3,7 @@
 #include <eosio/transaction.hpp>
 #include <contracts.hpp>
 #include <string>
+#include <algorithm>
 
 
 uint64_t scheduler::is_ready_op (const name & operation, const uint64_t & timestamp) {
@@ -14,10 +15,34 @@ uint64_t scheduler::is_ready_op (const name & operation, const uint64_t & timest
         return 0;
     }
 
+    std::vector<name> deps = itr -> deps.value_or(std::vector<name>());
+
     uint64_t periods = 0;
 
     periods = (timestamp - itr -> timestamp) / itr -> period;
 
+    // an op waiting on deps still runs once dep_max_periods of its periods have passed,
+    // so a dep that keeps failing can not hold it back forever
+    if (deps.size() > 0 && periods < dep_max_periods) {
+        bool waiting = false;
+        for (const name & dep : deps) {
+            auto ditr = operations.find(dep.value);
+
+            // removed and paused deps produce no new results to wait for
+            if (ditr == operations.end() || ditr -> pause > 0) continue;
+
+            uint64_t completed_at = ditr -> completed_at.value_or(0);
+
+            // still running, or no new result since this op last ran
+            if (completed_at < ditr -> timestamp || completed_at <= itr -> timestamp) {
+                return 0;
+            }
+            waiting = true;
+        }
+        // without an active dep the op falls back to its own period
+        if (waiting) return timestamp;
+    }
+
     print("\nPERIODS: " + std::to_string(periods) + ", current_time: " + std::to_string(timestamp) + ", last_timestap: " + std::to_string(itr->timestamp) );
 
     return periods > 0 ? timestamp : 0;
@@ -86,6 +111,12 @@ void scheduler::reset_aux(bool destructive) {
         while(itr != moonops.end()) {
             itr = moonops.erase(itr);
         }
+        tickstats.remove();
+    }
+
+    auto ditr = dispatches.begin();
+    while (ditr != dispatches.end()) {
+        ditr = dispatches.erase(ditr);
     }
 
     auto titr = test.begin();
@@ -102,20 +133,13 @@ void scheduler::reset_aux(bool destructive) {
         name("acct.rankcbs"),
         name("acct.rorgcbs"),
 
-        name("hrvst.ranktx"),
-        name("hrvst.rankpl"),
-
-        name("hrvst.calccs"), // after the above 4
-        name("hrvst.rankcs"), 
-        name("hrvst.rorgcs"),
+        name("hrvst.score"), // after the above 4
         name("hrvst.calctx"), // 24h
         name("hrvst.rgncs"),
 
         name("org.clndaus"),
         name("org.rankregn"),
 
-        name("hrvst.orgtxs"),
-
         name("prop.dvoices"),
 
         name("forum.rank"),
@@ -130,6 +154,7 @@ void scheduler::reset_aux(bool destructive) {
 
         name("onbrd.clean"),
         name("hstry.ptrxs"),
+        name("hstry.expire"),
 
         name("dao.cleanvts"),
         name("dao.calcdist")
@@ -144,20 +169,13 @@ void scheduler::reset_aux(bool destructive) {
         name("rankcbss"),
         name("rankorgcbss"),
         
-        name("ranktxs"),
-        name("rankplanteds"),
-
-        name("calccss"),
-        name("rankcss"),
-        name("rankorgcss"),
+        name("rankscores"),
         name("calctrxpts"),
         name("rankrgncss"),
 
         name("cleandaus"),
         name("rankregens"),
 
-        name("rankorgtxs"),
-
         name("decayvoices"),
 
         name("rankforums"),
@@ -172,6 +190,7 @@ void scheduler::reset_aux(bool destructive) {
 
         name("chkcleanup"),
         name("cleanptrxs"),
+        name("expiretrx"),
 
         name("dhocleanvts"),
         name("dhocalcdists")
@@ -186,11 +205,6 @@ void scheduler::reset_aux(bool destructive) {
         contracts::accounts,
         contracts::accounts,
 
-        contracts::harvest,
-        contracts::harvest,
-
-        contracts::harvest,
-        contracts::harvest,
         contracts::harvest,
         contracts::harvest,
         contracts::harvest,
@@ -198,8 +212,6 @@ void scheduler::reset_aux(bool destructive) {
         contracts::organization,
         contracts::organization,
 
-        contracts::harvest,
-
         contracts::proposals,
 
         contracts::forum,
@@ -214,11 +226,86 @@ void scheduler::reset_aux(bool destructive) {
 
         contracts::onboarding,
         contracts::history,
+        contracts::history,
 
         contracts::dao,
         contracts::dao
     };
 
+    // order within a tick when several ops are ready at once, lower runs first
+    std::vector<uint8_t> priority_v = {
+        0,
+        0,
+
+        0,
+        0,
+        0,
+        0,
+
+        1, // after the 4 account ranks
+        0,
+        2, // after hrvst.score
+
+        0,
+        0,
+
+        0,
+
+        0,
+        1,
+
+        0,
+        1, // after hrvst.qevs
+        2, // after hrvst.mintr
+
+        0,
+        1, // after org.appuses
+
+        0,
+        0,
+        0,
+
+        0,
+        0
+    };
+
+    // ops that only start once these have reported completion through opdone
+    std::vector<std::vector<name>> deps_v = {
+        {},
+        {},
+
+        {},
+        {},
+        {},
+        {},
+
+        { name("acct.rankrep"), name("acct.rorgrep"), name("acct.rankcbs"), name("acct.rorgcbs") },
+        {},
+        { name("hrvst.score") },
+
+        {},
+        {},
+
+        {},
+
+        {},
+        {},
+
+        {},
+        {},
+        {},
+
+        {},
+        {},
+
+        {},
+        {},
+        {},
+
+        {},
+        {}
+    };
+
     std::vector<uint64_t> delay_v = {
         utils::seconds_per_day * 7,
         utils::seconds_per_day * 7,
@@ -228,11 +315,6 @@ void scheduler::reset_aux(bool destructive) {
         utils::seconds_per_hour,
         utils::seconds_per_hour,
 
-        utils::seconds_per_hour,
-        utils::seconds_per_hour,
-
-        utils::seconds_per_hour,
-        utils::seconds_per_hour,
         utils::seconds_per_hour,
         utils::seconds_per_day,
         utils::seconds_per_day,
@@ -240,8 +322,6 @@ void scheduler::reset_aux(bool destructive) {
         utils::seconds_per_day / 2,
         utils::seconds_per_day,
 
-        utils::seconds_per_day,
-
         utils::seconds_per_day,
         
         utils::moon_cycle / 4,
@@ -254,6 +334,7 @@ void scheduler::reset_aux(bool destructive) {
         utils::seconds_per_day,
         utils::seconds_per_day,
 
+        utils::seconds_per_day,
         utils::seconds_per_day,
         utils::seconds_per_day,
 
@@ -272,16 +353,10 @@ void scheduler::reset_aux(bool destructive) {
         now - utils::seconds_per_hour,
         now - utils::seconds_per_hour,
 
-        now - utils::seconds_per_hour, 
-        now - utils::seconds_per_hour, 
-
         now + 300 - utils::seconds_per_hour, // kicks off 5 minutes later
-        now + 600 - utils::seconds_per_hour, // kicks off 10 minutes later
-        now + 600 - utils::seconds_per_hour, // kicks off 10 minutes later
         now,
         now + 600 - utils::seconds_per_hour, // kicks off 10 minutes later
 
-        now,
         now,
         now,
 
@@ -299,6 +374,7 @@ void scheduler::reset_aux(bool destructive) {
         now,
         now + 600 - utils::seconds_per_hour, // kicks off 10 minutes later
         
+        now,
         now,
         now,
 
@@ -319,9 +395,20 @@ void scheduler::reset_aux(bool destructive) {
                 noperation.pause = 0;
                 noperation.period = delay_v[i];
                 noperation.timestamp = timestamp_v[i];
+                noperation.priority = priority_v[i];
+                noperation.cost = 0;
+                noperation.deps = deps_v[i];
+                noperation.completed_at = 0;
             });
         } else {
             print(" skipping op "+id_v[i].to_string());
+            if (!oitr->deps.has_value()) {
+                operations.modify(oitr, _self, [&](auto & moperation){
+                    if (!moperation.priority.has_value()) moperation.priority = priority_v[i];
+                    fill_extensions(moperation);
+                    moperation.deps = deps_v[i];
+                });
+            }
         }
         i++;
     }
@@ -374,6 +461,7 @@ ACTION scheduler::configop(name id, name action, name contract, uint64_t period,
             noperation.contract = contract;
             noperation.period = period;
             noperation.timestamp = start - period;
+            fill_extensions(noperation);
         });
     }
 }
@@ -480,6 +568,11 @@ ACTION scheduler::moonphase(uint64_t timestamp, string phase_name, string eclips
 ACTION scheduler::removeop(name id) {
     require_auth(get_self());
 
+    auto ditr = dispatches.find(id.value);
+    if (ditr != dispatches.end()) {
+        dispatches.erase(ditr);
+    }
+
     auto itr = operations.find(id.value);
     if (itr != operations.end()) {
         operations.erase(itr);
@@ -517,6 +610,72 @@ ACTION scheduler::pauseop(name id, uint8_t pause) {
     check(false, contracts::scheduler.to_string() + ": the operation " + id.to_string() + " does not exist");
 }
 
+ACTION scheduler::setopsched(name id, uint8_t priority) {
+    require_auth(get_self());
+
+    auto itr = operations.find(id.value);
+    check(itr != operations.end(), contracts::scheduler.to_string() + ": the operation " + id.to_string() + " does not exist");
+
+    operations.modify(itr, _self, [&](auto & moperation) {
+        fill_extensions(moperation);
+        moperation.priority = priority;
+    });
+}
+
+ACTION scheduler::setopdeps(name id, std::vector<name> deps) {
+    require_auth(get_self());
+
+    auto itr = operations.find(id.value);
+    check(itr != operations.end(), contracts::scheduler.to_string() + ": the operation " + id.to_string() + " does not exist");
+
+    for (const name & dep : deps) {
+        check(dep != id, contracts::scheduler.to_string() + ": an operation can not depend on itself");
+        check(operations.find(dep.value) != operations.end(), contracts::scheduler.to_string() + ": the operation " + dep.to_string() + " does not exist");
+    }
+
+    operations.modify(itr, _self, [&](auto & moperation) {
+        fill_extensions(moperation);
+        moperation.deps = deps;
+    });
+}
+
+ACTION scheduler::opdone(name id) {
+    auto itr = operations.find(id.value);
+    if (itr == operations.end()) return;
+
+    require_auth(itr->contract);
+
+    operations.modify(itr, _self, [&](auto & moperation) {
+        fill_extensions(moperation);
+        moperation.completed_at = eosio::current_time_point().sec_since_epoch();
+    });
+}
+
+ACTION scheduler::confirmop(name id) {
+    require_auth(get_self());
+
+    auto ditr = dispatches.find(id.value);
+    if (ditr == dispatches.end()) return;
+
+    if (ditr->moon) {
+        auto mitr = moonops.find(id.value);
+        if (mitr != moonops.end()) {
+            moonops.modify(mitr, _self, [&](auto & operation) {
+                operation.last_moon_cycle_id = ditr->used_timestamp;
+            });
+        }
+    } else {
+        auto oitr = operations.find(id.value);
+        if (oitr != operations.end()) {
+            operations.modify(oitr, _self, [&](auto & operation) {
+                operation.timestamp = ditr->used_timestamp;
+            });
+        }
+    }
+
+    dispatches.erase(ditr);
+}
+
 ACTION scheduler::execute() {
    // require_auth(_self);
 
@@ -557,53 +716,97 @@ ACTION scheduler::execute() {
     // execute operations
     // =======================
 
-    auto ops_by_last_executed = operations.get_index<"bytimestamp"_n>();
-    auto itr = ops_by_last_executed.begin();
-    bool has_executed = false;
+    // ready ops are dispatched in priority order, at most sched.maxops of them per tick.
+    // The ops are sent as deferred transactions of their own, so the cap only limits
+    // how many are started in the same block. An op's timestamp moves on when its
+    // transaction confirms it, until then it is in flight and not sent again
 
     uint64_t timestamp = eosio::current_time_point().sec_since_epoch();
+    uint64_t max_ops = config_get(max_dispatches);
+    uint64_t waiting = 0;
 
-    while(itr != ops_by_last_executed.end()) {
-        if(is_ready_op(itr -> id, timestamp)){
+    std::vector<ready_op> ready;
 
-            print("\nOperation to be executed: " + itr -> id.to_string(), "\n");
-
-            exec_op(itr->id, itr->contract, itr->operation);
-
-            ops_by_last_executed.modify(itr, _self, [&](auto & operation) {
-                operation.timestamp = timestamp;
-            });
+    auto ops_by_last_executed = operations.get_index<"bytimestamp"_n>();
+    auto itr = ops_by_last_executed.begin();
 
-            has_executed = true;
-            
-            break;
+    while(itr != ops_by_last_executed.end()) {
+        if(is_ready_op(itr -> id, timestamp)){
+            if (in_flight(itr->id, itr->period, timestamp)) {
+                waiting++;
+            } else {
+                ready.push_back(ready_op{
+                    itr->id, itr->contract, itr->operation,
+                    itr->priority.value_or(default_priority),
+                    itr->timestamp, timestamp, false
+                });
+            }
         }
         itr++;
     }
 
-    if (!has_executed) {
-        auto moonops_by_last_cycle = moonops.get_index<"bylastcycle"_n>();
-        auto mitr = moonops_by_last_cycle.begin();
-        
-        while (mitr != moonops_by_last_cycle.end()) {
-            uint64_t used_timestamp = is_ready_moon_op(mitr->id, timestamp);
-            if (used_timestamp) {
-                print("\nMoon operation to be executed: " + mitr->id.to_string(), "\n");
+    auto moonops_by_last_cycle = moonops.get_index<"bylastcycle"_n>();
+    auto mitr = moonops_by_last_cycle.begin();
+
+    while (mitr != moonops_by_last_cycle.end()) {
+        uint64_t used_timestamp = is_ready_moon_op(mitr->id, timestamp);
+        if (used_timestamp) {
+            if (in_flight(mitr->id, op_retry_max, timestamp)) {
+                waiting++;
+            } else {
+                ready.push_back(ready_op{
+                    mitr->id, mitr->contract, mitr->action,
+                    default_priority,
+                    used_timestamp, used_timestamp, true
+                });
+            }
+        }
+        mitr++;
+    }
 
-                exec_op(mitr->id, mitr->contract, mitr->action);
+    std::sort(ready.begin(), ready.end(), [](const ready_op & a, const ready_op & b) {
+        if (a.priority != b.priority) return a.priority < b.priority;
+        return a.timestamp < b.timestamp;
+    });
 
-                moonops_by_last_cycle.modify(mitr, _self, [&](auto & operation){
-                    operation.last_moon_cycle_id = used_timestamp;
-                });
+    uint64_t executed = 0;
 
-                has_executed = true;
+    for (const auto & op : ready) {
+        if (executed >= max_ops) break;
 
-                break;
-            }
-            mitr++;
+        print("\nOperation to be executed: " + op.id.to_string(), "\n");
+
+        auto ditr = dispatches.find(op.id.value);
+        if (ditr == dispatches.end()) {
+            dispatches.emplace(_self, [&](auto & item) {
+                item.id = op.id;
+                item.dispatched_at = timestamp;
+                item.used_timestamp = op.used_timestamp;
+                item.moon = op.moon;
+            });
+        } else {
+            dispatches.modify(ditr, _self, [&](auto & item) {
+                item.dispatched_at = timestamp;
+                item.used_timestamp = op.used_timestamp;
+                item.moon = op.moon;
+            });
         }
+
+        exec_op(op.id, op.contract, op.operation);
+
+        executed++;
     }
 
+    tickstats.set(tick_stats_table{
+        timestamp,
+        executed,
+        waiting,
+        max_ops,
+        uint64_t(ready.size()) - executed
+    }, get_self());
+
+    bool has_executed = executed > 0;
+
     // =======================
     // schedule next execution
     // =======================
@@ -677,6 +880,36 @@ ACTION scheduler::checknext() {
 
 }
 
+// binary extensions are serialized in order, so a field can only be
+// written once all the fields declared before it have a value
+// An op whose run failed never confirms, it is sent again once its period,
+// capped at op_retry_max, has passed since it was dispatched
+bool scheduler::in_flight(name id, uint64_t period, uint64_t timestamp) {
+    auto ditr = dispatches.find(id.value);
+    if (ditr == dispatches.end()) return false;
+
+    return timestamp < ditr->dispatched_at + std::min(std::max(period, uint64_t(1)), op_retry_max);
+}
+
+void scheduler::fill_extensions(operations_table & op) {
+    if (!op.priority.has_value()) op.priority = default_priority;
+    if (!op.cost.has_value()) op.cost = 0;
+    if (!op.deps.has_value()) op.deps = std::vector<name>();
+    if (!op.completed_at.has_value()) op.completed_at = 0;
+}
+
+uint64_t scheduler::config_get(name key) {
+    uint64_t value;
+    if (config_cache.lookup(key, value)) {
+        return value;
+    }
+    auto citr = config.find(key.value);
+    if (citr == config.end()) {
+        check(false, (contracts::scheduler.to_string() + ": the parameter " + key.to_string() + " is not configured in " + contracts::settings.to_string()).c_str());
+    }
+    return config_cache.remember(key, citr->value);
+}
+
 void scheduler::cancel_exec() {
     require_auth(get_self());
     cancel_deferred(contracts::scheduler.value);
@@ -735,21 +968,32 @@ ACTION scheduler::testexec(name op) {
     }
 }
 
+// Each op runs in its own deferred transaction, so an op that fails or runs out of
+// CPU only loses its own run and leaves the tick and the other ops in place.
+// confirmop closes the transaction and is reverted along with a failed op.
+// The op id goes along as the action data, ops that report completion take it as
+// an optional op_id argument and the others ignore the trailing bytes
 void scheduler::exec_op(name id, name contract, name operation) {
     
     action a = action(
         permission_level{contract, "execute"_n},
         contract,
         operation,
-        std::make_tuple()
+        std::make_tuple(id)
     );
 
-    // transaction txa;
-    // txa.actions.emplace_back(a);
-    // txa.delay_sec = 0;
-    // txa.send(eosio::current_time_point().sec_since_epoch() + 20, _self);
+    action confirm = action(
+        permission_level{get_self(), "active"_n},
+        get_self(),
+        "confirmop"_n,
+        std::make_tuple(id)
+    );
 
-    a.send();
+    transaction txa;
+    txa.actions.emplace_back(a);
+    txa.actions.emplace_back(confirm);
+    txa.delay_sec = 0;
+    txa.send(id.value, _self, true);
 }
 
 // not using this
@@ -770,7 +1014,7 @@ uint64_t scheduler::next_valid_moon_phase(uint64_t moon_cycle_id, uint64_t quart
 
 EOSIO_DISPATCH(scheduler,
     (configop)(configmoonop)(addmoonop)
-    (execute)(reset)(pauseop)(removeop)
+    (execute)(reset)(pauseop)(removeop)(setopsched)(setopdeps)(opdone)(confirmop)
     (stop)(start)(moonphase)(test1)(test2)(testexec)(updateops)
     (checknext)
 );
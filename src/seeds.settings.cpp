@@ -22,6 +22,7 @@ void settings::reset() {
   confwithdesc(name("prop.cyc.qb"), 2, "Prop cycles to take into account for calculating quorum basis", high_impact);
 
   confwithdesc(name("prop.evl.psh"), 100, "Rep points the proposer will lose if the proposal fails in evaluate state", high_impact);
+  confwithdesc(name("prop.evl.bch"), 10, "Number of proposals evaluated per transaction when a cycle ends", low_impact);
   
   confwithdesc(name("unity.high"), 90, "High unity threshold (in percentage)", high_impact);
   confwithdesc(name("unity.medium"), 85, "Medium unity threshold (in percentage)", high_impact);
@@ -67,6 +68,7 @@ void settings::reset() {
   confwithdesc(name("txlimit.min"), 7, "Minimum number of transactions per user", high_impact);
 
   confwithdesc(name("htry.trx.max"), 2, "Maximum number of transactions to take into account for transaction score between to users per day", high_impact);
+  confwithdesc(name("trxq.batch"), 50, "Number of queued transfers the history contract processes per drain transaction", high_impact);
   confwithdesc(name("qev.trx.cap"), uint64_t(1777) * uint64_t(10000), "Maximum number of seeds to take into account as qualifying volume", high_impact);
 
   conffloatdsc(name("infation.per"), 0.0, "Economic inflation per period. Example 0.01 = 1%", high_impact);
@@ -79,6 +81,8 @@ void settings::reset() {
   
   confwithdesc(name("org.minharv"), 2, "Minimum status for a organization to be eligible for receiving part of the harvest ", high_impact);
 
+  confwithdesc(name("cs.budget"), 1000, "Number of rows the contribution score pipeline processes per transaction", high_impact);
+
   // =====================================
   // organizations 
   // =====================================
@@ -133,6 +137,7 @@ void settings::reset() {
 
   // Scheduler cycle
   confwithdesc(name("secndstoexec"), 60, "Seconds to execute", high_impact);
+  confwithdesc(name("sched.maxops"), 10, "Maximum number of ready operations the scheduler dispatches per execution", high_impact);
 
   // =====================================
   // citizenship path 
@@ -52,6 +52,10 @@ void token::issue( const name& to, const asset& quantity, const string& memo )
     });
 
     add_balance( st.issuer, quantity, st.issuer );
+
+    if (sym == seeds_symbol) {
+      adjust_circulating(is_system_account(st.issuer) ? 0 : quantity.amount, quantity.amount);
+    }
 }
 
 void token::retire( const asset& quantity, const string& memo )
@@ -76,6 +80,10 @@ void token::retire( const asset& quantity, const string& memo )
     });
 
     sub_balance( st.issuer, quantity );
+
+    if (sym == seeds_symbol) {
+      adjust_circulating(is_system_account(st.issuer) ? 0 : -quantity.amount, -quantity.amount);
+    }
 }
 
 void token::burn( const name& from, const asset& quantity )
@@ -93,6 +101,10 @@ void token::burn( const name& from, const asset& quantity )
   statstable.modify(sitr, from, [&](auto& stats) {
     stats.supply -= quantity;
   });
+
+  if (sym == seeds_symbol) {
+    adjust_circulating(is_system_account(from) ? 0 : -quantity.amount, -quantity.amount);
+  }
 }
 
 void token::transfer( const name&    from,
@@ -123,6 +135,14 @@ void token::transfer( const name&    from,
 
     sub_balance( from, quantity );
     add_balance( to, quantity, payer );
+
+    if (quantity.symbol == seeds_symbol) {
+      bool from_system = is_system_account(from);
+      bool to_system = is_system_account(to);
+      if (from_system != to_system) {
+        adjust_circulating(from_system ? quantity.amount : -quantity.amount, 0);
+      }
+    }
     
     save_transaction(from, to, quantity);
 
@@ -171,15 +191,30 @@ void token::save_transaction(name from, name to, asset quantity) {
 
 }
 
-void token::check_limit_transactions(name from) {
+// status of a seeds user, or an empty name if the account is not one
+name token::user_status( const name& account ) {
+  user_core_tables usercore(contracts::accounts, contracts::accounts.value);
+  auto citr = usercore.find(account.value);
+  if (citr != usercore.end()) {
+    return citr->status;
+  }
+
+  // users added before usercore was populated
   user_tables users(contracts::accounts, contracts::accounts.value);
-  config_tables config(contracts::settings, contracts::settings.value);
-  balance_tables balances(contracts::harvest, contracts::harvest.value);
+  auto uitr = users.find(account.value);
+  if (uitr != users.end()) {
+    return uitr->status;
+  }
 
-  auto bitr = balances.find(from.value);
-  auto uitr = users.find(from.value);
+  return name();
+}
 
-  if (uitr != users.end()) {
+void token::check_limit_transactions(name from) {
+  if (user_status(from) != name()) {
+    config_tables config(contracts::settings, contracts::settings.value);
+    balance_tables balances(contracts::harvest, contracts::harvest.value);
+
+    auto bitr = balances.find(from.value);
     uint64_t max_trx = 0;
     auto min_trx = config.get(name("txlimit.min").value, "The txlimit.min parameters has not been initialized yet.");
     if (bitr != balances.end() && bitr -> planted > asset(0, seeds_symbol)) {
@@ -191,25 +226,17 @@ void token::check_limit_transactions(name from) {
       max_trx = min_trx.value;
     }
 
-    transaction_tables transactions(get_self(), seeds_symbol.code().raw());
-    auto titr = transactions.find(from.value);
-
-    if (titr != transactions.end()) {
-      check(max_trx > titr -> outgoing_transactions, "Maximum limit of allowed transactions reached.");
-    }
+    check(max_trx > outgoing_this_week(from), "Maximum limit of allowed transactions reached.");
   }
 }
 
 void token::check_limit(const name& from) {
-  user_tables users(contracts::accounts, contracts::accounts.value);
-  auto uitr = users.find(from.value);
+  name status = user_status(from);
 
-  if (uitr == users.end()) {
+  if (status == name()) {
     return;
   }
 
-  name status = uitr->status;
-
   uint64_t limit = 10;
   if (status == "resident"_n) {
     limit = 50;
@@ -217,72 +244,45 @@ void token::check_limit(const name& from) {
     limit = 100;
   }
 
-  transaction_tables transactions(get_self(), seeds_symbol.code().raw());
-  auto titr = transactions.find(from.value);
-  uint64_t current = titr->outgoing_transactions;
+  uint64_t current = outgoing_this_week(from);
 
   check(current < limit, "too many outgoing transactions");
 }
 
-void token::reset_weekly_aux(uint64_t begin) {
-
-  config_tables config(contracts::settings, contracts::settings.value);
-
-  auto batch_size = config.get(name("batchsize").value, "The batchsize parameter has not been initialized yet.");
-  auto sym_code_raw = seeds_symbol.code().raw();
-  uint64_t count = 0;
-
-  transaction_tables transactions(get_self(), sym_code_raw);
+uint64_t token::current_week_epoch() {
+  return weekepoch.get_or_default().epoch;
+}
 
-  auto titr = begin == 0 ? transactions.begin() : transactions.lower_bound(begin);
-  while (titr != transactions.end() && count < batch_size.value) {
-    transactions.modify(titr, _self, [&](auto& user) {
-      user.incoming_transactions = 0;
-      user.outgoing_transactions = 0;
-      user.total_transactions = 0;
-      user.transactions_volume = asset(0, seeds_symbol);
-    });
-    titr++;
-    count++;
-  }
+uint64_t token::outgoing_this_week(const name& account) {
+  transaction_tables transactions(get_self(), seeds_symbol.code().raw());
+  auto titr = transactions.find(account.value);
 
-  if (titr != transactions.end()) {
-    transaction trx{};
-    trx.actions.emplace_back(
-      permission_level(_self, "active"_n),
-      _self,
-      "resetwhelper"_n,
-      std::make_tuple((titr -> account).value)
-    );
-    trx.delay_sec = 1;
-    trx.send(eosio::current_time_point().sec_since_epoch(), _self);
+  if (titr == transactions.end() || titr -> epoch.value_or(0) != current_week_epoch()) {
+    return 0;
   }
 
+  return titr -> outgoing_transactions;
 }
 
 void token::resetweekly() {
   require_auth(get_self());
-  reset_weekly_aux((uint64_t)0);
-}
 
-void token::resetwhelper (uint64_t begin) {
-  require_auth(get_self());
-  reset_weekly_aux(begin);
+  auto we = weekepoch.get_or_default();
+  we.epoch += 1;
+  we.timestamp = eosio::current_time_point().sec_since_epoch();
+  weekepoch.set(we, get_self());
 }
 
 void token::update_stats( const name& from, const name& to, const asset& quantity ) {
-    user_tables users(contracts::accounts, contracts::accounts.value);
-
-    auto fromuser = users.find(from.value);
-    auto touser = users.find(to.value);
-    
-    if (fromuser == users.end() || touser == users.end()) {
+    if (user_status(from) == name() || user_status(to) == name()) {
       return;
     }
 
     auto sym_code_raw = quantity.symbol.code().raw();
     transaction_tables transactions(get_self(), sym_code_raw);
 
+    uint64_t epoch = current_week_epoch();
+
     auto fromitr = transactions.find(from.value);
     auto toitr = transactions.find(to.value);
 
@@ -293,12 +293,21 @@ void token::update_stats( const name& from, const name& to, const asset& quantit
         user.total_transactions = 1;
         user.incoming_transactions = 0;
         user.outgoing_transactions = 1;
+        user.epoch = epoch;
       });
     } else {
       transactions.modify(fromitr, get_self(), [&](auto& user) {
+        if (user.epoch.value_or(0) != epoch) {
+          user.transactions_volume = quantity;
+          user.total_transactions = 1;
+          user.incoming_transactions = 0;
+          user.outgoing_transactions = 1;
+          user.epoch = epoch;
+        } else {
           user.transactions_volume += quantity;
           user.outgoing_transactions += 1;
           user.total_transactions += 1;
+        }
       });
     }
 
@@ -309,12 +318,21 @@ void token::update_stats( const name& from, const name& to, const asset& quantit
         user.total_transactions = 1;
         user.incoming_transactions = 1;
         user.outgoing_transactions = 0;
+        user.epoch = epoch;
       });
     } else {
       transactions.modify(toitr, get_self(), [&](auto& user) {
-        user.transactions_volume += quantity;
-        user.total_transactions += 1;
-        user.incoming_transactions += 1;
+        if (user.epoch.value_or(0) != epoch) {
+          user.transactions_volume = quantity;
+          user.total_transactions = 1;
+          user.incoming_transactions = 1;
+          user.outgoing_transactions = 0;
+          user.epoch = epoch;
+        } else {
+          user.transactions_volume += quantity;
+          user.total_transactions += 1;
+          user.incoming_transactions += 1;
+        }
       });
     }
 }
@@ -352,6 +370,29 @@ void token::updatecirc() {
 
    require_auth(get_self());
 
+    if (sysaccts.begin() == sysaccts.end()) {
+      std::array<name, 12> system_accounts = {
+        "gift.seeds"_n,
+        "milest.seeds"_n,
+        "hypha.seeds"_n,
+        "allies.seeds"_n,
+        "refer.seeds"_n,
+        "bank.seeds"_n,
+        "system.seeds"_n,
+        "harvst.seeds"_n,   // planted - although these go into system actually
+        "funds.seeds"_n,    // proposals
+        "rules.seeds"_n,    // referendums
+        "dao.hypha"_n,      // hypha dao escrow contract
+        "escrow.seeds"_n
+      };
+
+      for (const auto& account : system_accounts) {
+        sysaccts.emplace(get_self(), [&](auto& item) {
+          item.account = account;
+        });
+      }
+    }
+
     // total supply
     stats statstable( get_self(), seeds_symbol.code().raw() );
     auto sitr = statstable.find( seeds_symbol.code().raw() );
@@ -359,23 +400,8 @@ void token::updatecirc() {
     uint64_t total = sitr->supply.amount;
     uint64_t result = total;
 
-    std::array<name, 12> system_accounts = {
-      "gift.seeds"_n,
-      "milest.seeds"_n,
-      "hypha.seeds"_n,
-      "allies.seeds"_n,
-      "refer.seeds"_n,
-      "bank.seeds"_n,
-      "system.seeds"_n,
-      "harvst.seeds"_n,   // planted - although these go into system actually
-      "funds.seeds"_n,    // proposals
-      "rules.seeds"_n,    // referendums
-      "dao.hypha"_n,      // hypha dao escrow contract
-      "escrow.seeds"_n
-    };
-
-    for(const auto& account : system_accounts) {   // Range-for!
-      result -= balance_for(account);
+    for (auto aitr = sysaccts.begin(); aitr != sysaccts.end(); aitr++) {
+      result -= balance_for(aitr -> account);
     }
 
     circulating_supply_table c = circulating.get_or_create(get_self(), circulating_supply_table());
@@ -383,16 +409,44 @@ void token::updatecirc() {
     c.circulating = result;
     circulating.set(c, get_self());
 
-    transaction trx{};
-    trx.actions.emplace_back(
-      permission_level(_self, "active"_n),
-      _self,
-      "updatecirc"_n,
-      std::make_tuple()
-    );
-    trx.delay_sec = 60 * 60; // TODO use scheduler for this - run every hour
-    trx.send(eosio::current_time_point().sec_since_epoch() + 19, _self);
-    
+}
+
+void token::addsysacct(const name& account) {
+  require_auth(get_self());
+
+  check(sysaccts.find(account.value) == sysaccts.end(), "seeds: " + account.to_string() + " is already a system account");
+
+  sysaccts.emplace(get_self(), [&](auto& item) {
+    item.account = account;
+  });
+
+  adjust_circulating(-int64_t(balance_for(account)), 0);
+}
+
+void token::rmsysacct(const name& account) {
+  require_auth(get_self());
+
+  auto aitr = sysaccts.find(account.value);
+  check(aitr != sysaccts.end(), "seeds: " + account.to_string() + " is not a system account");
+
+  sysaccts.erase(aitr);
+
+  adjust_circulating(int64_t(balance_for(account)), 0);
+}
+
+bool token::is_system_account(const name& account) {
+  return sysaccts.find(account.value) != sysaccts.end();
+}
+
+void token::adjust_circulating(int64_t circulating_delta, int64_t total_delta) {
+  if ((circulating_delta == 0 && total_delta == 0) || !circulating.exists()) {
+    return;
+  }
+
+  circulating_supply_table c = circulating.get();
+  c.total += total_delta;
+  c.circulating += circulating_delta;
+  circulating.set(c, get_self());
 }
 
 
@@ -441,5 +495,5 @@ void token::minthrvst (const name& to, const asset& quantity, const string& memo
 
 } /// namespace eosio
 
-EOSIO_DISPATCH( eosio::token, (create)(issue)(transfer)(open)(close)(retire)(burn)(resetweekly)(resetwhelper)(updatecirc)(minthrvst) )
+EOSIO_DISPATCH( eosio::token, (create)(issue)(transfer)(open)(close)(retire)(burn)(resetweekly)(updatecirc)(addsysacct)(rmsysacct)(minthrvst) )
   
\ No newline at end of file
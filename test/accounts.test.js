@@ -120,6 +120,15 @@ describe('General accounts', async assert => {
 
   //console.log("user one: "+JSON.stringify(userOne, null, 2))
 
+  const coreOne = await eos.getTableRows({
+    code: accounts,
+    scope: accounts,
+    table: 'usercore',
+    lower_bound: firstuser,
+    upper_bound: firstuser,
+    json: true,
+  })
+
   var canChangeType = false
   try {
     await contract.update(firstuser, "organisation", nickname, image, story, roles, skills, interests,{ authorization: `${firstuser}@active` })
@@ -153,6 +162,13 @@ describe('General accounts', async assert => {
     expected: false
   })
   
+  assert({
+    given: 'user added',
+    should: 'have core row with status and type',
+    actual: coreOne.rows.map(({ account, status, type }) => ({ account, status, type })),
+    expected: [{ account: firstuser, status: 'visitor', type: 'individual' }]
+  })
+
   delete userOne.rows[0].timestamp
 
   assert({
@@ -1212,6 +1228,48 @@ describe('reputation & cbs ranking', async assert => {
     expected: 2
   })
 
+  const repBuckets = await getTableRows({
+    code: accounts,
+    scope: 'rep',
+    table: 'scorebuckets',
+    json: true
+  })
+
+  const cbsBuckets = await getTableRows({
+    code: accounts,
+    scope: 'cbs',
+    table: 'scorebuckets',
+    json: true
+  })
+
+  assert({
+    given: 'rep 98 and 4',
+    should: 'have one account in each rep bucket',
+    actual: repBuckets.rows,
+    expected: [ { bucket: 4, count: 1 }, { bucket: 68, count: 1 } ]
+  })
+
+  const repCounts = await getTableRows({
+    code: accounts,
+    scope: 'rep',
+    table: 'scorecounts',
+    json: true
+  })
+
+  assert({
+    given: 'rep 98 in a shared bucket',
+    should: 'count the exact score, scores below 64 have their own bucket',
+    actual: repCounts.rows,
+    expected: [ { score: 98, count: 1 } ]
+  })
+
+  assert({
+    given: '4 users with cbs',
+    should: 'have one account in each cbs bucket',
+    actual: cbsBuckets.rows.map(({ count }) => count),
+    expected: [1, 1, 1, 1]
+  })
+
 })
 
 describe('Referral cbp reward individual', async assert => {
@@ -46,6 +46,30 @@ const createProp = async (contract, creator, type, title, summary, description,
   ], { authorization: `${creator}@active` })
 }
 
+// field order of ProposalArgs::field, present has one bit per field that is set
+const proposalArgFields = [
+  'proposal_id', 'propcycle', 'creator', 'type', 'fund', 'recipient', 'setting_name', 'reward_owner', 'action',
+  'title', 'summary', 'description', 'image', 'url', 'pay_percentages', 'quantity', 'planted', 'reward',
+  'max_amount_per_invite', 'test_cycles', 'eval_cycles', 'campaign_id', 'lock_id', 'new_value'
+]
+
+const proposalArgs = (fields) => {
+  const args = {
+    proposal_id: 0, propcycle: 0,
+    creator: '', type: '', fund: '', recipient: '', setting_name: '', reward_owner: '', action: '',
+    title: '', summary: '', description: '', image: '', url: '', pay_percentages: null,
+    quantity: '0.0000 SEEDS', planted: '0.0000 SEEDS', reward: '0.0000 SEEDS', max_amount_per_invite: '0.0000 SEEDS',
+    test_cycles: 0, eval_cycles: 0, campaign_id: 0, lock_id: 0,
+    new_value: ['uint64', 0],
+    present: 0
+  }
+  for (const [key, value] of Object.entries(fields)) {
+    args[key] = value
+    args.present |= 1 << proposalArgFields.indexOf(key)
+  }
+  return args
+}
+
 const checkProp = async (expectedProp, assert, given, should) => {
 
   const propId = expectedProp.proposal_id
@@ -317,19 +341,19 @@ describe('Referendums Settings', async assert => {
   await createReferendum(contracts.dao, firstuser, testSetting, ['uint64', 100], 'title', 'summary', 'description', 'image', 'url')
   await createReferendum(contracts.dao, seconduser, testSettingFloat, ['float64', testSettingFloatNewValue], 'title 2', 'summary 2', 'description 2', 'image 2', 'url 2')
 
-  console.log('update referendum')
-  await contracts.dao.update([
-    { key: 'proposal_id', value: ['uint64', 1] },
-    { key: 'setting_name', value: ['name', testSetting] },
-    { key: 'title', value: ['string', 'title updated'] },
-    { key: 'summary', value: ['string', 'summary updated'] },
-    { key: 'description', value: ['string', 'description updated'] },
-    { key: 'image', value: ['string', 'image updated'] },
-    { key: 'url', value: ['string', 'url updated'] },
-    { key: 'new_value', value: ['uint64', testSettingNewValue] },
-    { key: 'test_cycles', value: ['uint64', 1] },
-    { key: 'eval_cycles', value: ['uint64', 4] }
-  ], { authorization: `${firstuser}@active` })
+  console.log('update referendum with packed arguments')
+  await contracts.dao.updateprop(proposalArgs({
+    proposal_id: 1,
+    setting_name: testSetting,
+    title: 'title updated',
+    summary: 'summary updated',
+    description: 'description updated',
+    image: 'image updated',
+    url: 'url updated',
+    new_value: ['uint64', testSettingNewValue],
+    test_cycles: 1,
+    eval_cycles: 4
+  }), { authorization: `${firstuser}@active` })
 
   console.log('delete referendum')
   await contracts.dao.cancel([{ key: 'proposal_id', value: ['uint64', 2] }], { authorization: `${firstuser}@active` })
@@ -409,8 +433,60 @@ describe('Referendums Settings', async assert => {
 
   console.log('running onperiod')
   await contracts.dao.onperiod({ authorization: `${dao}@active` })
+
+  let skipWrongProposal = true
+  try {
+    await contracts.dao.skipeval(999, { authorization: `${dao}@active` })
+  } catch (err) {
+    skipWrongProposal = false
+    console.log('skip a proposal that is not next (expected error)')
+  }
+
   await sleep(2000)
 
+  let skipWhenDone = true
+  try {
+    await contracts.dao.skipeval(1, { authorization: `${dao}@active` })
+  } catch (err) {
+    skipWhenDone = false
+    console.log('skip when evaluation is done (expected error)')
+  }
+
+  const evalCursor = await getTableRows({
+    code: dao,
+    scope: dao,
+    table: 'evalcursor',
+    json: true
+  })
+
+  assert({
+    given: 'onperiod ran',
+    should: 'have evaluated every queued proposal',
+    actual: evalCursor.rows.map(row => row.stage),
+    expected: ['']
+  })
+
+  const evalSkips = await getTableRows({
+    code: dao,
+    scope: dao,
+    table: 'evalskips',
+    json: true
+  })
+
+  assert({
+    given: 'proposals still being evaluated',
+    should: 'not skip a proposal other than the next',
+    actual: [skipWrongProposal, skipWhenDone],
+    expected: [false, false]
+  })
+
+  assert({
+    given: 'every evaluation finished before the next onperiod',
+    should: 'not record abandoned evaluations',
+    actual: evalSkips.rows,
+    expected: []
+  })
+
   await checkReferendums(
     [
       {
@@ -1060,6 +1136,14 @@ describe('Voice Decay', async assert => {
     await contracts.dao.decayvoices({ authorization: `${dao}@active` })
     await sleep(2000)
 
+    const cycle = await getTableRows({
+      code: dao,
+      scope: dao,
+      table: 'cycle',
+      json: true
+    })
+    const epoch = cycle.rows[0].decay_epoch || 0
+
     const actualVoices = []
   
     for (const user of users) {
@@ -1070,7 +1154,7 @@ describe('Voice Decay', async assert => {
     assert({
       given: 'voice decay ran',
       should: 'decay voices properly',
-      actual: actualVoices.map(av => av.map(a => a.balance)),
+      actual: actualVoices.map(av => av.map(a => Math.floor(a.balance * 0.85 ** (epoch - (a.decay_epoch || 0))))),
       expected: expectedVoices.map(v => Array.from(Array(scopes.length).keys()).map(a => v)  )
     })
 
@@ -1113,6 +1197,7 @@ describe('Voice Delegation', async assert => {
     const actualVoices = []
   
     for (const user of users) {
+      await contracts.dao.settlevoice(user, referendumsScope, { authorization: `${dao}@active` })
       const voices = await getVoice(user)
       actualVoices.push(voices)
     }
@@ -1152,9 +1237,51 @@ describe('Voice Delegation', async assert => {
   await contracts.dao.delegate(thirduser, firstuser, referendumsScope, { authorization: `${thirduser}@active` })
   await contracts.dao.delegate(fourthuser, thirduser, referendumsScope, { authorization: `${fourthuser}@active` })
 
+  const delegatedBefore = await getTableRows({
+    code: dao,
+    scope: referendumsScope,
+    table: 'delegvoice',
+    json: true
+  })
+
   console.log('voting')
-  await contracts.dao.favour(firstuser, 1, 5, { authorization: `${firstuser}@active` })
-  await sleep(5000)
+  const voteResult = await contracts.dao.favour(firstuser, 1, 5, { authorization: `${firstuser}@active` })
+  console.log('vote cpu:', voteResult.processed.receipt.cpu_usage_us)
+
+  const delegatedVote = await getTableRows({
+    code: dao,
+    scope: 1,
+    table: 'votes',
+    json: true
+  })
+
+  const votersAfterVote = await getTableRows({
+    code: dao,
+    scope: 'votes',
+    table: 'sizes',
+    json: true
+  })
+
+  assert({
+    given: 'delegations joined',
+    should: 'hold the delegated voice and the represented delegators per delegatee',
+    actual: delegatedBefore.rows.map(r => [r.delegatee, r.balance, r.votes, r.delegators]),
+    expected: [[firstuser, 180, 0, 3], [thirduser, 80, 0, 1]]
+  })
+
+  assert({
+    given: 'delegatee voted',
+    should: 'count the delegatee and every delegator it represents as voters',
+    actual: votersAfterVote.rows.map(r => r.size),
+    expected: [4]
+  })
+
+  assert({
+    given: 'delegatee voted',
+    should: 'cast the delegated voice in the same transaction',
+    actual: delegatedVote.rows.map(r => [r.account, r.amount, r.delegated]),
+    expected: [[firstuser, 5, 45]]
+  })
 
   await checkVoices([
     { scope: referendumsScope, account: firstuser, balance: 15 },
@@ -1163,9 +1290,54 @@ describe('Voice Delegation', async assert => {
     { scope: referendumsScope, account: fourthuser, balance: 60 }
   ])
 
+  const delegatedAfter = await getTableRows({
+    code: dao,
+    scope: referendumsScope,
+    table: 'delegvoice',
+    json: true
+  })
+
+  assert({
+    given: 'delegators settled',
+    should: 'have the used part taken from the delegated voice',
+    actual: delegatedAfter.rows.map(r => [r.delegatee, r.balance, r.votes]),
+    expected: [[firstuser, 135, 1], [thirduser, 60, 1]]
+  })
+
   console.log('Undelegate voice')
   await contracts.dao.undelegate(seconduser, referendumsScope, { authorization: `${seconduser}@active` })
 
+  const detachedVotes = await getTableRows({
+    code: dao,
+    scope: 1,
+    table: 'votes',
+    json: true
+  })
+
+  assert({
+    given: 'delegator left after the delegatee voted',
+    should: 'keep its part of the vote as its own',
+    actual: detachedVotes.rows.map(r => [r.account, r.amount, r.favour, r.delegated]),
+    expected: [[firstuser, 5, 1, 35], [seconduser, 10, 1, undefined]]
+  })
+
+  console.log('delegate again after voting')
+  await contracts.dao.delegate(seconduser, firstuser, referendumsScope, { authorization: `${seconduser}@active` })
+
+  const exclusions = await getTableRows({
+    code: dao,
+    scope: 1,
+    table: 'delegexcls',
+    json: true
+  })
+
+  assert({
+    given: 'delegator has a vote on an active proposal',
+    should: 'be able to delegate and be left out of its delegatee\'s votes on that proposal',
+    actual: exclusions.rows.map(r => r.account),
+    expected: [seconduser]
+  })
+
   console.log('change opinion, revert vote')
 
   const proposalsTable = await getTableRows({
@@ -2877,8 +3049,8 @@ describe('Streaming Funding', async assert => {
     given: 'votes cleaned',
     should: 'only leave the votes that are not old enough',
     expected: [
-      { vote_id: 7, account: thirduser, dho: org1, points: 500 },
-      { vote_id: 8, account: thirduser, dho: org2, points: 1500 }
+      { vote_id: 1, account: thirduser, dho: org1, points: 500 },
+      { vote_id: 2, account: thirduser, dho: org2, points: 1500 }
     ]
   })
 
@@ -2935,10 +3107,10 @@ describe('Streaming Funding', async assert => {
     given: 'dho removed',
     should: 'have the votes removed as well',
     expected: [
-      { vote_id: 8, account: thirduser, dho: org2, points: 1500 },
-      { vote_id: 11, account: fourthuser, dho: org2, points: 600 },
-      { vote_id: 12, account: fourthuser, dho: org3, points: 600 },
-      { vote_id: 13, account: fourthuser, dho: org4, points: 150 }
+      { vote_id: 2, account: thirduser, dho: org2, points: 1500 },
+      { vote_id: 5, account: fourthuser, dho: org2, points: 600 },
+      { vote_id: 6, account: fourthuser, dho: org3, points: 600 },
+      { vote_id: 7, account: fourthuser, dho: org4, points: 150 }
     ]
   })
 
@@ -2997,19 +3169,19 @@ describe('Streaming Funding', async assert => {
     should: 'have the correct entries in the dho votes table',
     expected: [
       {
-        vote_id: 9,
+        vote_id: 3,
         account: fourthuser,
         dho: org5,
         points: 3000
       },
       {
-        vote_id: 10,
+        vote_id: 4,
         account: thirduser,
         dho: org5,
         points: 2000
       },
       {
-        vote_id: 11,
+        vote_id: 5,
         account: seconduser,
         dho: org5,
         points: 1000
@@ -3049,19 +3221,19 @@ describe('Streaming Funding', async assert => {
     should: 'have the correct entries in the dhos vote table',
     expected: [
       {
-        vote_id: 10,
+        vote_id: 4,
         account: thirduser,
         dho: 'org5',
         points: 2000
       },
       {
-        vote_id: 11,
+        vote_id: 5,
         account: seconduser,
         dho: 'org5',
         points: 1000
       },
       {
-        vote_id: 12,
+        vote_id: 6,
         account: fourthuser,
         dho: 'org2',
         points: 3000
@@ -3155,3 +3327,73 @@ describe('Cycle stats use moon phases', async assert => {
   })
 
 })
+
+describe('Proposal evaluation cpu', async assert => {
+
+  if (!isLocal()) {
+    console.log("only run unit tests on local - don't reset accounts on mainnet or testnet")
+    return
+  }
+
+  await resetContracts()
+
+  const users = [firstuser, seconduser]
+  const contracts = await initContracts({ dao, token, settings, accounts })
+  await Promise.all(users.map(user => contracts.dao.testsetvoice(user, 99, { authorization: `${dao}@active` })))
+
+  console.log('init propcycle')
+  await contracts.dao.initcycle(1, { authorization: `${dao}@active` })
+
+  const proposalIds = [1, 2, 3]
+
+  console.log('create proposals')
+  for (const id of proposalIds) {
+    await createProp(contracts.dao, firstuser, 'p.alliance', `title ${id}`, 'summary', 'description', 'image', 'url', alliancesbank, '10000.0000 SEEDS', [
+      { key: 'recipient', value: ['name', seconduser] }
+    ])
+    await contracts.token.transfer(firstuser, dao, '555.0000 SEEDS', `${id}`, { authorization: `${firstuser}@active` })
+  }
+
+  // cpu_usage_us of each evaluate receipt, run this against a build of the previous
+  // ProposalsFactory to compare the devirtualised hooks with the vtable ones
+  const evaluateCpu = async () => {
+    const cpu = []
+    for (const id of proposalIds) {
+      const result = await contracts.dao.evaluate(id, 1, { authorization: `${dao}@active` })
+      cpu.push(result.processed.receipt.cpu_usage_us)
+    }
+    return cpu
+  }
+
+  console.log('evaluate staged proposals')
+  const stagedCpu = await evaluateCpu()
+
+  console.log('evaluate active proposals')
+  const activeCpu = await evaluateCpu()
+
+  const average = (values) => values.reduce((sum, v) => sum + v, 0) / values.length
+  console.log(`evaluate cpu_usage_us staged: ${stagedCpu.join(', ')} (average ${average(stagedCpu)})`)
+  console.log(`evaluate cpu_usage_us active: ${activeCpu.join(', ')} (average ${average(activeCpu)})`)
+
+  const props = await getTableRows({
+    code: dao,
+    scope: dao,
+    table: 'proposals',
+    json: true
+  })
+
+  assert({
+    given: 'alliance proposals evaluated through the concrete type',
+    should: 'report cpu usage for every evaluation',
+    actual: [...stagedCpu, ...activeCpu].every(cpu => cpu > 0),
+    expected: true
+  })
+
+  assert({
+    given: 'alliance proposals without votes evaluated twice',
+    should: 'activate them and then reject them',
+    actual: props.rows.map(r => [r.status, r.stage]),
+    expected: proposalIds.map(() => ['rejected', 'done'])
+  })
+
+})
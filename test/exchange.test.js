@@ -93,6 +93,31 @@ describe('Exchange', async assert => {
   } catch (err) {
   }
 
+  const digestsBeforePrune = await getTableRows({
+    code: exchange,
+    scope: exchange,
+    table: 'paydigests',
+    json: true,
+  })
+
+  console.log(`prune payment history`)
+  await contracts.exchange.prunepays(Number.MAX_SAFE_INTEGER, 100, { authorization: `${exchange}@active` })
+
+  const payHistoryAfterPrune = await eos.getTableRows({
+    code: exchange,
+    scope: exchange,
+    table: 'payhistory',
+    json: true,
+  })
+
+  let allowDuplicateAfterPrune = false
+  try {
+    await contracts.exchange.newpayment(firstuser, "BTC", "0x3affgf", 1, { authorization: `${exchange}@active` })
+    allowDuplicateAfterPrune = true
+  } catch (err) {
+    console.log("expected error: "+err)
+  }
+
   console.log(`reset daily stats`)
   await contracts.exchange.onperiod({ authorization: `${exchange}@active` })  
 
@@ -161,6 +186,27 @@ describe('Exchange', async assert => {
     expected: false
   })
 
+  assert({
+    given: `payment history pruned`,
+    should: `have no payment rows left`,
+    actual: payHistoryAfterPrune.rows.length,
+    expected: 0
+  })
+
+  assert({
+    given: `payments not yet pruned`,
+    should: `have no payment digests`,
+    actual: digestsBeforePrune.rows.length,
+    expected: 0
+  })
+
+  assert({
+    given: `newpayment called again after its history row was pruned`,
+    should: `fail`,
+    actual: allowDuplicateAfterPrune,
+    expected: false
+  })
+
   assert({
     given: `exceeded balance`,
     should: `have error with expected error message: `+expectedErrorMessage,
@@ -691,6 +737,87 @@ describe('Token Sale 50 Rounds', async assert => {
 
 
 
+describe('Token Sale Round Cursor', async assert => {
+
+  const contracts = await initContracts({ accounts, token, exchange })
+
+  console.log(`reset exchange`)
+  await contracts.exchange.reset({ authorization: `${exchange}@active` })
+
+  console.log(`reset accounts`)
+  await contracts.accounts.reset({ authorization: `${accounts}@active` })
+
+  console.log(`add user`)
+  await contracts.accounts.adduser(firstuser, 'First user', "individual", { authorization: `${accounts}@active` })
+
+  await contracts.exchange.updatelimit("100000.0000 SEEDS", "100000.0000 SEEDS", "100000.0000 SEEDS", { authorization: `${exchange}@active` })
+  await contracts.exchange.updatetlos("3.0000 SEEDS", { authorization: `${exchange}@active` })
+
+  await contracts.exchange.initrounds( 10 * 10000, "90.9091 SEEDS", { authorization: `${exchange}@active` })
+
+  // the purchase walk as it was before the round cursor, always from the first round
+  const seedsFromFirstRound = async (usdAmount) => {
+    const rounds = await getTableRows({ code: exchange, scope: exchange, table: 'rounds', json: true, limit: 100 })
+    const sold = await getTableRows({ code: exchange, scope: exchange, table: 'sold', json: true })
+    const totalSold = sold.rows.length > 0 ? sold.rows[0].total_sold : 0
+
+    let usdRemaining = usdAmount
+    let seedsAmount = 0
+    let roundStartVolume = 0
+
+    for (const round of rounds.rows) {
+      const seedsPerUsd = Math.round(parseFloat(round.seeds_per_usd) * 10000)
+      if (totalSold < round.max_sold) {
+        const availableInRound = round.max_sold - Math.max(roundStartVolume, totalSold)
+        const usdAvailable = availableInRound * (10000.0 / seedsPerUsd)
+        if (usdAvailable >= usdRemaining) {
+          seedsAmount += (usdRemaining * seedsPerUsd) / 10000
+          break
+        }
+        usdRemaining -= usdAvailable
+        seedsAmount += availableInRound
+      }
+      roundStartVolume = round.max_sold
+    }
+
+    return Math.trunc(seedsAmount) / 10000
+  }
+
+  const buy = async (paymentId, usdAmount) => {
+    const expected = await seedsFromFirstRound(usdAmount)
+    const before = await getBalanceFloat(firstuser)
+    await contracts.exchange.newpayment(firstuser, "BTC", paymentId, usdAmount, { authorization: `${exchange}@active` })
+    const after = await getBalanceFloat(firstuser)
+    return { actual: (after - before).toFixed(4), expected: expected.toFixed(4) }
+  }
+
+  console.log('buy into the second round')
+  const firstPurchase = await buy("cursor1", 1500)
+
+  console.log('buy across three rounds from the cursor')
+  const spanningPurchase = await buy("cursor2", 3000)
+
+  assert({
+    given: 'a purchase that spans rounds',
+    should: 'receive the same amount as the walk from the first round',
+    actual: [firstPurchase.actual, spanningPurchase.actual],
+    expected: [firstPurchase.expected, spanningPurchase.expected]
+  })
+
+  console.log('replace the rounds mid sale')
+  await contracts.exchange.initrounds( 10 * 10000, "80.0000 SEEDS", { authorization: `${exchange}@active` })
+
+  const afterInitPurchase = await buy("cursor3", 2000)
+
+  assert({
+    given: 'a purchase after initrounds',
+    should: 'receive the same amount as the walk from the first round',
+    actual: afterInitPurchase.actual,
+    expected: afterInitPurchase.expected
+  })
+
+})
+
 describe('Increase Price', async assert => {
 
   const contracts = await initContracts({ accounts, token, exchange })
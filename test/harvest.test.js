@@ -947,6 +947,66 @@ describe('contribution score', async assert => {
   await checkCSScores(individualHarvestScope, userScores, [25, 0, 50, 75])
   await checkCSScores(organizationScope, orgScores, [0, 50])
 
+  console.log('run the fused contribution score pipeline')
+  await contracts.settings.configure('cs.budget', 3, { authorization: `${settings}@active` })
+  await contracts.harvest.rankscores({ authorization: `${harvest}@active` })
+  await sleep(15000)
+
+  const scoreCursor = await eos.getTableRows({
+    code: harvest,
+    scope: harvest,
+    table: 'scorecursor',
+    json: true
+  })
+
+  assert({
+    given: 'rankscores finished',
+    should: 'leave the cursor in the done step',
+    actual: scoreCursor.rows[0].step,
+    expected: 'done'
+  })
+
+  const csDirty = await eos.getTableRows({
+    code: harvest,
+    scope: harvest,
+    table: 'csdirty',
+    json: true
+  })
+
+  assert({
+    given: 'rankscores finished',
+    should: 'have consumed the dirty accounts',
+    actual: csDirty.rows,
+    expected: []
+  })
+
+  await checkCSScores(individualHarvestScope, userScores, [25, 0, 50, 75])
+  await checkCSScores(organizationScope, orgScores, [0, 50])
+
+  console.log('full rebuild clears the dirty set and releases rankscores')
+  await contracts.harvest.calccss({ authorization: `${harvest}@active` })
+  await sleep(2000)
+
+  const cursorAfterRebuild = await eos.getTableRows({
+    code: harvest,
+    scope: harvest,
+    table: 'scorecursor',
+    json: true
+  })
+
+  assert({
+    given: 'calccss finished',
+    should: 'leave the cursor in the done step',
+    actual: cursorAfterRebuild.rows[0].step,
+    expected: 'done'
+  })
+
+  await contracts.harvest.rankscores({ authorization: `${harvest}@active` })
+  await sleep(15000)
+
+  await checkCSScores(individualHarvestScope, userScores, [25, 0, 50, 75])
+  await checkCSScores(organizationScope, orgScores, [0, 50])
+
 })
 
 describe("plant for other user", async assert => {
@@ -1082,6 +1142,14 @@ describe('Monthly QEV', async assert => {
     json: true,
   })
 
+  const qevSums = await getTableRows({
+    code: history,
+    scope: history,
+    table: 'qevsums',
+    limit: 1000,
+    json: true,
+  })
+
   delete totalQev.rows[0].circulating_supply
 
   assert({
@@ -1093,6 +1161,69 @@ describe('Monthly QEV', async assert => {
     ]
   })
 
+  assert({
+    given: 'total qevs set for 121 days',
+    should: 'keep a running total per day',
+    actual: [qevSums.rows.length, qevSums.rows[0].cumulative_volume, qevSums.rows[qevSums.rows.length - 1].cumulative_volume],
+    expected: [121, 1000000, 121000000]
+  })
+
+  const getQevSumState = async () => {
+    const state = await getTableRows({
+      code: history,
+      scope: history,
+      table: 'qevsumstate',
+      json: true,
+    })
+    return state.rows.length > 0 ? state.rows[0].ready : false
+  }
+
+  const readyAfterReset = await getQevSumState()
+
+  console.log('rebuild qevsums in chunks')
+  await contracts.history.migqevsums(0, 50, { authorization: `${history}@active` })
+  const readyDuringMigration = await getQevSumState()
+
+  await contracts.harvest.calcmqevs({ authorization: `${harvest}@active` })
+  const totalQevDuringMigration = await getTableRows({
+    code: harvest,
+    scope: harvest,
+    table: 'monthlyqevs',
+    json: true,
+  })
+
+  await sleep(4000)
+  const readyAfterMigration = await getQevSumState()
+
+  const qevSumsAfterMigration = await getTableRows({
+    code: history,
+    scope: history,
+    table: 'qevsums',
+    limit: 1000,
+    json: true,
+  })
+
+  assert({
+    given: 'qevsums rebuilt by migqevsums',
+    should: 'only be marked ready when the last chunk is done',
+    actual: [readyAfterReset, readyDuringMigration, readyAfterMigration],
+    expected: [true, false, true]
+  })
+
+  assert({
+    given: 'calcmqevs during the migration',
+    should: 'sum the qevs rows instead of the partial running totals',
+    actual: totalQevDuringMigration.rows.map(r => r.qualifying_volume),
+    expected: [30000000]
+  })
+
+  assert({
+    given: 'qevsums rebuilt by migqevsums',
+    should: 'keep the same running totals',
+    actual: qevSumsAfterMigration.rows,
+    expected: qevSums.rows
+  })
+
 })
 
 async function testHarvest (assert, dSeeds) {
@@ -1383,6 +1514,34 @@ async function testHarvest (assert, dSeeds) {
 
   await sleep(1000)
 
+  const rewardIndex = await getTableRows({
+    code: harvest,
+    scope: harvest,
+    table: 'rewardindex',
+    json: true
+  })
+  console.log('reward index', rewardIndex)
+
+  assert({
+    given: 'harvest ran',
+    should: 'have bumped the reward index instead of paying users',
+    actual: rewardIndex.rows.length,
+    expected: 1
+  })
+
+  assert({
+    given: 'harvest ran with ranked users and orgs',
+    should: 'not carry anything over',
+    actual: [rewardIndex.rows[0].users_pending, rewardIndex.rows[0].orgs_pending],
+    expected: [0, 0]
+  })
+
+  console.log('claim rewards')
+  for (const user of users) {
+    await contracts.harvest.claimreward(user, { authorization: `${user}@active` })
+  }
+  await contracts.harvest.sweeprewards('org', 0, 100, { authorization: `${harvest}@active` })
+
   const userBalancesAfter = await Promise.all(users.map(user => getTestBalance(user)))
   const orgBalancesAfter = await Promise.all(orgs.map(org => getTestBalance(org)))
   const rgnBalancesAfter = await Promise.all(rgns.map(rgn => getHarvestBalance(rgn)))
@@ -1684,9 +1843,12 @@ describe('regions contribution score', async assert => {
 
   assert({
     given: 'cs for regions, the table regioncstemp',
-    should: 'not have entries',
+    should: 'keep the current region sums',
     actual: cspointsrgnsTemp.rows,
-    expected: []
+    expected: [
+      { region: 'rgn2.rgn', points: 41 },
+      { region: 'rgn3.rgn', points: 82 }
+    ]
   })
 
 })
@@ -90,6 +90,27 @@ describe('make a transaction entry', async assert => {
     table: 'totals',
     json: true
   })
+
+  const trxPointSums = await getTableRows({
+    code: history,
+    scope: history,
+    table: 'trxptsums',
+    json: true
+  })
+
+  const queue = await getTableRows({
+    code: history,
+    scope: history,
+    table: 'trxqueue',
+    json: true
+  })
+
+  const drainStats = await getTableRows({
+    code: history,
+    scope: history,
+    table: 'drainstats',
+    json: true
+  })
   
   console.log("transactions result "+JSON.stringify(rows, null, 2))
 
@@ -190,6 +211,43 @@ describe('make a transaction entry', async assert => {
     expected: 1
   })
 
+  assert({
+    given: 'a transaction made by ' + firstuser,
+    should: 'add its points to the rolling sum',
+    actual: trxPointSums.rows.filter(r => r.account === firstuser).map(r => r.points),
+    expected: [10]
+  })
+
+  assert({
+    given: 'the queued transfer drained',
+    should: 'leave the queue empty and record the batch',
+    actual: [queue.rows.length, drainStats.rows[0].last_batch_size, drainStats.rows[0].processed, drainStats.rows[0].last_left_pending],
+    expected: [0, 1, 1, false]
+  })
+
+  assert({
+    given: 'the queue drained completely',
+    should: 'have no drain pending, nothing retried one by one and nothing moved aside',
+    actual: [drainStats.rows[0].scheduled_at, drainStats.rows[0].isolate_until, drainStats.rows[0].head_stalls, drainStats.rows[0].moved_aside],
+    expected: [0, 0, 0, 0]
+  })
+
+  await contracts.history.requeuetrxs(10, { authorization: `${history}@active` })
+
+  const failedQueue = await getTableRows({
+    code: history,
+    scope: history,
+    table: 'trxqfailed',
+    json: true
+  })
+
+  assert({
+    given: 'requeuetrxs called',
+    should: 'leave no entries aside',
+    actual: failedQueue.rows.length,
+    expected: 0
+  })
+
 })
 
 describe("make a history entry", async (assert) => {
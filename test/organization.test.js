@@ -495,6 +495,22 @@ describe('app', async assert => {
     })
     console.log(dausScoresTable1)
 
+    const appTrailsTable = await getTableRows({
+        code: organization,
+        scope: organization,
+        table: 'apptrails',
+        json: true
+    })
+
+    assert({
+        given: 'trailing app use calculated',
+        should: 'keep a rolling sum per app',
+        actual: appTrailsTable.rows
+            .filter(row => row.app_name == 'app2' || row.app_name == 'app4')
+            .map(row => [row.app_name, row.trailing_points, row.trailing_uses]),
+        expected: [['app2', 22, 2], ['app4', 20, 1]]
+    })
+
     assert({
         given: 'apps used',
         should: 'have the correct app points',
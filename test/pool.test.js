@@ -32,7 +32,7 @@ describe('Pool transfer and payout', async assert => {
     assert({
       given,
       should,
-      actual: balanceTable.rows,
+      actual: balanceTable.rows.map(({ account, balance }) => ({ account, balance })),
       expected
     })
     assert({
@@ -45,6 +45,17 @@ describe('Pool transfer and payout', async assert => {
     })
   }
 
+  // the sweeps add the rounding dust of the settled balances back to the total
+  const getPoolTotal = async () => {
+    const sizesTable = await getTableRows({
+      code: pool,
+      scope: pool,
+      table: 'sizes',
+      json: true
+    })
+    return `${(sizesTable.rows.filter(r => r.id === 'total.sz')[0].size / 10000).toFixed(4)} SEEDS`
+  }
+
   const setupPool = async () => {
     console.log('reset pool')
     await contracts.pool.reset({ authorization: `${pool}@active` })
@@ -83,6 +94,7 @@ describe('Pool transfer and payout', async assert => {
 
   console.log('payout Seeds')
   await contracts.pool.payouts('10.0000 SEEDS', { authorization: `${pool}@active` })
+  await contracts.pool.sweep(0, 2, { authorization: `${pool}@active` })
   await sleep(2000)
 
   await checkBalances({
@@ -97,6 +109,7 @@ describe('Pool transfer and payout', async assert => {
 
   console.log('payout more Seeds')
   await contracts.pool.payouts('20.0000 SEEDS', { authorization: `${pool}@active` })
+  await contracts.pool.sweep(0, 2, { authorization: `${pool}@active` })
   await sleep(4000)
 
   await checkBalances({
@@ -110,7 +123,8 @@ describe('Pool transfer and payout', async assert => {
   })
 
   console.log('payout all the Seeds')
-  await contracts.pool.payouts('30.0003 SEEDS', { authorization: `${pool}@active` })
+  await contracts.pool.payouts(await getPoolTotal(), { authorization: `${pool}@active` })
+  await contracts.pool.sweep(0, 2, { authorization: `${pool}@active` })
   await sleep(2000)
 
   await checkBalances({
@@ -163,6 +177,7 @@ describe('Pool transfer and payout', async assert => {
 
   console.log('payout Seeds')
   await contracts.pool.payouts('10.0000 SEEDS', { authorization: `${pool}@active` })
+  await contracts.pool.sweep(0, 2, { authorization: `${pool}@active` })
   await sleep(2000)
 
   await checkBalances({
@@ -191,6 +206,7 @@ describe('Pool transfer and payout', async assert => {
 
   console.log('payout more Seeds')
   await contracts.pool.payouts('20.0000 SEEDS', { authorization: `${pool}@active` })
+  await contracts.pool.sweep(0, 2, { authorization: `${pool}@active` })
   await sleep(4000)
 
   await checkBalances({
@@ -204,7 +220,8 @@ describe('Pool transfer and payout', async assert => {
   })
 
   console.log('payout all the Seeds')
-  await contracts.pool.payouts('30.0003 SEEDS', { authorization: `${pool}@active` })
+  await contracts.pool.payouts(await getPoolTotal(), { authorization: `${pool}@active` })
+  await contracts.pool.sweep(0, 2, { authorization: `${pool}@active` })
   await sleep(2000)
 
   await checkBalances({
@@ -1890,6 +1890,17 @@ describe('Voice decay', async assert => {
   await contracts.harvest.testupdatecs(thirduser, 0, { authorization: `${harvest}@active` })
   await sleep(2000)
 
+  const decayedBalances = async (rows) => {
+    const cycle = await eos.getTableRows({
+      code: proposals,
+      scope: proposals,
+      table: 'cycle',
+      json: true,
+    })
+    const epoch = cycle.rows[0].decay_epoch || 0
+    return rows.map(r => Math.floor(r.balance * 0.85 ** (epoch - (r.decay_epoch || 0))))
+  }
+
   const testVoiceDecay = async (expectedValues, n) => {
     console.log('voice decay')
     await contracts.proposals.decayvoices({ authorization: `${proposals}@active` })
@@ -1919,19 +1930,19 @@ describe('Voice decay', async assert => {
     assert({
       given: 'ran voice decay for the ' + n + ' time',
       should: 'decay voices if required',
-      actual: voice.rows.map(r => r.balance),
+      actual: await decayedBalances(voice.rows),
       expected: expectedValues
     })
     assert({
       given: 'ran voice decay for the ' + n + ' time',
       should: 'decay voices for alliance if required',
-      actual: voiceAlliance.rows.map(r => r.balance),
+      actual: await decayedBalances(voiceAlliance.rows),
       expected: expectedValues
     })
     assert({
       given: 'ran voice decay for the ' + n + ' time',
       should: 'decay voices for hypha if required',
-      actual: voiceHypha.rows.map(r => r.balance),
+      actual: await decayedBalances(voiceHypha.rows),
       expected: expectedValues
     })
   }
@@ -1947,9 +1958,47 @@ describe('Voice decay', async assert => {
   await sleep(1000)
   await testVoiceDecay([34, 75, 0], 4)
   await sleep(4000)
-  await testVoiceDecay([28, 63, 0], 5)
+  await testVoiceDecay([28, 64, 0], 5)
   await sleep(2000)
 
+  const decayRates = await eos.getTableRows({
+    code: proposals,
+    scope: proposals,
+    table: 'decayrates',
+    json: true,
+  })
+  assert({
+    given: 'decay epochs started',
+    should: 'record the rate of each epoch',
+    actual: decayRates.rows.map(r => Number(r.multiplier)),
+    expected: decayRates.rows.map(() => 0.85)
+  })
+  assert({
+    given: 'decay epochs started',
+    should: 'keep the cumulative log multiplier up to each epoch',
+    actual: decayRates.rows.map(r => Number(r.cumulative).toFixed(6)),
+    expected: decayRates.rows.map(r => (r.epoch * Math.log(0.85)).toFixed(6))
+  })
+
+  console.log('change the decay percentage before materializing')
+  await contracts.settings.configure('vdecayprntge', 50, { authorization: `${settings}@active` })
+
+  console.log('materialize decayed voices')
+  await contracts.proposals.decayvoice(0, 10, { authorization: `${proposals}@active` })
+  await contracts.settings.configure('vdecayprntge', 15, { authorization: `${settings}@active` })
+  const materialized = await eos.getTableRows({
+    code: proposals,
+    scope: proposals,
+    table: 'voice',
+    json: true,
+  })
+  assert({
+    given: 'decayvoice called after two decay epochs and a change of the decay percentage',
+    should: 'write the balances decayed at the recorded rates into the voice rows',
+    actual: materialized.rows.map(r => r.balance),
+    expected: [28, 64, 0]
+  })
+
   await contracts.proposals.onperiod({ authorization: `${proposals}@active` })
   await sleep(4000)
 
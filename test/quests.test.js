@@ -1302,3 +1302,71 @@ describe('Voted quests timeouts', async assert => {
 
 })
 
+
+describe('Edges saved before the 128 bit indexes', async assert => {
+
+  if (!isLocal()) {
+    console.log("only run unit tests on local - don't reset accounts on mainnet or testnet")
+    return
+  }
+
+  const contracts = await initContracts({ quests })
+
+  console.log('reset quests')
+  await contracts.quests.reset({ authorization: `${quests}@active` })
+
+  const root = (await getFixedNodes(quests, 'root'))[0]
+  const accountInfos = (await getFixedNodes(quests, 'accntinfos'))[0]
+
+  console.log('write an edge without the 128 bit index entries')
+  await contracts.quests.testoldedge(root.hash, accountInfos.hash, 'oldedge', { authorization: `${quests}@active` })
+
+  const getKeysReady = async () => {
+    const { rows } = await getTableRows({
+      code: quests,
+      scope: quests,
+      table: 'edgekeys',
+      json: true
+    })
+    return rows.length > 0 && rows[0].ready == 1
+  }
+
+  const keysReadyBefore = await getKeysReady()
+
+  let foundBefore = true
+  try {
+    await contracts.quests.testhasedge(root.hash, 'oldedge', { authorization: `${quests}@active` })
+  } catch (err) {
+    console.log('edge not found before migration', err)
+    foundBefore = false
+  }
+
+  console.log('migrate edges')
+  await contracts.quests.migedges(0, 2, { authorization: `${quests}@active` })
+  await sleep(5000)
+
+  const keysReadyAfter = await getKeysReady()
+
+  let foundAfter = true
+  try {
+    await contracts.quests.testhasedge(root.hash, 'oldedge', { authorization: `${quests}@active` })
+  } catch (err) {
+    console.log('edge not found after migration', err)
+    foundAfter = false
+  }
+
+  assert({
+    given: 'an edge saved before the 128 bit indexes',
+    should: 'keep the queries on the 64 bit indexes',
+    actual: [keysReadyBefore, foundBefore],
+    expected: [false, true]
+  })
+
+  assert({
+    given: 'migedges finished',
+    should: 'switch the queries to the 128 bit indexes and still find the edge',
+    actual: [keysReadyAfter, foundAfter],
+    expected: [true, true]
+  })
+
+})
@@ -213,6 +213,13 @@ describe('scheduler', async assert => {
         limit: 100
     })
 
+    const tickStats = await getTableRows({
+        code: scheduler,
+        scope: scheduler,
+        table: 'tickstats',
+        json: true
+    })
+
     console.log("after "+JSON.stringify(afterValues, null, 2))
 
     let delta1 = afterValues.rows[0].value - beforeValues.rows[0].value
@@ -227,7 +234,7 @@ describe('scheduler', async assert => {
     assert({
         given: '1 second delay was executed 30 seonds',
         should: 'be executed close to 30 times (was: '+delta1+')',
-        actual: delta1 >= 20 && delta1 <= 28, // NOTE: ACTUALLY 27 => 31 - 4, 4 is the other action
+        actual: delta1 >= 24 && delta1 <= 31, // both ops fit in one tick, so the other action no longer delays this one
         expected: true
     })
 
@@ -238,6 +245,13 @@ describe('scheduler', async assert => {
         expected: 4
     })
 
+    assert({
+        given: 'ready ops within the dispatch cap',
+        should: 'not leave any ready op for the next tick',
+        actual: [tickStats.rows.length, tickStats.rows[0].max_ops, tickStats.rows[0].left_ready],
+        expected: [1, 10, 0]
+    })
+
     assert({
         given: 'stopped',
         should: 'no more executions',
@@ -248,6 +262,106 @@ describe('scheduler', async assert => {
 })
 
 
+describe('scheduler, dependencies', async assert => {
+
+    if (!isLocal()) {
+        console.log("only run unit tests on local - don't reset on mainnet or testnet")
+        return
+    }
+
+    const contracts = await initContracts({ scheduler, settings })
+
+    console.log('scheduler reset')
+    await contracts.scheduler.reset({ authorization: `${scheduler}@active` })
+
+    console.log('settings reset')
+    await contracts.settings.reset({ authorization: `${settings}@active` })
+    await contracts.settings.configure('secndstoexec', 1, { authorization: `${settings}@active` })
+
+    const opTable = await getTableRows({
+        code: scheduler,
+        scope: scheduler,
+        table: 'operations',
+        limit: 200,
+        json: true
+    })
+
+    for (const op of opTable.rows) {
+        await contracts.scheduler.removeop(op.id, { authorization: `${scheduler}@active` })
+    }
+
+    console.log('add operations, two depends on one')
+    await contracts.scheduler.configop('one', 'test1', scheduler, 1, 0, { authorization: `${scheduler}@active` })
+    await contracts.scheduler.configop('two', 'test2', scheduler, 3600, 0, { authorization: `${scheduler}@active` })
+    await contracts.scheduler.setopdeps('two', ['one'], { authorization: `${scheduler}@active` })
+
+    await contracts.scheduler.test1({ authorization: `${scheduler}@active` })
+    await contracts.scheduler.test2({ authorization: `${scheduler}@active` })
+
+    const getValues = async () => {
+        const values = await getTableRows({
+            code: scheduler,
+            scope: scheduler,
+            table: 'test',
+            json: true,
+            lower_bound: 'unit.test.1',
+            upper_bound: 'unit.test.2',
+            limit: 100
+        })
+        return values.rows.map(r => r.value)
+    }
+
+    const before = await getValues()
+
+    await contracts.scheduler.start({ authorization: `${scheduler}@active` })
+    await sleep(5000)
+    await contracts.scheduler.stop({ authorization: `${scheduler}@active` })
+
+    const withoutCompletion = await getValues()
+
+    console.log('report one as done')
+    await contracts.scheduler.opdone('one', { authorization: `${scheduler}@active` })
+
+    await contracts.scheduler.start({ authorization: `${scheduler}@active` })
+    await sleep(5000)
+    await contracts.scheduler.stop({ authorization: `${scheduler}@active` })
+
+    const afterCompletion = await getValues()
+
+    assert({
+        given: 'the dependency did not report completion',
+        should: 'not run the dependent op',
+        actual: withoutCompletion[1] - before[1],
+        expected: 0
+    })
+
+    assert({
+        given: 'the dependency reported completion once',
+        should: 'run the dependent op once',
+        actual: afterCompletion[1] - withoutCompletion[1],
+        expected: 1
+    })
+
+    console.log('dependent op falls back to its period')
+    await contracts.scheduler.configop('two', 'test2', scheduler, 1, 0, { authorization: `${scheduler}@active` })
+    await contracts.scheduler.pauseop('one', 1, { authorization: `${scheduler}@active` })
+
+    await contracts.scheduler.start({ authorization: `${scheduler}@active` })
+    await sleep(5000)
+    await contracts.scheduler.stop({ authorization: `${scheduler}@active` })
+
+    const withPausedDep = await getValues()
+
+    assert({
+        given: 'the dependency is paused',
+        should: 'run the dependent op on its own period',
+        actual: withPausedDep[1] - afterCompletion[1] > 0,
+        expected: true
+    })
+
+})
+
+
 describe('scheduler, moon phases', async assert => {
 
     if (!isLocal()) {
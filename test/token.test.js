@@ -3,7 +3,7 @@ const { describe } = require('riteway')
 const { eos, names, getTableRows, getBalance, initContracts, isLocal } = require('../scripts/helper')
 const { assert } = require('chai')
 
-const { token, firstuser, seconduser, thirduser, history, accounts, harvest, settings } = names
+const { token, firstuser, seconduser, thirduser, history, accounts, harvest, settings, bank } = names
 
 const sleep = (ms) => new Promise(resolve => setTimeout(resolve, ms))
 
@@ -65,7 +65,9 @@ describe('token.transfer.history', async assert => {
   assert({
     given: 'transactions',
     should: 'have transaction stat entries',
-    actual: stats.rows.filter( (item) => item.account == firstuser || item.account == seconduser),
+    actual: stats.rows
+      .filter( (item) => item.account == firstuser || item.account == seconduser)
+      .map(({ epoch, ...rest }) => rest),
     expected: [
       {
         "account": "seedsuseraaa",
@@ -230,12 +232,46 @@ describe('token calculate circulating supply', async assert => {
   
   console.log("circulating: "+JSON.stringify(rows, null, 2))
 
+  console.log('transfer to system account')
+  await contracts.token.transfer(firstuser, bank, '10.0000 SEEDS', `cc2`, { authorization: `${firstuser}@active` })
+
+  const { rows: rowsAfter } = await getTableRows({
+    code: token,
+    scope: token,
+    table: 'circulating',
+    json: true
+  })
+
+  console.log('recalculate circulating')
+  await contracts.token.updatecirc({ authorization: `${token}@active` })
+
+  const { rows: rowsRecalculated } = await getTableRows({
+    code: token,
+    scope: token,
+    table: 'circulating',
+    json: true
+  })
+
   assert({
     given: 'update circulating',
     should: 'have token circulating number',
     actual: rows.length,
     expected: 1
   })
+
+  assert({
+    given: 'transfer to a system account',
+    should: 'decrease circulating supply',
+    actual: rowsAfter[0].circulating,
+    expected: rows[0].circulating - 100000
+  })
+
+  assert({
+    given: 'recalculating circulating supply',
+    should: 'match the tracked value',
+    actual: rowsRecalculated[0],
+    expected: rowsAfter[0]
+  })
 })
 
 describe('token.resetweekly', async assert => {
@@ -283,10 +319,24 @@ describe('token.resetweekly', async assert => {
 
   balancesBefore = balancesBefore.map(row => row.outgoing_transactions)
  
+  const getEpoch = async () => {
+    const epochs = await getTableRows({
+      code: token,
+      scope: token,
+      table: 'weekepoch',
+      json: true
+    })
+    return epochs.rows.length > 0 ? epochs.rows[0].epoch : 0
+  }
+
+  const epochBefore = await getEpoch()
+
   console.log('reset token')
   await contracts.token.resetweekly({ authorization: `${token}@active` })
 
-  await sleep(10 * 1000)
+  const epochAfter = await getEpoch()
+
+  await contracts.token.transfer(firstuser, seconduser, '10.0000 SEEDS', ``, { authorization: `${firstuser}@active` })
 
   let balancesAfter = await getTableRows({
     code: token,
@@ -296,9 +346,9 @@ describe('token.resetweekly', async assert => {
   })
 
   balancesAfter = balancesAfter.rows.filter(row => 
-    row.account == firstuser || row.account == seconduser || row.account == thirduser)
+    row.account == firstuser || row.account == seconduser)
 
-  balancesAfter = balancesAfter.map(row => row.outgoing_transactions)
+  balancesAfter = balancesAfter.map(row => [row.outgoing_transactions, row.incoming_transactions, row.epoch])
 
   await contracts.settings.reset({ authorization: `${settings}@active` })
 
@@ -311,9 +361,16 @@ describe('token.resetweekly', async assert => {
 
   assert({
     given: 'called resetweekly',
-    should: 'reset trxstat table',
+    should: 'start a new week',
+    actual: epochAfter,
+    expected: epochBefore + 1
+  })
+
+  assert({
+    given: 'transfer after resetweekly',
+    should: 'count only the new week',
     actual: balancesAfter,
-    expected: [0, 0, 0]
+    expected: [[1, 0, epochAfter], [0, 1, epochAfter]]
   })
 
 })